@@ -0,0 +1,22 @@
+﻿#pragma once
+
+#include <stdio.h>
+#include "../ServerNetLib/ILog.h"
+
+namespace NBench
+{
+	// 패킷마다 찍히는 INFO 로그를 걸러서 콘솔 출력이 측정값을 잡아먹지 않게 한다. 에러와 경고만 stderr 로 보낸다.
+	class BenchLog : public NServerNetLib::ILog
+	{
+	public:
+		BenchLog() {}
+		virtual ~BenchLog() {}
+
+	protected:
+		void Error(const char* pText) override { fprintf(stderr, "[ERROR] | %s\n", pText); }
+		void Warn(const char* pText) override { fprintf(stderr, "[WARN] | %s\n", pText); }
+		void Debug(const char* pText) override {}
+		void Trace(const char* pText) override {}
+		void Info(const char* pText) override {}
+	};
+}
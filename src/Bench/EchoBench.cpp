@@ -0,0 +1,413 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include "../ServerNetLib/Define.h"
+#include "../ServerNetLib/NetStats.h"
+#include "../LogicLib/Main.h"
+#include "../BotClient/ClientEngine.h"
+#include "../BotClient/LatencyRecorder.h"
+#include "BenchLog.h"
+
+/*
+DEV_ECHO_REQ 에코 벤치마크.
+같은 프로세스 안에 서버를 띄우고 루프백으로 접속해서 페이로드 크기, 접속 수, 파이프라이닝 깊이를 바꿔 가며 측정한다.
+결과는 케이스마다 JSON 한 줄씩 stdout 으로 출력하므로 그대로 저장해서 변경 전후를 비교하면 된다.
+
+사용법: EchoBench [--port=32460] [--duration=3] [--sizes=0,64,256,1022] [--conns=1,16,64] [--depths=1,8,32] [--flush=tick|select]
+  --flush 는 서버의 SendFlushMode. 서버 설정은 프로세스에 하나이므로 모드를 비교하려면 따로 두 번 돌린다.
+*/
+
+using PACKET_ID = NCommon::PACKET_ID;
+
+namespace
+{
+	// 요청 보디에는 DataSize(short)가 같이 들어가므로 에코 데이터는 최대 보디 크기보다 2 바이트 작다.
+	const int MAX_ECHO_PAYLOAD_SIZE = NServerNetLib::MAX_PACKET_BODY_SIZE - (int)sizeof(short);
+	const int ECHO_RES_OVERHEAD_SIZE = NServerNetLib::PACKET_HEADER_SIZE + (int)sizeof(short) * 2;
+	const short BENCH_SESSION_BUFFER_SIZE = 32000;
+	const int STALL_TIMEOUT_MILLISEC = 2000;
+
+	struct BenchOption
+	{
+		unsigned short Port = 32460;
+		int DurationSec = 3;
+		int WarmupMilliSec = 500;
+		std::vector<int> PayloadSizeList = { 0, 64, 256, MAX_ECHO_PAYLOAD_SIZE };
+		std::vector<int> ConnectionCountList = { 1, 16, 64 };
+		std::vector<int> PipelineDepthList = { 1, 8, 32 };
+		NServerNetLib::SEND_FLUSH_MODE SendFlushMode = NServerNetLib::SEND_FLUSH_MODE::TICK;
+	};
+
+	const char* GetSendFlushModeName(const NServerNetLib::SEND_FLUSH_MODE mode)
+	{
+		return mode == NServerNetLib::SEND_FLUSH_MODE::TICK ? "tick" : "select";
+	}
+
+	struct EchoCase
+	{
+		int PayloadSize = 0;
+		int ConnectionCount = 0;
+		int PipelineDepth = 0;
+	};
+
+	int64_t NowMicroSec()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	int64_t ClockNanoSec(const clockid_t clockId)
+	{
+		timespec ts;
+		clock_gettime(clockId, &ts);
+		return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+	}
+
+	int64_t ProcessCpuNanoSec()
+	{
+		rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return ((int64_t)usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000 + ((int64_t)usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000;
+	}
+
+	std::vector<int> ParseIntList(const char* pText)
+	{
+		std::vector<int> list;
+		while (*pText != '\0')
+		{
+			char* pEnd = nullptr;
+			list.push_back((int)strtol(pText, &pEnd, 10));
+			if (pEnd == pText) {
+				break;
+			}
+			pText = (*pEnd == ',') ? pEnd + 1 : pEnd;
+		}
+		return list;
+	}
+
+	bool ParseOption(int argc, char* argv[], BenchOption& option)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto pos = arg.find('=');
+			if (pos == std::string::npos) {
+				return false;
+			}
+
+			auto key = arg.substr(0, pos);
+			auto value = arg.c_str() + pos + 1;
+
+			if (key == "--port") option.Port = (unsigned short)atoi(value);
+			else if (key == "--duration") option.DurationSec = atoi(value);
+			else if (key == "--warmup") option.WarmupMilliSec = atoi(value);
+			else if (key == "--sizes") option.PayloadSizeList = ParseIntList(value);
+			else if (key == "--conns") option.ConnectionCountList = ParseIntList(value);
+			else if (key == "--depths") option.PipelineDepthList = ParseIntList(value);
+			else if (key == "--flush" && strcmp(value, "tick") == 0) option.SendFlushMode = NServerNetLib::SEND_FLUSH_MODE::TICK;
+			else if (key == "--flush" && strcmp(value, "select") == 0) option.SendFlushMode = NServerNetLib::SEND_FLUSH_MODE::SELECT;
+			else return false;
+		}
+		return true;
+	}
+
+	class EchoClient : public NBotClient::IClientHandler
+	{
+	public:
+		// 한 케이스를 돌리고 결과를 JSON 한 줄로 출력한다. 실패하면 false.
+		bool RunCase(const BenchOption& option, const EchoCase& echoCase, const clockid_t serverClockId, NServerNetLib::NetStats* pServerNetStats)
+		{
+			m_Case = echoCase;
+			m_Latency.Init((int)PACKET_ID::MAX);
+			m_ConnectedCount = 0;
+			m_FailCount = 0;
+			m_ErrorCount = 0;
+			m_IsMeasure = false;
+			m_MessageCount = 0;
+
+			m_SendTimeList.assign(echoCase.ConnectionCount, std::vector<int64_t>(echoCase.PipelineDepth, 0));
+			m_SendTimeHead.assign(echoCase.ConnectionCount, 0);
+			m_SendTimeCount.assign(echoCase.ConnectionCount, 0);
+
+			m_ReqPkt.DataSize = (short)echoCase.PayloadSize;
+			for (int i = 0; i < echoCase.PayloadSize; ++i) {
+				m_ReqPkt.Datas[i] = (char)i;
+			}
+
+			auto bufferSize = (echoCase.PayloadSize + ECHO_RES_OVERHEAD_SIZE) * echoCase.PipelineDepth * 2;
+			if (m_Engine.Init(echoCase.ConnectionCount, bufferSize, bufferSize, this) == false) {
+				return false;
+			}
+
+			for (int i = 0; i < echoCase.ConnectionCount; ++i) {
+				m_Engine.Connect(i, "127.0.0.1", option.Port);
+			}
+
+			auto deadline = NowMicroSec() + STALL_TIMEOUT_MILLISEC * 1000;
+			while (m_ConnectedCount + m_FailCount < echoCase.ConnectionCount && NowMicroSec() < deadline) {
+				m_Engine.Poll(1);
+			}
+
+			if (m_ConnectedCount != echoCase.ConnectionCount)
+			{
+				fprintf(stderr, "connect fail. connected %d / %d\n", m_ConnectedCount, echoCase.ConnectionCount);
+				m_Engine.Release();
+				return false;
+			}
+
+			// 연결이 모두 끝난 뒤에 한꺼번에 파이프라인을 채운다.
+			for (int i = 0; i < echoCase.ConnectionCount; ++i)
+			{
+				for (int depth = 0; depth < echoCase.PipelineDepth; ++depth) {
+					SendEcho(i);
+				}
+			}
+
+			auto isStall = false;
+			auto warmupEndTime = NowMicroSec() + (int64_t)option.WarmupMilliSec * 1000;
+			PollUntil(warmupEndTime, isStall);
+
+			m_IsMeasure = true;
+			auto startTime = NowMicroSec();
+			auto startServerCpu = ClockNanoSec(serverClockId);
+			auto startClientCpu = ClockNanoSec(CLOCK_THREAD_CPUTIME_ID);
+			auto startProcessCpu = ProcessCpuNanoSec();
+			auto startServerSendCall = pServerNetStats->SendCallCount.load(std::memory_order_relaxed);
+
+			PollUntil(startTime + (int64_t)option.DurationSec * 1000000, isStall);
+
+			auto elapsedSec = (double)(NowMicroSec() - startTime) / 1000000.0;
+			auto serverCpu = ClockNanoSec(serverClockId) - startServerCpu;
+			auto clientCpu = ClockNanoSec(CLOCK_THREAD_CPUTIME_ID) - startClientCpu;
+			auto processCpu = ProcessCpuNanoSec() - startProcessCpu;
+			auto serverSendCall = pServerNetStats->SendCallCount.load(std::memory_order_relaxed) - startServerSendCall;
+			m_IsMeasure = false;
+
+			// 응답을 다 받고 끊어야 서버가 끊긴 소켓에 보내다가 에러를 내지 않는다.
+			m_IsDrain = true;
+			auto drainEndTime = NowMicroSec() + STALL_TIMEOUT_MILLISEC * 1000;
+			while (GetInFlightCount() > 0 && NowMicroSec() < drainEndTime) {
+				m_Engine.Poll(1);
+			}
+			m_IsDrain = false;
+
+			m_Engine.Release();
+
+			auto summary = m_Latency.GetSummary((short)PACKET_ID::DEV_ECHO_REQ);
+			auto messageCount = m_MessageCount > 0 ? m_MessageCount : 1;
+
+			printf("{\"bench\":\"echo\",\"flush\":\"%s\",\"payload\":%d,\"conns\":%d,\"depth\":%d,\"duration_sec\":%.3f,"
+				"\"messages\":%lld,\"msg_per_sec\":%.1f,\"payload_mb_per_sec\":%.3f,"
+				"\"avg_us\":%.1f,\"p50_us\":%lld,\"p99_us\":%lld,\"p999_us\":%lld,\"max_us\":%lld,"
+				"\"server_cpu_ns_per_msg\":%.1f,\"client_cpu_ns_per_msg\":%.1f,\"process_cpu_ns_per_msg\":%.1f,"
+				"\"server_msg_per_send\":%.2f,\"errors\":%lld,\"stalled\":%s}\n",
+				GetSendFlushModeName(option.SendFlushMode), echoCase.PayloadSize, echoCase.ConnectionCount, echoCase.PipelineDepth, elapsedSec,
+				(long long)m_MessageCount, m_MessageCount / elapsedSec, (double)m_MessageCount * echoCase.PayloadSize / elapsedSec / (1024 * 1024),
+				summary.AvgMicroSec, (long long)summary.P50MicroSec, (long long)summary.P99MicroSec, (long long)summary.P999MicroSec, (long long)summary.MaxMicroSec,
+				(double)serverCpu / messageCount, (double)clientCpu / messageCount, (double)processCpu / messageCount,
+				(double)m_MessageCount / (serverSendCall > 0 ? serverSendCall : 1), (long long)m_ErrorCount, isStall ? "true" : "false");
+			fflush(stdout);
+
+			return isStall == false;
+		}
+
+	public:
+		void OnConnect(const int connIndex, const bool isSuccess) override
+		{
+			if (isSuccess) {
+				++m_ConnectedCount;
+			}
+			else {
+				++m_FailCount;
+			}
+		}
+
+		void OnPacket(const int connIndex, const short packetId, const char* pBody, const short bodySize, const int requestSeq) override
+		{
+			if (packetId != (short)PACKET_ID::DEV_ECHO_RES || m_SendTimeCount[connIndex] == 0) {
+				return;
+			}
+
+			// 응답은 요청 순서대로 온다.
+			auto& head = m_SendTimeHead[connIndex];
+			auto sendTime = m_SendTimeList[connIndex][head];
+			head = (head + 1) % m_Case.PipelineDepth;
+			--m_SendTimeCount[connIndex];
+
+			auto pResPkt = (NCommon::PktDevEchoRes*)pBody;
+			auto isError = bodySize < (short)(sizeof(short) * 2) || pResPkt->ErrorCode != (short)NCommon::ERROR_CODE::NONE || pResPkt->DataSize != m_Case.PayloadSize;
+
+			if (m_IsMeasure)
+			{
+				m_Latency.Record((short)PACKET_ID::DEV_ECHO_REQ, NowMicroSec() - sendTime);
+				++m_MessageCount;
+				if (isError) {
+					++m_ErrorCount;
+				}
+			}
+
+			m_LatestRecvTime = NowMicroSec();
+			if (m_IsDrain == false) {
+				SendEcho(connIndex);
+			}
+		}
+
+		void OnClose(const int connIndex) override
+		{
+			m_SendTimeCount[connIndex] = 0;
+		}
+
+	private:
+		void SendEcho(const int connIndex)
+		{
+			auto tail = (m_SendTimeHead[connIndex] + m_SendTimeCount[connIndex]) % m_Case.PipelineDepth;
+			auto bodySize = (short)(sizeof(short) + m_Case.PayloadSize);
+			if (m_Engine.Send(connIndex, (short)PACKET_ID::DEV_ECHO_REQ, bodySize, (char*)&m_ReqPkt) == false) {
+				return;
+			}
+
+			m_SendTimeList[connIndex][tail] = NowMicroSec();
+			++m_SendTimeCount[connIndex];
+		}
+
+		int GetInFlightCount()
+		{
+			int count = 0;
+			for (auto sendTimeCount : m_SendTimeCount) {
+				count += sendTimeCount;
+			}
+			return count;
+		}
+
+		void PollUntil(const int64_t endTime, bool& isStall)
+		{
+			m_LatestRecvTime = NowMicroSec();
+			while (isStall == false)
+			{
+				m_Engine.Poll(1);
+
+				auto curTime = NowMicroSec();
+				if (curTime >= endTime) {
+					break;
+				}
+
+				if (curTime - m_LatestRecvTime > STALL_TIMEOUT_MILLISEC * 1000) {
+					isStall = true;
+				}
+			}
+		}
+
+	private:
+		NBotClient::ClientEngine m_Engine;
+		NBotClient::LatencyRecorder m_Latency;
+		NCommon::PktDevEchoReq m_ReqPkt;
+		EchoCase m_Case;
+
+		// 접속마다 아직 응답을 못 받은 요청의 전송 시각을 원형 큐로 들고 있는다.
+		std::vector<std::vector<int64_t>> m_SendTimeList;
+		std::vector<int> m_SendTimeHead;
+		std::vector<int> m_SendTimeCount;
+
+		int m_ConnectedCount = 0;
+		int m_FailCount = 0;
+		bool m_IsMeasure = false;
+		bool m_IsDrain = false;
+		int64_t m_MessageCount = 0;
+		int64_t m_ErrorCount = 0;
+		int64_t m_LatestRecvTime = 0;
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	BenchOption option;
+	if (ParseOption(argc, argv, option) == false)
+	{
+		fprintf(stderr, "usage: %s [--port=N] [--duration=SEC] [--warmup=MS] [--sizes=a,b] [--conns=a,b] [--depths=a,b] [--flush=tick|select]\n", argv[0]);
+		return 1;
+	}
+
+	// 케이스가 끝나서 끊은 접속에 서버가 응답을 보내다가 SIGPIPE 로 같이 죽지 않게 한다.
+	signal(SIGPIPE, SIG_IGN);
+
+	auto maxConnectionCount = 0;
+	for (auto count : option.ConnectionCountList) {
+		maxConnectionCount = count > maxConnectionCount ? count : maxConnectionCount;
+	}
+
+	NServerNetLib::ServerConfig config;
+	memset(&config, 0, sizeof(config));
+	config.Port = option.Port;
+	config.BackLogCount = 128;
+	config.MaxClientCount = maxConnectionCount;
+	config.ExtraClientCount = 16;
+	config.MaxClientSockOptRecvBufferSize = BENCH_SESSION_BUFFER_SIZE;
+	config.MaxClientSockOptSendBufferSize = BENCH_SESSION_BUFFER_SIZE;
+	config.MaxClientRecvBufferSize = BENCH_SESSION_BUFFER_SIZE;
+	config.MaxClientSendBufferSize = BENCH_SESSION_BUFFER_SIZE;
+	config.IsLoginCheck = false;
+	config.MaxLobbyCount = 1;
+	config.MaxLobbyUserCount = 1;
+	config.MaxRoomCountByLobby = 1;
+	config.MaxRoomUserCount = 1;
+	config.SendFlushMode = option.SendFlushMode;
+
+	NLogicLib::Main server;
+	if (server.Initialize(config, std::make_unique<NBench::BenchLog>()) != ERROR_CODE::NONE)
+	{
+		fprintf(stderr, "server init fail\n");
+		return 1;
+	}
+
+	std::thread logicThread([&server]() { server.Run(); });
+
+	clockid_t serverClockId;
+	pthread_getcpuclockid(logicThread.native_handle(), &serverClockId);
+
+	auto failCount = 0;
+	EchoClient client;
+
+	for (auto payloadSize : option.PayloadSizeList)
+	{
+		for (auto connectionCount : option.ConnectionCountList)
+		{
+			for (auto pipelineDepth : option.PipelineDepthList)
+			{
+				EchoCase echoCase{ payloadSize, connectionCount, pipelineDepth };
+
+				if (payloadSize < 0 || payloadSize > MAX_ECHO_PAYLOAD_SIZE || connectionCount <= 0 || pipelineDepth <= 0)
+				{
+					fprintf(stderr, "skip invalid case. payload %d, conns %d, depth %d\n", payloadSize, connectionCount, pipelineDepth);
+					continue;
+				}
+
+				// 서버는 세션 송신 버퍼가 차면 응답을 버리므로, 파이프라인 전체 응답이 버퍼에 들어가야 한다.
+				if ((payloadSize + ECHO_RES_OVERHEAD_SIZE) * pipelineDepth > BENCH_SESSION_BUFFER_SIZE)
+				{
+					fprintf(stderr, "skip case. payload %d x depth %d exceeds session send buffer\n", payloadSize, pipelineDepth);
+					continue;
+				}
+
+				if (client.RunCase(option, echoCase, serverClockId, server.GetNetStats()) == false) {
+					++failCount;
+				}
+
+				// 서버가 이전 케이스의 접속 종료를 다 처리할 시간을 준다.
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			}
+		}
+	}
+
+	server.Stop();
+	logicThread.join();
+
+	return failCount > 0 ? 1 : 0;
+}
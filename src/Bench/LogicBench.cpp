@@ -0,0 +1,703 @@
+﻿#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <atomic>
+
+#include "../Common/Packet.h"
+#include "../Common/ErrorCode.h"
+#include "../ServerNetLib/ITcpNetwork.h"
+#include "../LogicLib/IniReader.h"
+#include "../LogicLib/User.h"
+#include "../LogicLib/UserManager.h"
+#include "../LogicLib/Room.h"
+#include "../LogicLib/Lobby.h"
+#include "../LogicLib/LobbyManager.h"
+#include "../LogicLib/PacketProcess.h"
+#include "../LogicLib/ServerMetrics.h"
+#include "../LogicLib/TaskScheduler.h"
+#include "../LogicLib/TimerService.h"
+#include "../LogicLib/Coroutine.h"
+#include "../LogicLib/RoomTickScheduler.h"
+#include "BenchLog.h"
+#include "MockNetwork.h"
+#include "MicroBench.h"
+
+/*
+로직 계층 자료구조 마이크로 벤치마크.
+풀 크기는 ServerConfig.ini 값을 그대로 써서 실제 서버와 같은 조건에서 잰다. 자료구조를 바꿀 때 전후 수치를 비교한다.
+
+사용법: LogicBench [--config=../resources/ServerConfig.ini] [--json]
+*/
+
+using namespace NLogicLib;
+using namespace NBench;
+using PACKET_ID = NCommon::PACKET_ID;
+
+namespace
+{
+	const int LOOP_BATCH_COUNT = 100000;
+
+	struct BenchEnv
+	{
+		NServerNetLib::ServerConfig Config;
+		bool IsJson = false;
+
+		std::vector<std::string> UserIDList;
+		BenchLog Logger;
+		MockNetwork Network;
+	};
+
+	bool LoadConfig(const std::string& filePath, NServerNetLib::ServerConfig& config)
+	{
+		INIReader reader(filePath);
+		if (reader.ParseError() < 0) {
+			return false;
+		}
+
+		memset(&config, 0, sizeof(config));
+		config.MaxClientCount = reader.GetInteger("Config", "MaxClientCount", 0);
+		config.ExtraClientCount = reader.GetInteger("Config", "ExtraClientCount", 0);
+		config.IsLoginCheck = false;
+		config.MaxLobbyCount = reader.GetInteger("Config", "MaxLobbyCount", 0);
+		config.MaxLobbyUserCount = reader.GetInteger("Config", "MaxLobbyUserCount", 0);
+		config.MaxRoomCountByLobby = reader.GetInteger("Config", "MaxRoomCountByLobby", 0);
+		config.MaxRoomUserCount = reader.GetInteger("Config", "MaxRoomUserCount", 0);
+		return true;
+	}
+
+	// 로비/룸 벤치마크에서 쓸 로그인 끝난 유저들
+	std::vector<User> MakeLoginUsers(BenchEnv& env, const int count)
+	{
+		std::vector<User> userList(count);
+		for (int i = 0; i < count; ++i)
+		{
+			userList[i].Init((short)i);
+			userList[i].Set(i, UserID(env.UserIDList[i].c_str()));
+		}
+		return userList;
+	}
+
+	void BenchUserManager(BenchEnv& env)
+	{
+		auto userCount = env.Config.MaxClientCount;
+
+		PrintResult(RunBench("UserManager::AddUser (fill pool)", [&]() {
+			UserManager userMgr;
+			userMgr.Init(userCount);
+
+			auto startTime = NowNanoSec();
+			for (int i = 0; i < userCount; ++i) {
+				userMgr.AddUser(i, env.UserIDList[i].c_str());
+			}
+			return BenchRound{ NowNanoSec() - startTime, userCount };
+		}), env.IsJson);
+
+		std::vector<int> removeOrder(userCount);
+		for (int i = 0; i < userCount; ++i) {
+			removeOrder[i] = i;
+		}
+		std::shuffle(removeOrder.begin(), removeOrder.end(), std::mt19937(1));
+
+		PrintResult(RunBench("UserManager::RemoveUser (drain pool)", [&]() {
+			UserManager userMgr;
+			userMgr.Init(userCount);
+			for (int i = 0; i < userCount; ++i) {
+				userMgr.AddUser(i, env.UserIDList[i].c_str());
+			}
+
+			auto startTime = NowNanoSec();
+			for (auto sessionIndex : removeOrder) {
+				userMgr.RemoveUser(sessionIndex);
+			}
+			return BenchRound{ NowNanoSec() - startTime, userCount };
+		}), env.IsJson);
+
+		UserManager userMgr;
+		userMgr.Init(userCount);
+		for (int i = 0; i < userCount; ++i) {
+			userMgr.AddUser(i, env.UserIDList[i].c_str());
+		}
+
+		PrintResult(RunBenchLoop("UserManager::GetUser (full pool)", LOOP_BATCH_COUNT, [&](const int i) {
+			auto ret = userMgr.GetUser(removeOrder[i % userCount]);
+			DoNotOptimize(std::get<1>(ret));
+		}), env.IsJson);
+	}
+
+	void BenchLobby(BenchEnv& env)
+	{
+		auto lobbyUserCount = env.Config.MaxLobbyUserCount;
+		auto roomCount = env.Config.MaxRoomCountByLobby;
+		auto userList = MakeLoginUsers(env, lobbyUserCount);
+
+		auto initLobby = [&](Lobby& lobby) {
+			lobby.Init(0, (short)lobbyUserCount, (short)roomCount, (short)env.Config.MaxRoomUserCount);
+			lobby.SetNetwork(&env.Network, &env.Logger);
+		};
+
+		PrintResult(RunBench("Lobby::EnterUser (fill lobby)", [&]() {
+			Lobby lobby;
+			initLobby(lobby);
+
+			auto startTime = NowNanoSec();
+			for (auto& user : userList) {
+				lobby.EnterUser(&user);
+			}
+			auto elapsed = NowNanoSec() - startTime;
+
+			lobby.Release();
+			return BenchRound{ elapsed, lobbyUserCount };
+		}), env.IsJson);
+
+		std::vector<int> leaveOrder(lobbyUserCount);
+		for (int i = 0; i < lobbyUserCount; ++i) {
+			leaveOrder[i] = i;
+		}
+		std::shuffle(leaveOrder.begin(), leaveOrder.end(), std::mt19937(1));
+
+		PrintResult(RunBench("Lobby::LeaveUser (drain lobby)", [&]() {
+			Lobby lobby;
+			initLobby(lobby);
+			for (auto& user : userList) {
+				lobby.EnterUser(&user);
+			}
+
+			auto startTime = NowNanoSec();
+			for (auto userIndex : leaveOrder) {
+				lobby.LeaveUser(userIndex);
+			}
+			auto elapsed = NowNanoSec() - startTime;
+
+			lobby.Release();
+			return BenchRound{ elapsed, lobbyUserCount };
+		}), env.IsJson);
+
+		// 빈자리가 맨 끝 하나뿐인 상태에서 들어왔다 나가기를 반복. find_if 가 끝까지 훑는 경우다.
+		{
+			Lobby lobby;
+			initLobby(lobby);
+			for (int i = 0; i < lobbyUserCount - 1; ++i) {
+				lobby.EnterUser(&userList[i]);
+			}
+
+			auto& lastUser = userList[lobbyUserCount - 1];
+			PrintResult(RunBenchLoop("Lobby::EnterUser+LeaveUser (lobby full-1)", LOOP_BATCH_COUNT, [&](const int i) {
+				lobby.EnterUser(&lastUser);
+				lobby.LeaveUser(lastUser.GetIndex());
+			}), env.IsJson);
+
+			lobby.Release();
+		}
+
+		{
+			Lobby lobby;
+			initLobby(lobby);
+			for (auto& user : userList) {
+				lobby.EnterUser(&user);
+			}
+
+			// 한 틱에 채팅 10개가 와도 로비 유저마다 통보는 한 번만 나간다.
+			const short CHAT_COUNT_PER_TICK = 10;
+			const char* pChatMsg = "hello lobby";
+			auto chatMsgLength = (short)strlen(pChatMsg);
+			PrintResult(RunBenchLoop("Lobby::Chat x10 + SendChat (full lobby)", LOOP_BATCH_COUNT / 100, [&](const int i) {
+				for (short chat = 0; chat < CHAT_COUNT_PER_TICK; ++chat) {
+					lobby.Chat(&userList[chat % lobbyUserCount], pChatMsg, chatMsgLength);
+				}
+				lobby.SendChat();
+			}), env.IsJson);
+
+			lobby.Release();
+		}
+
+		{
+			Lobby lobby;
+			initLobby(lobby);
+
+			PrintResult(RunBenchLoop("Lobby::GetAvailableRoom (all free)", LOOP_BATCH_COUNT, [&](const int i) {
+				DoNotOptimize(lobby.GetAvailableRoom());
+			}), env.IsJson);
+
+			for (short i = 0; i < roomCount - 1; ++i) {
+				lobby.GetRoom(i)->CreateRoom("bench", 5);
+			}
+
+			PrintResult(RunBenchLoop("Lobby::GetAvailableRoom (last one free)", LOOP_BATCH_COUNT, [&](const int i) {
+				DoNotOptimize(lobby.GetAvailableRoom());
+			}), env.IsJson);
+
+			PrintResult(RunBenchLoop("Lobby::SendRoomList (first page)", LOOP_BATCH_COUNT, [&](const int i) {
+				lobby.SendRoomList(i & 1023, 0, false, false);
+			}), env.IsJson);
+
+			lobby.GetRoom((short)(roomCount - 1))->CreateRoom("bench", 5);
+
+			PrintResult(RunBenchLoop("Lobby::GetAvailableRoom (all used)", LOOP_BATCH_COUNT, [&](const int i) {
+				DoNotOptimize(lobby.GetAvailableRoom());
+			}), env.IsJson);
+
+			lobby.Release();
+		}
+	}
+
+	void BenchRoom(BenchEnv& env)
+	{
+		auto roomUserCount = env.Config.MaxRoomUserCount;
+		auto userList = MakeLoginUsers(env, roomUserCount);
+
+		Lobby lobby;
+		lobby.Init(0, (short)env.Config.MaxLobbyUserCount, 1, (short)roomUserCount);
+		lobby.SetNetwork(&env.Network, &env.Logger);
+
+		auto pRoom = lobby.GetRoom(0);
+		pRoom->CreateRoom("bench", 5);
+		for (auto& user : userList) {
+			pRoom->EnterUser(&user);
+		}
+
+		NCommon::PktRoomChatNtf ntfPkt;
+		strncpy(ntfPkt.UserID, env.UserIDList[0].c_str(), NCommon::MAX_USER_ID_SIZE);
+		ntfPkt.MsgLength = NCommon::CopyUtf8(ntfPkt.Msg, NCommon::MAX_ROOM_CHAT_MSG_SIZE, "hello room");
+		auto ntfSize = (short)(sizeof(ntfPkt) - NCommon::MAX_ROOM_CHAT_MSG_SIZE + ntfPkt.MsgLength);
+
+		PrintResult(RunBenchLoop("Room::SendToAllUser (full room, chat ntf)", LOOP_BATCH_COUNT, [&](const int i) {
+			pRoom->SendToAllUser((short)PACKET_ID::ROOM_CHAT_NTF, ntfSize, (char*)&ntfPkt);
+		}), env.IsJson);
+
+		lobby.Release();
+	}
+
+	void BenchLobbyManager(BenchEnv& env)
+	{
+		LobbyManager lobbyMgr;
+		lobbyMgr.Init({ env.Config.MaxLobbyCount, env.Config.MaxLobbyUserCount, env.Config.MaxRoomCountByLobby, env.Config.MaxRoomUserCount },
+			&env.Network, &env.Logger);
+
+		PrintResult(RunBenchLoop("LobbyManager::SendLobbyListInfo (full)", LOOP_BATCH_COUNT, [&](const int i) {
+			lobbyMgr.SendLobbyListInfo(i & 1023);
+		}), env.IsJson);
+
+		// 처음 요청에서 스냅샷 버전이 1 로 정해진다.
+		PrintResult(RunBenchLoop("LobbyManager::SendLobbyListInfo (not modified)", LOOP_BATCH_COUNT, [&](const int i) {
+			lobbyMgr.SendLobbyListInfo(i & 1023, 1);
+		}), env.IsJson);
+	}
+
+	void BenchPacketProcess(BenchEnv& env)
+	{
+		auto& config = env.Config;
+
+		UserManager userMgr;
+		userMgr.Init(config.MaxClientCount);
+
+		LobbyManager lobbyMgr;
+		lobbyMgr.Init({ config.MaxLobbyCount, config.MaxLobbyUserCount, config.MaxRoomCountByLobby, config.MaxRoomUserCount }, &env.Network, &env.Logger);
+
+		ServerMetrics metrics;
+		metrics.Init(lobbyMgr.GetLobbyCount());
+
+		PacketProcess packetProc;
+		packetProc.Init(&env.Network, &userMgr, &lobbyMgr, &config, &env.Logger);
+		packetProc.SetMetrics(&metrics);
+
+		auto process = [&](const int sessionIndex, const PACKET_ID packetId, const short bodySize, void* pBody) {
+			NServerNetLib::RecvPacketInfo packetInfo;
+			packetInfo.SessionIndex = sessionIndex;
+			packetInfo.PacketId = (short)packetId;
+			packetInfo.PacketBodySize = bodySize;
+			packetInfo.pRefData = (char*)pBody;
+			packetProc.Process(packetInfo);
+		};
+
+		// 룸 하나를 꽉 채운다. 첫 유저가 방을 만들고 나머지는 0번 방에 들어간다.
+		for (int i = 0; i < config.MaxRoomUserCount; ++i)
+		{
+			process(i, (PACKET_ID)NServerNetLib::PACKET_ID::NTF_SYS_CONNECT_SESSION, 0, nullptr);
+
+			NCommon::PktLogInReq loginReq;
+			strncpy(loginReq.szID, env.UserIDList[i].c_str(), NCommon::MAX_USER_ID_SIZE);
+			process(i, PACKET_ID::LOGIN_IN_REQ, sizeof(loginReq), &loginReq);
+
+			NCommon::PktLobbyEnterReq lobbyReq;
+			lobbyReq.LobbyId = 0;
+			process(i, PACKET_ID::LOBBY_ENTER_REQ, sizeof(lobbyReq), &lobbyReq);
+
+			NCommon::PktRoomEnterReq roomReq;
+			memset(&roomReq, 0, sizeof(roomReq));
+			roomReq.IsCreate = i == 0;
+			roomReq.RoomIndex = 0;
+			roomReq.RoomTitleLength = NCommon::CopyUtf8(roomReq.RoomTitle, NCommon::MAX_ROOM_TITLE_SIZE, "bench");
+			process(i, PACKET_ID::ROOM_ENTER_REQ, sizeof(roomReq), &roomReq);
+		}
+
+		// 로비 목록 요청용으로 로그인만 한 유저
+		auto loginSessionIndex = config.MaxRoomUserCount;
+		process(loginSessionIndex, (PACKET_ID)NServerNetLib::PACKET_ID::NTF_SYS_CONNECT_SESSION, 0, nullptr);
+		NCommon::PktLogInReq loginReq;
+		strncpy(loginReq.szID, env.UserIDList[loginSessionIndex].c_str(), NCommon::MAX_USER_ID_SIZE);
+		process(loginSessionIndex, PACKET_ID::LOGIN_IN_REQ, sizeof(loginReq), &loginReq);
+
+		NCommon::PktDevEchoReq echoReq;
+		echoReq.DataSize = 0;
+		PrintResult(RunBenchLoop("PacketProcess::Process DEV_ECHO_REQ (0B)", LOOP_BATCH_COUNT, [&](const int i) {
+			process(0, PACKET_ID::DEV_ECHO_REQ, sizeof(short), &echoReq);
+		}), env.IsJson);
+
+		PrintResult(RunBenchLoop("PacketProcess::Process LOBBY_LIST_REQ", LOOP_BATCH_COUNT, [&](const int i) {
+			process(loginSessionIndex, PACKET_ID::LOBBY_LIST_REQ, 0, nullptr);
+		}), env.IsJson);
+
+		NCommon::PktRoomChatReq chatReq;
+		chatReq.MsgLength = NCommon::CopyUtf8(chatReq.Msg, NCommon::MAX_ROOM_CHAT_MSG_SIZE, "hello room");
+		auto chatBodySize = (short)(sizeof(chatReq) - NCommon::MAX_ROOM_CHAT_MSG_SIZE + chatReq.MsgLength);
+		PrintResult(RunBenchLoop("PacketProcess::Process ROOM_CHAT_REQ (full room)", LOOP_BATCH_COUNT, [&](const int i) {
+			process(0, PACKET_ID::ROOM_CHAT_REQ, chatBodySize, &chatReq);
+		}), env.IsJson);
+	}
+
+	void BenchTaskScheduler(BenchEnv& env)
+	{
+		// 로그인 검사처럼 세션 수만큼의 목록을 나눠 훑는다. 세션마다 조금 무거운 계산을 넣어서 나눈 효과가 보이게 한다.
+		auto itemCount = env.Config.MaxClientCount + env.Config.ExtraClientCount;
+		std::vector<int64_t> itemList(itemCount);
+		for (int i = 0; i < itemCount; ++i) {
+			itemList[i] = i;
+		}
+
+		for (auto workerCount : { 0, 2, 4 })
+		{
+			TaskScheduler scheduler;
+			scheduler.Init(workerCount, &env.Logger);
+
+			char name[64];
+			snprintf(name, sizeof(name), "TaskScheduler::Submit+Wait (workers %d)", workerCount);
+			PrintResult(RunBenchLoop(name, 10000, [&](const int i) {
+				TaskGroup group;
+				scheduler.Submit(group, []() {});
+				scheduler.Wait(group);
+			}), env.IsJson);
+
+			snprintf(name, sizeof(name), "TaskScheduler::ParallelFor sweep (workers %d)", workerCount);
+			PrintResult(RunBench(name, [&]() {
+				std::atomic<int64_t> total{ 0 };
+
+				auto startTime = NowNanoSec();
+				TaskGroup group;
+				scheduler.ParallelFor(group, 0, itemCount, 256, [&](const int begin, const int end) {
+					int64_t sum = 0;
+					for (int i = begin; i < end; ++i)
+					{
+						auto value = itemList[i];
+						for (int k = 0; k < 64; ++k) {
+							value = value * 6364136223846793005LL + 1442695040888963407LL;
+						}
+						sum += value;
+					}
+					total.fetch_add(sum, std::memory_order_relaxed);
+				});
+				scheduler.Wait(group);
+				auto elapsed = NowNanoSec() - startTime;
+
+				DoNotOptimize(total.load());
+				return BenchRound{ elapsed, itemCount };
+			}), env.IsJson);
+		}
+	}
+
+	CoTask WaitEventTask(CoEvent& event, TimerService& timer, int& resumeCount)
+	{
+		auto result = co_await event.Wait(&timer, 10000);
+		if (result == WAIT_RESULT::SIGNALED) {
+			++resumeCount;
+		}
+	}
+
+	void BenchTimerService(BenchEnv& env)
+	{
+		// 룸마다 타이머 하나씩 걸려 있는 상태에서 잰다.
+		auto roomCount = env.Config.MaxLobbyCount * env.Config.MaxRoomCountByLobby;
+		int64_t curMilliSec = 0;
+
+		TimerService timer;
+		timer.Init(roomCount, curMilliSec);
+
+		std::vector<TimerId> timerIdList(roomCount);
+		for (int i = 0; i < roomCount; ++i) {
+			timerIdList[i] = timer.AddTimer(10000 + i, [](void*) {}, nullptr);
+		}
+
+		PrintResult(RunBenchLoop("TimerService::AddTimer+CancelTimer", 10000, [&](const int i) {
+			auto timerId = timer.AddTimer(1000 + (i & 1023), [](void*) {}, nullptr);
+			timer.CancelTimer(timerId);
+		}), env.IsJson);
+
+		PrintResult(RunBenchLoop("TimerService::Update (10ms)", 1000, [&](const int i) {
+			curMilliSec += 10;
+			timer.Update(curMilliSec);
+		}), env.IsJson);
+
+		// 게임 시작 대기처럼 코루틴이 시간 제한을 걸고 기다리다가 다른 요청에 깨어난다. 프레임과 타이머 노드는 풀에서 다시 쓴다.
+		CoEvent event;
+		int resumeCount = 0;
+		PrintResult(RunBenchLoop("CoEvent::Wait+Set (coroutine)", 10000, [&](const int i) {
+			WaitEventTask(event, timer, resumeCount);
+			event.Set();
+		}), env.IsJson);
+		DoNotOptimize(resumeCount);
+	}
+
+	void BenchRoomTick(BenchEnv& env)
+	{
+		// 룸이 많고 그중 일부만 게임 중일 때 틱 비용이 게임 중인 룸 수만 따르는지 본다. 한 틱을 op 하나로 센다.
+		const int roomCount = 4096;
+		std::vector<Room> roomList(roomCount);
+		for (int i = 0; i < roomCount; ++i)
+		{
+			roomList[i].Init((short)i, (short)env.Config.MaxRoomUserCount);
+			roomList[i].SetNetwork(&env.Network, &env.Logger);
+		}
+
+		PrintResult(RunBench("Room::Update (scan all 4096 rooms)", [&]() {
+			auto startTime = NowNanoSec();
+			for (auto& room : roomList) {
+				room.Update(0);
+			}
+			return BenchRound{ NowNanoSec() - startTime, 1 };
+		}), env.IsJson);
+
+		for (auto activeCount : { 16, 256, roomCount })
+		{
+			RoomTickScheduler scheduler;
+			int64_t curMilliSec = 0;
+			scheduler.Init(20, 0, curMilliSec);
+
+			for (int i = 0; i < activeCount; ++i)
+			{
+				auto& room = roomList[(int64_t)i * roomCount / activeCount];
+				room.GetGameObj()->SetState(GameState::ING);
+				room.GetGameObj()->StartRound(curMilliSec, 3600 * 1000);
+				scheduler.SetActive(&room, true);
+			}
+
+			char name[64];
+			snprintf(name, sizeof(name), "RoomTickScheduler tick (%d active)", activeCount);
+			PrintResult(RunBench(name, [&]() {
+				curMilliSec += 50;
+				auto startTime = NowNanoSec();
+				scheduler.Update(curMilliSec);
+				return BenchRound{ NowNanoSec() - startTime, 1 };
+			}), env.IsJson);
+
+			for (auto& room : roomList)
+			{
+				scheduler.SetActive(&room, false);
+				room.GetGameObj()->Clear();
+			}
+		}
+	}
+
+	/*
+	가위바위보 부하 시나리오. 로비 4 개에 꽉 찬 룸 512 개씩, 게임 2048 개를 실제 패킷 처리 경로로 돌린다.
+	라운드마다 남은 유저가 모두 무작위로 골라서 타이머를 기다리지 않고 결과가 나고, 끝난 게임은 방장이 다시 시작한다.
+	선택 요청 하나를 op 하나로 세며, 결과 통보와 게임 재시작, 로비 타이머와 룸 틱 비용이 같이 들어간다.
+	*/
+	void BenchGame(BenchEnv& env)
+	{
+		const int lobbyCount = 4;
+		const int roomCountByLobby = 512;
+		const int roomUserCount = env.Config.MaxRoomUserCount;
+		const int roomCount = lobbyCount * roomCountByLobby;
+		const int userCount = roomCount * roomUserCount;
+
+		auto config = env.Config;
+		config.MaxClientCount = userCount;
+		config.ExtraClientCount = 0;
+
+		MockNetwork network;
+		network.Init(userCount);
+
+		// UserManager 는 ID 문자열 포인터를 들고 있으므로 여기서 끝날 때까지 살아 있어야 한다.
+		std::vector<std::string> userIDList;
+		for (int i = 0; i < userCount; ++i) {
+			userIDList.push_back("g" + std::to_string(i));
+		}
+
+		UserManager userMgr;
+		userMgr.Init(userCount);
+
+		LobbyManager lobbyMgr;
+		lobbyMgr.Init({ lobbyCount, roomCountByLobby * roomUserCount, roomCountByLobby, roomUserCount }, &network, &env.Logger);
+
+		PacketProcess packetProc;
+		packetProc.Init(&network, &userMgr, &lobbyMgr, &config, &env.Logger);
+
+		auto process = [&](const int sessionIndex, const PACKET_ID packetId, const short bodySize, void* pBody) {
+			NServerNetLib::RecvPacketInfo packetInfo;
+			packetInfo.SessionIndex = sessionIndex;
+			packetInfo.PacketId = (short)packetId;
+			packetInfo.PacketBodySize = bodySize;
+			packetInfo.pRefData = (char*)pBody;
+			packetProc.Process(packetInfo);
+		};
+
+		struct GameRoom
+		{
+			Room* pRoom;
+			int FirstSessionIndex;
+			std::vector<short> UserIndexList;
+		};
+		std::vector<GameRoom> gameRoomList(roomCount);
+
+		for (int roomNo = 0; roomNo < roomCount; ++roomNo)
+		{
+			auto& gameRoom = gameRoomList[roomNo];
+			gameRoom.FirstSessionIndex = roomNo * roomUserCount;
+			auto lobbyIndex = (short)(roomNo / roomCountByLobby);
+
+			short roomIndex = -1;
+			for (int i = 0; i < roomUserCount; ++i)
+			{
+				auto sessionIndex = gameRoom.FirstSessionIndex + i;
+				process(sessionIndex, (PACKET_ID)NServerNetLib::PACKET_ID::NTF_SYS_CONNECT_SESSION, 0, nullptr);
+
+				NCommon::PktLogInReq loginReq;
+				strncpy(loginReq.szID, userIDList[sessionIndex].c_str(), NCommon::MAX_USER_ID_SIZE);
+				process(sessionIndex, PACKET_ID::LOGIN_IN_REQ, sizeof(loginReq), &loginReq);
+
+				NCommon::PktLobbyEnterReq lobbyReq;
+				lobbyReq.LobbyId = lobbyIndex;
+				process(sessionIndex, PACKET_ID::LOBBY_ENTER_REQ, sizeof(lobbyReq), &lobbyReq);
+
+				NCommon::PktRoomEnterReq roomReq;
+				memset(&roomReq, 0, sizeof(roomReq));
+				roomReq.IsCreate = i == 0;
+				roomReq.RoomIndex = roomIndex;
+				roomReq.RoomTitleLength = NCommon::CopyUtf8(roomReq.RoomTitle, NCommon::MAX_ROOM_TITLE_SIZE, "game");
+				process(sessionIndex, PACKET_ID::ROOM_ENTER_REQ, sizeof(roomReq), &roomReq);
+
+				auto pUser = std::get<1>(userMgr.GetUser(sessionIndex));
+				roomIndex = pUser->GetRoomIndex();
+				gameRoom.UserIndexList.push_back(pUser->GetIndex());
+			}
+
+			gameRoom.pRoom = lobbyMgr.GetLobby(lobbyIndex)->GetRoom(roomIndex);
+		}
+
+		// 방장이 시작을 요청하고 나머지가 따라서 요청하면 그 자리에서 게임이 시작되고 첫 라운드가 열린다.
+		auto startGame = [&](GameRoom& gameRoom) {
+			process(gameRoom.FirstSessionIndex, PACKET_ID::ROOM_MASTER_GAME_START_REQ, 0, nullptr);
+			for (int i = 1; i < roomUserCount; ++i) {
+				process(gameRoom.FirstSessionIndex + i, PACKET_ID::ROOM_GAME_START_REQ, 0, nullptr);
+			}
+		};
+
+		for (auto& gameRoom : gameRoomList) {
+			startGame(gameRoom);
+		}
+
+		std::mt19937 random(1234);
+		int64_t roundCount = 0;
+		int64_t gameCount = 0;
+
+		char name[64];
+		snprintf(name, sizeof(name), "Game select (%d rooms x %d users)", roomCount, roomUserCount);
+		PrintResult(RunBench(name, [&]() {
+			int64_t selectCount = 0;
+			auto startTime = NowNanoSec();
+
+			// 모든 룸에서 한 라운드씩 진행한다. 마지막으로 고른 유저의 요청에서 결과가 난다.
+			for (auto& gameRoom : gameRoomList)
+			{
+				auto pGame = gameRoom.pRoom->GetGameObj();
+				if (pGame->GetState() != GameState::ING)
+				{
+					startGame(gameRoom);
+					++gameCount;
+				}
+
+				for (int i = 0; i < roomUserCount; ++i)
+				{
+					if (pGame->IsAlivePlayer(gameRoom.UserIndexList[i]) == false) {
+						continue;
+					}
+
+					NCommon::PktRoomGameSelectReq selectReq;
+					selectReq.Select = (char)(random() % 3);
+					process(gameRoom.FirstSessionIndex + i, PACKET_ID::ROOM_GAME_SELECT_REQ, sizeof(selectReq), &selectReq);
+					++selectCount;
+				}
+				++roundCount;
+			}
+
+			auto curMilliSec = NowNanoSec() / 1000000;
+			lobbyMgr.UpdateTimer(curMilliSec);
+			lobbyMgr.UpdateRoomTick(curMilliSec);
+			return BenchRound{ NowNanoSec() - startTime, selectCount };
+		}), env.IsJson);
+
+		if (env.IsJson == false) {
+			printf("  rounds %lld, finished games %lld\n", (long long)roundCount, (long long)gameCount);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string configPath = "../resources/ServerConfig.ini";
+#ifdef _WIN32
+	configPath = "../../resources/ServerConfig.ini";
+#endif
+
+	BenchEnv env;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--json") {
+			env.IsJson = true;
+		}
+		else if (arg.compare(0, 9, "--config=") == 0) {
+			configPath = arg.substr(9);
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [--config=path] [--json]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (LoadConfig(configPath, env.Config) == false)
+	{
+		fprintf(stderr, "Can't load %s\n", configPath.c_str());
+		return 1;
+	}
+
+	auto& config = env.Config;
+	env.Network.Init(config.MaxClientCount + config.ExtraClientCount);
+
+	// UserManager 는 ID 문자열 포인터를 들고 있으므로 벤치마크 내내 살아 있어야 한다.
+	for (int i = 0; i < config.MaxClientCount; ++i) {
+		env.UserIDList.push_back("user" + std::to_string(i));
+	}
+
+	if (env.IsJson == false)
+	{
+		printf("MaxClientCount %d, MaxLobbyCount %d, MaxLobbyUserCount %d, MaxRoomCountByLobby %d, MaxRoomUserCount %d\n\n",
+			config.MaxClientCount, config.MaxLobbyCount, config.MaxLobbyUserCount, config.MaxRoomCountByLobby, config.MaxRoomUserCount);
+		printf("%-48s %8s %12s %14s %14s\n", "benchmark", "rounds", "ops", "median ns/op", "min ns/op");
+	}
+
+	BenchUserManager(env);
+	BenchLobby(env);
+	BenchRoom(env);
+	BenchLobbyManager(env);
+	BenchPacketProcess(env);
+	BenchTaskScheduler(env);
+	BenchTimerService(env);
+	BenchRoomTick(env);
+	BenchGame(env);
+
+	return 0;
+}
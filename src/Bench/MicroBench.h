@@ -0,0 +1,106 @@
+﻿#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+namespace NBench
+{
+	// 한 라운드 동안 잰 시간과 그 동안 수행한 연산 수
+	struct BenchRound
+	{
+		int64_t ElapsedNanoSec = 0;
+		int64_t OpCount = 0;
+	};
+
+	struct BenchResult
+	{
+		const char* pName = "";
+		int RoundCount = 0;
+		int64_t TotalOpCount = 0;
+		double MedianNanoSecPerOp = 0;
+		double MinNanoSecPerOp = 0;
+	};
+
+	inline int64_t NowNanoSec()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// 컴파일러가 결과를 안 쓰는 계산을 지워 버리지 않도록 한다.
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#ifdef _WIN32
+		volatile auto sink = &value;
+		(void)sink;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/*
+	roundFunc 를 최소 minRoundCount 번, 그리고 잰 시간의 합이 minTotalMilliSec 이상이 될 때까지 반복한다.
+	roundFunc 는 준비 작업은 시간에서 빼고 측정 구간만 BenchRound 에 담아서 돌려준다.
+	라운드마다 연산당 시간을 구해서 중앙값과 최솟값을 낸다.
+	*/
+	template <typename RoundFunc>
+	BenchResult RunBench(const char* pName, RoundFunc&& roundFunc, const int minRoundCount = 5, const int minTotalMilliSec = 300)
+	{
+		std::vector<double> nanoSecPerOpList;
+		BenchResult result;
+		result.pName = pName;
+
+		int64_t totalElapsed = 0;
+		while ((int)nanoSecPerOpList.size() < minRoundCount || totalElapsed < (int64_t)minTotalMilliSec * 1000000)
+		{
+			auto round = roundFunc();
+			if (round.OpCount <= 0) {
+				break;
+			}
+
+			totalElapsed += round.ElapsedNanoSec;
+			result.TotalOpCount += round.OpCount;
+			nanoSecPerOpList.push_back((double)round.ElapsedNanoSec / round.OpCount);
+		}
+
+		if (nanoSecPerOpList.empty()) {
+			return result;
+		}
+
+		std::sort(nanoSecPerOpList.begin(), nanoSecPerOpList.end());
+		result.RoundCount = (int)nanoSecPerOpList.size();
+		result.MedianNanoSecPerOp = nanoSecPerOpList[nanoSecPerOpList.size() / 2];
+		result.MinNanoSecPerOp = nanoSecPerOpList.front();
+		return result;
+	}
+
+	// 반복 횟수를 정해 두고 같은 연산을 계속 돌리는 경우. 라운드마다 batchCount 번 호출한다.
+	template <typename OpFunc>
+	BenchResult RunBenchLoop(const char* pName, const int batchCount, OpFunc&& opFunc)
+	{
+		return RunBench(pName, [&]() {
+			auto startTime = NowNanoSec();
+			for (int i = 0; i < batchCount; ++i) {
+				opFunc(i);
+			}
+			return BenchRound{ NowNanoSec() - startTime, batchCount };
+		});
+	}
+
+	inline void PrintResult(const BenchResult& result, const bool isJson)
+	{
+		if (isJson)
+		{
+			printf("{\"bench\":\"%s\",\"rounds\":%d,\"ops\":%lld,\"median_ns_per_op\":%.1f,\"min_ns_per_op\":%.1f}\n",
+				result.pName, result.RoundCount, (long long)result.TotalOpCount, result.MedianNanoSecPerOp, result.MinNanoSecPerOp);
+		}
+		else
+		{
+			printf("%-48s %8d %12lld %14.1f %14.1f\n", result.pName, result.RoundCount, (long long)result.TotalOpCount, result.MedianNanoSecPerOp, result.MinNanoSecPerOp);
+		}
+		fflush(stdout);
+	}
+}
@@ -0,0 +1,123 @@
+﻿#pragma once
+
+#include <string.h>
+#include <vector>
+#include "../ServerNetLib/ITcpNetwork.h"
+
+namespace NBench
+{
+	// 소켓 없이 로직만 돌릴 때 쓰는 네트워크. 보낸 패킷은 세션 송신 버퍼에 복사하는 것처럼 흉내만 내고 개수와 크기를 센다.
+	class MockNetwork : public NServerNetLib::ITcpNetwork
+	{
+	public:
+		MockNetwork() {}
+		virtual ~MockNetwork() {}
+
+		// compressMinBodySize 는 서버 설정의 CompressMinBodySize. 압축은 하지 않고 로그인 응답에서 수락 여부만 서버와 맞춘다.
+		void Init(const int sessionPoolSize, const int compressMinBodySize = 0)
+		{
+			m_SessionPoolSize = sessionPoolSize;
+			m_CompressMinBodySize = compressMinBodySize;
+			m_SendBuffer.resize(NServerNetLib::PACKET_HEADER_SIZE + NServerNetLib::MAX_PACKET_BODY_SIZE * 4);
+		}
+
+		NServerNetLib::NET_ERROR_CODE SendData(const int sessionIndex, const short packetId, const short size, const char* pMsg) override
+		{
+			auto pBody = ReserveSend(sessionIndex, packetId, size);
+			if (pBody == nullptr) {
+				return NServerNetLib::NET_ERROR_CODE::CLIENT_SEND_BUFFER_FULL;
+			}
+
+			if (size > 0) {
+				memcpy(pBody, pMsg, size);
+			}
+			return CommitSend(sessionIndex, size);
+		}
+
+		char* ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize) override
+		{
+			// 서버처럼 요청의 응답에만 순번을 붙인다.
+			auto isReply = sessionIndex == m_ReplySessionIndex && packetId == m_ReplyPacketId;
+			auto headerSize = NServerNetLib::PACKET_HEADER_SIZE + (isReply ? NServerNetLib::PACKET_SEQUENCE_SIZE : 0);
+			if (maxBodySize < 0 || headerSize + maxBodySize > (int)m_SendBuffer.size()) {
+				return nullptr;
+			}
+
+			NServerNetLib::PacketHeader header{ (short)(maxBodySize + headerSize), packetId, (uint8_t)(isReply ? NServerNetLib::PACKET_FLAG_SEQUENCE : 0) };
+			memcpy(&m_SendBuffer[0], &header, NServerNetLib::PACKET_HEADER_SIZE);
+
+			if (isReply)
+			{
+				auto seq = (uint16_t)m_ReplySeq;
+				memcpy(&m_SendBuffer[NServerNetLib::PACKET_HEADER_SIZE], &seq, NServerNetLib::PACKET_SEQUENCE_SIZE);
+			}
+
+			m_ReservedBodySize = maxBodySize;
+			m_ReservedHeaderSize = headerSize;
+			return &m_SendBuffer[headerSize];
+		}
+
+		NServerNetLib::NET_ERROR_CODE CommitSend(const int sessionIndex, const short bodySize) override
+		{
+			auto reservedBodySize = m_ReservedBodySize;
+			m_ReservedBodySize = -1;
+
+			if (reservedBodySize < 0) {
+				return NServerNetLib::NET_ERROR_CODE::CLIENT_SEND_NOT_RESERVED;
+			}
+			if (bodySize < 0) {
+				return NServerNetLib::NET_ERROR_CODE::NONE;
+			}
+			if (bodySize > reservedBodySize) {
+				return NServerNetLib::NET_ERROR_CODE::CLIENT_SEND_RESERVE_SIZE_OVER;
+			}
+
+			auto totalSize = (short)(bodySize + m_ReservedHeaderSize);
+			memcpy(&m_SendBuffer[0], &totalSize, sizeof(totalSize));
+
+			++m_SendCount;
+			m_SendBytes += totalSize;
+			return NServerNetLib::NET_ERROR_CODE::NONE;
+		}
+
+		int ClientSessionPoolSize() override { return m_SessionPoolSize; }
+
+		bool EnableCompress(const int sessionIndex) override { return m_CompressMinBodySize > 0; }
+		bool EnableSequence(const int sessionIndex) override { return true; }
+
+		void SetReplySequence(const int sessionIndex, const int requestSeq, const short replyPacketId) override
+		{
+			m_ReplySessionIndex = requestSeq >= 0 ? sessionIndex : -1;
+			m_ReplySeq = requestSeq;
+			m_ReplyPacketId = replyPacketId;
+		}
+
+		void ForcingClose(const int sessionIndex) override { ++m_ForcingCloseCount; }
+
+		void ResetCount()
+		{
+			m_SendCount = 0;
+			m_SendBytes = 0;
+			m_ForcingCloseCount = 0;
+		}
+
+		int64_t SendCount() { return m_SendCount; }
+		int64_t SendBytes() { return m_SendBytes; }
+		int64_t ForcingCloseCount() { return m_ForcingCloseCount; }
+
+	private:
+		int m_SessionPoolSize = 0;
+		std::vector<char> m_SendBuffer;
+		short m_ReservedBodySize = -1;
+		int m_ReservedHeaderSize = 0;
+
+		int m_CompressMinBodySize = 0;
+		int m_ReplySessionIndex = -1;
+		int m_ReplySeq = -1;
+		short m_ReplyPacketId = 0;
+
+		int64_t m_SendCount = 0;
+		int64_t m_SendBytes = 0;
+		int64_t m_ForcingCloseCount = 0;
+	};
+}
@@ -0,0 +1,240 @@
+﻿#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#include "../Common/Packet.h"
+#include "../Common/ErrorCode.h"
+#include "../ServerNetLib/ITcpNetwork.h"
+#include "../ServerNetLib/PacketCapture.h"
+#include "../LogicLib/UserManager.h"
+#include "../LogicLib/LobbyManager.h"
+#include "../LogicLib/PacketProcess.h"
+#include "../LogicLib/TaskScheduler.h"
+#include "../LogicLib/LogicShard.h"
+#include "../LogicLib/ServerMetrics.h"
+#include "../LogicLib/Main.h"
+#include "BenchLog.h"
+#include "MockNetwork.h"
+#include "MicroBench.h"
+
+/*
+서버가 기록한 캡처 파일(CaptureFilePath)을 소켓 없이 로직에 그대로 다시 넣는다.
+서버와 같은 설정 파일을 Main::ReadConfig 로 읽고, LogicShardCount 가 있으면 서버처럼 로직 샤드에 나눠 처리한다.
+--pace=fast 는 최대한 빨리, --pace=recorded 는 기록된 간격대로(--speed 배속) 넣는다.
+매 반복마다 로직 객체를 새로 만들어서 같은 상태에서 시작한다.
+
+사용법: PacketReplay <캡처 파일> [--config=../resources/ServerConfig.ini] [--pace=fast|recorded] [--speed=1.0] [--loop=1] [--json]
+*/
+
+using namespace NLogicLib;
+using namespace NBench;
+using CaptureRecord = NServerNetLib::PacketCaptureReader::Record;
+
+namespace
+{
+	struct ReplayOption
+	{
+		std::string CaptureFilePath;
+		std::string ConfigPath = "../resources/ServerConfig.ini";
+		bool IsRecordedPace = false;
+		double Speed = 1.0;
+		int LoopCount = 1;
+		bool IsJson = false;
+	};
+
+	struct ReplayResult
+	{
+		int64_t ProcessCount = 0;
+		int64_t SkipCount = 0;
+		int64_t ElapsedNanoSec = 0;
+		int64_t SendCount = 0;
+		int64_t SendBytes = 0;
+	};
+
+	bool ParseOption(int argc, char* argv[], ReplayOption& option)
+	{
+#ifdef _WIN32
+		option.ConfigPath = "../../resources/ServerConfig.ini";
+#endif
+
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			if (arg.compare(0, 2, "--") != 0)
+			{
+				option.CaptureFilePath = arg;
+				continue;
+			}
+
+			auto pos = arg.find('=');
+			auto key = arg.substr(0, pos);
+			auto value = pos == std::string::npos ? std::string() : arg.substr(pos + 1);
+
+			if (key == "--config") option.ConfigPath = value;
+			else if (key == "--pace" && (value == "fast" || value == "recorded")) option.IsRecordedPace = value == "recorded";
+			else if (key == "--speed") option.Speed = atof(value.c_str());
+			else if (key == "--loop") option.LoopCount = atoi(value.c_str());
+			else if (key == "--json") option.IsJson = true;
+			else return false;
+		}
+
+		return option.CaptureFilePath.empty() == false && option.Speed > 0 && option.LoopCount > 0;
+	}
+
+	ReplayResult ReplayOnce(const ReplayOption& option, NServerNetLib::ServerConfig& config, NServerNetLib::PacketCaptureReader& reader, ServerMetrics& metrics)
+	{
+		BenchLog logger;
+		MockNetwork network;
+		auto sessionPoolSize = config.MaxClientCount + config.ExtraClientCount;
+		network.Init(sessionPoolSize, config.CompressMinBodySize);
+
+		UserManager userMgr;
+		userMgr.Init(config.MaxClientCount);
+
+		LobbyManager lobbyMgr;
+		lobbyMgr.Init(Main::MakeLobbyManagerConfig(config), &network, &logger);
+
+		PacketProcess packetProc;
+		packetProc.Init(&network, &userMgr, &lobbyMgr, &config, &logger);
+		packetProc.SetMetrics(&metrics);
+
+		// 서버(Main::CreateModules)와 같은 수의 작업 스레드와 로직 샤드를 쓴다.
+		TaskScheduler scheduler;
+		scheduler.Init(std::max(config.TaskWorkerCount, config.LogicShardCount), &logger);
+		packetProc.SetScheduler(&scheduler);
+
+		LogicShardPool shardPool;
+		shardPool.Init(config.LogicShardCount, &scheduler, &packetProc, &network, &userMgr, &lobbyMgr, &metrics, &logger);
+
+		ReplayResult result;
+		reader.Rewind();
+
+		auto startTime = NowNanoSec();
+		int64_t prevRecordTime = 0;
+
+		// 로비 타이머는 기록된 시간으로 돌린다. 로비를 만들 때 잡은 시간 뒤로 이어지도록 지금 시간에 더한다.
+		auto baseMilliSec = startTime / 1000000;
+
+		CaptureRecord record;
+		while (reader.Next(record))
+		{
+			if (record.SessionIndex >= sessionPoolSize || record.PacketId <= 0 || record.PacketId >= (short)NCommon::PACKET_ID::MAX)
+			{
+				++result.SkipCount;
+				continue;
+			}
+
+			// 기록된 시간이 바뀌었다는 것은 서버 루프가 한 바퀴 돌았다는 뜻이므로 StateCheck 도 같이 부른다.
+			if (record.TimeMicroSec != prevRecordTime)
+			{
+				shardPool.StateCheck(baseMilliSec + record.TimeMicroSec / 1000);
+				prevRecordTime = record.TimeMicroSec;
+
+				if (option.IsRecordedPace)
+				{
+					auto targetTime = startTime + (int64_t)(record.TimeMicroSec * 1000 / option.Speed);
+					auto waitNanoSec = targetTime - NowNanoSec();
+					if (waitNanoSec > 0) {
+						std::this_thread::sleep_for(std::chrono::nanoseconds(waitNanoSec));
+					}
+				}
+			}
+
+			NServerNetLib::RecvPacketInfo packetInfo;
+			packetInfo.SessionIndex = record.SessionIndex;
+			packetInfo.PacketId = record.PacketId;
+			packetInfo.PacketBodySize = record.BodySize;
+			packetInfo.pRefData = record.pBody;
+			packetInfo.RequestSeq = record.RequestSeq;
+
+			shardPool.Process(packetInfo);
+			++result.ProcessCount;
+		}
+
+		// 샤드에 남은 패킷까지 처리한다.
+		shardPool.StateCheck(baseMilliSec + prevRecordTime / 1000);
+
+		result.ElapsedNanoSec = NowNanoSec() - startTime;
+		result.SendCount = network.SendCount();
+		result.SendBytes = network.SendBytes();
+		return result;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	ReplayOption option;
+	if (ParseOption(argc, argv, option) == false)
+	{
+		fprintf(stderr, "usage: %s <capture file> [--config=path] [--pace=fast|recorded] [--speed=1.0] [--loop=N] [--json]\n", argv[0]);
+		return 1;
+	}
+
+	NServerNetLib::ServerConfig config;
+	if (Main::ReadConfig(option.ConfigPath.c_str(), config) == false)
+	{
+		fprintf(stderr, "Can't load %s\n", option.ConfigPath.c_str());
+		return 1;
+	}
+
+	NServerNetLib::PacketCaptureReader reader;
+	if (reader.Load(option.CaptureFilePath.c_str()) == false)
+	{
+		fprintf(stderr, "Can't load capture %s\n", option.CaptureFilePath.c_str());
+		return 1;
+	}
+
+	auto metrics = std::make_unique<ServerMetrics>();
+	metrics->Init(config.MaxLobbyCount);
+
+	ReplayResult total;
+	for (int loop = 0; loop < option.LoopCount; ++loop)
+	{
+		auto result = ReplayOnce(option, config, reader, *metrics);
+		total.ProcessCount += result.ProcessCount;
+		total.SkipCount += result.SkipCount;
+		total.ElapsedNanoSec += result.ElapsedNanoSec;
+		total.SendCount += result.SendCount;
+		total.SendBytes += result.SendBytes;
+	}
+
+	auto elapsedSec = (double)total.ElapsedNanoSec / 1000000000.0;
+	auto processCount = total.ProcessCount > 0 ? total.ProcessCount : 1;
+
+	if (option.IsJson)
+	{
+		printf("{\"bench\":\"replay\",\"pace\":\"%s\",\"loops\":%d,\"packets\":%lld,\"skipped\":%lld,\"elapsed_sec\":%.3f,"
+			"\"packets_per_sec\":%.1f,\"ns_per_packet\":%.1f,\"sends\":%lld,\"send_bytes\":%lld}\n",
+			option.IsRecordedPace ? "recorded" : "fast", option.LoopCount, (long long)total.ProcessCount, (long long)total.SkipCount, elapsedSec,
+			total.ProcessCount / elapsedSec, (double)total.ElapsedNanoSec / processCount, (long long)total.SendCount, (long long)total.SendBytes);
+	}
+	else
+	{
+		printf("packets %lld (skipped %lld), %.3f sec, %.1f packets/s, %.1f ns/packet, sends %lld (%lld bytes)\n\n",
+			(long long)total.ProcessCount, (long long)total.SkipCount, elapsedSec,
+			total.ProcessCount / elapsedSec, (double)total.ElapsedNanoSec / processCount, (long long)total.SendCount, (long long)total.SendBytes);
+		printf("%-10s %12s %14s\n", "PACKET_ID", "count", "avg ns");
+	}
+
+	for (int packetId = 0; packetId < MAX_PACKET_METRIC_COUNT; ++packetId)
+	{
+		auto& packetMetric = metrics->GetPacketMetric(packetId);
+		auto count = packetMetric.Count.load();
+		if (count == 0) {
+			continue;
+		}
+
+		auto avgNanoSec = (double)packetMetric.TotalNanoSec.load() / count;
+		if (option.IsJson) {
+			printf("{\"bench\":\"replay_packet\",\"packet_id\":%d,\"count\":%lld,\"avg_ns\":%.1f}\n", packetId, (long long)count, avgNanoSec);
+		}
+		else {
+			printf("%-10d %12lld %14.1f\n", packetId, (long long)count, avgNanoSec);
+		}
+	}
+
+	return 0;
+}
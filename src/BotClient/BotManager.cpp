@@ -0,0 +1,563 @@
+﻿#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <algorithm>
+
+#include "BotManager.h"
+
+using PACKET_ID = NCommon::PACKET_ID;
+using ERROR_CODE = NCommon::ERROR_CODE;
+
+namespace NBotClient
+{
+	namespace
+	{
+		const char* PacketName(const short packetId)
+		{
+			switch ((PACKET_ID)packetId)
+			{
+			case PACKET_ID::LOGIN_IN_REQ: return "LOGIN_IN_REQ";
+			case PACKET_ID::LOBBY_LIST_REQ: return "LOBBY_LIST_REQ";
+			case PACKET_ID::LOBBY_ENTER_REQ: return "LOBBY_ENTER_REQ";
+			case PACKET_ID::LOBBY_LEAVE_REQ: return "LOBBY_LEAVE_REQ";
+			case PACKET_ID::ROOM_ENTER_REQ: return "ROOM_ENTER_REQ";
+			case PACKET_ID::ROOM_LEAVE_REQ: return "ROOM_LEAVE_REQ";
+			case PACKET_ID::ROOM_CHAT_REQ: return "ROOM_CHAT_REQ";
+			case PACKET_ID::LOBBY_CHAT_REQ: return "LOBBY_CHAT_REQ";
+			case PACKET_ID::ROOM_MASTER_GAME_START_REQ: return "ROOM_MASTER_GAME_START_REQ";
+			case PACKET_ID::ROOM_GAME_START_REQ: return "ROOM_GAME_START_REQ";
+			case PACKET_ID::ROOM_QUICK_MATCH_REQ: return "ROOM_QUICK_MATCH_REQ";
+			case PACKET_ID::ROOM_QUICK_MATCH_NTF: return "ROOM_QUICK_MATCH_NTF";
+			case PACKET_ID::DEV_ECHO_REQ: return "DEV_ECHO_REQ";
+			default: return "UNKNOWN";
+			}
+		}
+
+		enum LOBBY_ACTION { LOBBY_ACTION_ROOM_CREATE, LOBBY_ACTION_ROOM_JOIN, LOBBY_ACTION_ROOM_QUICK_MATCH, LOBBY_ACTION_LOBBY_CHAT, LOBBY_ACTION_LOBBY_LEAVE, LOBBY_ACTION_LOGOUT, LOBBY_ACTION_COUNT };
+		enum ROOM_ACTION { ROOM_ACTION_ROOM_CHAT, ROOM_ACTION_ROOM_LEAVE, ROOM_ACTION_LOGOUT, ROOM_ACTION_COUNT };
+
+		const char* BOT_CHAT_MSG = "hello from bot";
+		const int RECONNECT_DELAY_MILLISEC = 1000;
+	}
+
+	BotManager::BotManager() : m_Random(std::random_device{}()) {}
+
+	BotManager::~BotManager() {}
+
+	bool BotManager::Init(const BotConfig& config)
+	{
+		m_Config = config;
+
+		if (m_Engine.Init(config.BotCount, 64 * 1024, 16 * 1024, this) == false) {
+			return false;
+		}
+
+		m_Latency.Init((int)PACKET_ID::MAX);
+
+		m_BotList.resize(config.BotCount);
+		for (int i = 0; i < config.BotCount; ++i)
+		{
+			auto& bot = m_BotList[i];
+			bot.Index = i;
+			snprintf(bot.ID, sizeof(bot.ID), "bot%d", config.StartBotIndex + i);
+		}
+
+		return true;
+	}
+
+	void BotManager::Run()
+	{
+		m_StartTime = NowMicroSec();
+		auto endTime = m_StartTime + (int64_t)m_Config.DurationSec * 1000000;
+		auto nextReportTime = m_StartTime + (int64_t)m_Config.ReportIntervalSec * 1000000;
+		auto lastTickTime = m_StartTime;
+
+		int64_t prevRequestCount = 0;
+		int64_t prevResponseCount = 0;
+
+		while (true)
+		{
+			m_Engine.Poll(1);
+
+			auto curTime = NowMicroSec();
+			if (curTime >= endTime) {
+				break;
+			}
+
+			// 접속은 초당 ConnectPerSec 개까지만 시도한다.
+			m_ConnectTokens += (double)(curTime - lastTickTime) * m_Config.ConnectPerSec / 1000000.0;
+			if (m_ConnectTokens > m_Config.ConnectPerSec) {
+				m_ConnectTokens = m_Config.ConnectPerSec;
+			}
+			lastTickTime = curTime;
+
+			Tick(curTime);
+
+			if (m_Config.ReportIntervalSec > 0 && curTime >= nextReportTime)
+			{
+				auto elapsedSec = (double)(curTime - m_StartTime) / 1000000.0;
+				printf("[%6.1fs] login %d, req/s %lld, res/s %lld, ntf total %lld\n", elapsedSec, m_LoginCount,
+					(long long)((m_RequestCount - prevRequestCount) / m_Config.ReportIntervalSec),
+					(long long)((m_ResponseCount - prevResponseCount) / m_Config.ReportIntervalSec),
+					(long long)m_NotifyCount);
+
+				prevRequestCount = m_RequestCount;
+				prevResponseCount = m_ResponseCount;
+				nextReportTime += (int64_t)m_Config.ReportIntervalSec * 1000000;
+			}
+		}
+
+		m_EndTime = NowMicroSec();
+		m_Engine.Release();
+	}
+
+	void BotManager::PrintReport()
+	{
+		auto elapsedSec = (double)(m_EndTime - m_StartTime) / 1000000.0;
+
+		printf("\n== Bot Report ==\n");
+		printf("bots %d, duration %.1fs, request %lld, response %lld, notify %lld\n",
+			m_Config.BotCount, elapsedSec, (long long)m_RequestCount, (long long)m_ResponseCount, (long long)m_NotifyCount);
+		printf("throughput: %.1f req/s, %.1f res/s\n", m_RequestCount / elapsedSec, m_ResponseCount / elapsedSec);
+		if (m_Config.IsSequence) {
+			printf("sequence: pipeline depth %d, mismatch %lld\n", m_Config.PipelineDepth, (long long)m_SeqMismatchCount);
+		}
+		printf("\n");
+
+		printf("%-28s %10s %8s %8s %10s %8s %8s %8s %8s %8s\n", "PACKET_ID", "count", "error", "timeout", "avg(us)", "p50", "p90", "p99", "p999", "max");
+		for (short packetId = 0; packetId < (short)PACKET_ID::MAX; ++packetId)
+		{
+			if (m_Latency.HasData(packetId) == false) {
+				continue;
+			}
+
+			auto summary = m_Latency.GetSummary(packetId);
+			printf("%-28s %10lld %8lld %8lld %10.1f %8lld %8lld %8lld %8lld %8lld\n", PacketName(packetId),
+				(long long)summary.Count, (long long)summary.ErrorCount, (long long)summary.TimeoutCount, summary.AvgMicroSec,
+				(long long)summary.P50MicroSec, (long long)summary.P90MicroSec, (long long)summary.P99MicroSec,
+				(long long)summary.P999MicroSec, (long long)summary.MaxMicroSec);
+		}
+	}
+
+	void BotManager::Tick(const int64_t curTime)
+	{
+		auto timeout = (int64_t)m_Config.RequestTimeoutMilliSec * 1000;
+
+		for (auto& bot : m_BotList)
+		{
+			if (bot.WaitResId != 0)
+			{
+				if (curTime - bot.ReqSendTime > timeout)
+				{
+					m_Latency.RecordTimeout(bot.WaitReqId);
+					Disconnect(bot, RECONNECT_DELAY_MILLISEC);
+				}
+				continue;
+			}
+
+			// 들어갈 룸이 없으면 서버는 대기열에 계속 넣어 두므로, 배정 통보가 오지 않으면 시간 초과로 세고 다시 접속한다.
+			if (bot.State == BOT_STATE::MATCHING)
+			{
+				if (curTime - bot.MatchStartTime > timeout)
+				{
+					m_Latency.RecordTimeout((short)PACKET_ID::ROOM_QUICK_MATCH_NTF);
+					Disconnect(bot, RECONNECT_DELAY_MILLISEC);
+				}
+				continue;
+			}
+
+			if (curTime < bot.NextActionTime) {
+				continue;
+			}
+
+			switch (bot.State)
+			{
+			case BOT_STATE::DISCONNECTED:
+				if (m_ConnectTokens < 1.0) {
+					break;
+				}
+
+				m_ConnectTokens -= 1.0;
+				if (m_Engine.Connect(bot.Index, m_Config.ServerIP, m_Config.Port)) {
+					bot.State = BOT_STATE::CONNECTING;
+				}
+				else {
+					bot.NextActionTime = curTime + RECONNECT_DELAY_MILLISEC * 1000;
+				}
+				break;
+
+			case BOT_STATE::LOGIN:
+			{
+				NCommon::PktLobbyListReq reqPkt;
+				reqPkt.Version = bot.LobbyListVersion;
+				SendRequest(bot, PACKET_ID::LOBBY_LIST_REQ, sizeof(reqPkt), (char*)&reqPkt);
+				break;
+			}
+
+			case BOT_STATE::LOBBY:
+				DoLobbyAction(bot);
+				break;
+
+			case BOT_STATE::ROOM:
+				DoRoomAction(bot);
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	void BotManager::DoLobbyAction(Bot& bot)
+	{
+		int weights[LOBBY_ACTION_COUNT] = { m_Config.WeightRoomCreate, m_Config.WeightRoomJoin, m_Config.WeightRoomQuickMatch, m_Config.WeightLobbyChat, m_Config.WeightLobbyLeave, m_Config.WeightLogout };
+
+		auto action = PickWeighted(weights, LOBBY_ACTION_COUNT);
+		switch (action)
+		{
+		case LOBBY_ACTION_ROOM_CREATE:
+		case LOBBY_ACTION_ROOM_JOIN:
+		{
+			// 제목은 쓴 바이트 만큼만 보낸다.
+			NCommon::PktRoomEnterReq reqPkt;
+			reqPkt.IsCreate = action == LOBBY_ACTION_ROOM_CREATE;
+			reqPkt.RoomIndex = (reqPkt.IsCreate == false && bot.MaxRoomCount > 0) ? (short)(m_Random() % bot.MaxRoomCount) : 0;
+
+			char title[NCommon::MAX_ROOM_TITLE_SIZE + 1];
+			snprintf(title, sizeof(title), "room %d", bot.Index);
+			reqPkt.RoomTitleLength = NCommon::CopyUtf8(reqPkt.RoomTitle, NCommon::MAX_ROOM_TITLE_SIZE, title);
+
+			auto bodySize = (short)(sizeof(reqPkt) - NCommon::MAX_ROOM_TITLE_SIZE + reqPkt.RoomTitleLength);
+			SendRequest(bot, PACKET_ID::ROOM_ENTER_REQ, bodySize, (char*)&reqPkt);
+			break;
+		}
+
+		case LOBBY_ACTION_ROOM_QUICK_MATCH:
+			SendRequest(bot, PACKET_ID::ROOM_QUICK_MATCH_REQ, 0, nullptr);
+			break;
+
+		case LOBBY_ACTION_LOBBY_CHAT:
+		{
+			// 사용한 바이트 수 만큼만 보낸다.
+			NCommon::PktLobbyChatReq reqPkt;
+			reqPkt.MsgLength = NCommon::CopyUtf8(reqPkt.Msg, NCommon::MAX_LOBBY_CHAT_MSG_SIZE, BOT_CHAT_MSG);
+			auto bodySize = (short)(sizeof(reqPkt) - NCommon::MAX_LOBBY_CHAT_MSG_SIZE + reqPkt.MsgLength);
+			SendRequest(bot, PACKET_ID::LOBBY_CHAT_REQ, bodySize, (char*)&reqPkt);
+			break;
+		}
+
+		case LOBBY_ACTION_LOBBY_LEAVE:
+			SendRequest(bot, PACKET_ID::LOBBY_LEAVE_REQ, 0, nullptr);
+			break;
+
+		case LOBBY_ACTION_LOGOUT:
+			Disconnect(bot, m_Config.ThinkTimeMilliSec);
+			break;
+
+		default:
+			ScheduleNextAction(bot);
+			break;
+		}
+	}
+
+	void BotManager::DoRoomAction(Bot& bot)
+	{
+		int weights[ROOM_ACTION_COUNT] = { m_Config.WeightRoomChat, m_Config.WeightRoomLeave, m_Config.WeightLogout };
+
+		switch (PickWeighted(weights, ROOM_ACTION_COUNT))
+		{
+		case ROOM_ACTION_ROOM_CHAT:
+		{
+			NCommon::PktRoomChatReq reqPkt;
+			reqPkt.MsgLength = NCommon::CopyUtf8(reqPkt.Msg, NCommon::MAX_ROOM_CHAT_MSG_SIZE, BOT_CHAT_MSG);
+			auto bodySize = (short)(sizeof(reqPkt) - NCommon::MAX_ROOM_CHAT_MSG_SIZE + reqPkt.MsgLength);
+
+			// 요청 순번을 쓰면 채팅은 방 상태를 바꾸지 않으므로 응답을 기다리지 않고 이어서 보낸다.
+			auto depth = bot.IsSequence ? std::min(std::max(m_Config.PipelineDepth, 1), MAX_PIPELINE_DEPTH) : 1;
+			for (int i = 0; i < depth && bot.State == BOT_STATE::ROOM; ++i) {
+				SendRequest(bot, PACKET_ID::ROOM_CHAT_REQ, bodySize, (char*)&reqPkt);
+			}
+			break;
+		}
+
+		case ROOM_ACTION_ROOM_LEAVE:
+			SendRequest(bot, PACKET_ID::ROOM_LEAVE_REQ, 0, nullptr);
+			break;
+
+		case ROOM_ACTION_LOGOUT:
+			Disconnect(bot, m_Config.ThinkTimeMilliSec);
+			break;
+
+		default:
+			ScheduleNextAction(bot);
+			break;
+		}
+	}
+
+	void BotManager::SendRequest(Bot& bot, const PACKET_ID packetId, const short bodySize, const char* pBody)
+	{
+		auto requestSeq = bot.IsSequence ? (int)bot.NextSeq : -1;
+		if (m_Engine.Send(bot.Index, (short)packetId, bodySize, pBody, requestSeq) == false)
+		{
+			Disconnect(bot, RECONNECT_DELAY_MILLISEC);
+			return;
+		}
+
+		auto curTime = NowMicroSec();
+		if (bot.PendingCount == 0) {
+			bot.ReqSendTime = curTime;
+		}
+		bot.PendingSendTime[bot.NextSeq % MAX_PIPELINE_DEPTH] = curTime;
+		++bot.NextSeq;
+		++bot.PendingCount;
+
+		// 모든 요청은 REQ + 1 이 RES 이다. 이어서 보내는 요청은 모두 같은 종류이다.
+		bot.WaitReqId = (short)packetId;
+		bot.WaitResId = (short)packetId + 1;
+		++m_RequestCount;
+	}
+
+	void BotManager::OnConnect(const int connIndex, const bool isSuccess)
+	{
+		auto& bot = m_BotList[connIndex];
+		if (isSuccess == false)
+		{
+			bot.State = BOT_STATE::DISCONNECTED;
+			bot.NextActionTime = NowMicroSec() + RECONNECT_DELAY_MILLISEC * 1000;
+			return;
+		}
+
+		NCommon::PktLogInReq reqPkt;
+		memcpy(reqPkt.szID, bot.ID, sizeof(reqPkt.szID));
+		memcpy(reqPkt.szPW, "bot", 4);
+		if (m_Config.IsCompress) {
+			reqPkt.Flags |= NCommon::LOGIN_FLAG_COMPRESS;
+		}
+		if (m_Config.IsSequence) {
+			reqPkt.Flags |= NCommon::LOGIN_FLAG_SEQUENCE;
+		}
+		SendRequest(bot, PACKET_ID::LOGIN_IN_REQ, sizeof(reqPkt), (char*)&reqPkt);
+	}
+
+	void BotManager::OnPacket(const int connIndex, const short packetId, const char* pBody, const short bodySize, const int requestSeq)
+	{
+		auto& bot = m_BotList[connIndex];
+
+		if (packetId != bot.WaitResId)
+		{
+			++m_NotifyCount;
+
+			// 빠른 입장은 요청부터 배정 통보까지를 따로 잰다.
+			if (packetId == (short)PACKET_ID::ROOM_QUICK_MATCH_NTF && bot.State == BOT_STATE::MATCHING)
+			{
+				m_Latency.Record(packetId, NowMicroSec() - bot.MatchStartTime);
+				bot.State = BOT_STATE::ROOM;
+				ScheduleNextAction(bot);
+			}
+			return;
+		}
+
+		// 서버는 받은 순서대로 처리하므로 응답은 가장 먼저 보낸 요청의 것이다.
+		auto oldestSeq = (uint16_t)(bot.NextSeq - bot.PendingCount);
+		if (requestSeq >= 0 && requestSeq != oldestSeq) {
+			++m_SeqMismatchCount;
+		}
+
+		auto curTime = NowMicroSec();
+		m_Latency.Record(bot.WaitReqId, curTime - bot.PendingSendTime[oldestSeq % MAX_PIPELINE_DEPTH]);
+		++m_ResponseCount;
+
+		short errorCode = 0;
+		if (bodySize >= (short)sizeof(short)) {
+			memcpy(&errorCode, pBody, sizeof(short));
+		}
+
+		if (errorCode != (short)ERROR_CODE::NONE) {
+			m_Latency.RecordError(packetId - 1);
+		}
+
+		// 이어서 보낸 요청의 응답이 남아 있으면 마지막 응답을 받을 때 다음 행동을 한다.
+		--bot.PendingCount;
+		if (bot.PendingCount > 0)
+		{
+			bot.ReqSendTime = bot.PendingSendTime[(uint16_t)(oldestSeq + 1) % MAX_PIPELINE_DEPTH];
+			return;
+		}
+
+		bot.WaitReqId = 0;
+		bot.WaitResId = 0;
+
+		OnResponse(bot, packetId, errorCode, pBody, bodySize);
+	}
+
+	void BotManager::OnResponse(Bot& bot, const short packetId, const short errorCode, const char* pBody, const short bodySize)
+	{
+		auto isSuccess = errorCode == (short)ERROR_CODE::NONE;
+
+		switch ((PACKET_ID)packetId)
+		{
+		case PACKET_ID::LOGIN_IN_RES:
+			if (isSuccess == false)
+			{
+				Disconnect(bot, RECONNECT_DELAY_MILLISEC);
+				return;
+			}
+			bot.State = BOT_STATE::LOGIN;
+			++m_LoginCount;
+
+			// 예전 서버는 Flags 없이 응답한다.
+			if (bodySize >= (short)sizeof(NCommon::PktLogInRes)) {
+				bot.IsSequence = (((NCommon::PktLogInRes*)pBody)->Flags & NCommon::LOGIN_FLAG_SEQUENCE) != 0;
+			}
+			break;
+
+		case PACKET_ID::LOBBY_LIST_RES:
+		{
+			auto listHeaderSize = (short)(sizeof(NCommon::PktLobbyListRes) - sizeof(NCommon::PktLobbyListRes::LobbyList));
+			if (isSuccess == false || bodySize < listHeaderSize) {
+				break;
+			}
+
+			auto pResPkt = (NCommon::PktLobbyListRes*)pBody;
+			if (pResPkt->IsNotModified == false)
+			{
+				auto lobbyCount = std::min<short>(pResPkt->LobbyCount, (short)((bodySize - listHeaderSize) / sizeof(NCommon::LobbyListInfo)));
+				bot.LobbyListVersion = pResPkt->Version;
+				bot.LobbyCount = lobbyCount > 0 ? lobbyCount : 0;
+				memcpy(bot.LobbyList, pResPkt->LobbyList, sizeof(NCommon::LobbyListInfo) * bot.LobbyCount);
+			}
+
+			if (bot.LobbyCount <= 0) {
+				break;
+			}
+
+			// 자리가 있는 로비 중에서 아무 곳이나 들어간다. 대기 없이 바로 요청한다.
+			NCommon::PktLobbyEnterReq reqPkt;
+			auto startIndex = (int)(m_Random() % bot.LobbyCount);
+			reqPkt.LobbyId = bot.LobbyList[startIndex].LobbyId;
+			for (int i = 0; i < bot.LobbyCount; ++i)
+			{
+				auto& lobby = bot.LobbyList[(startIndex + i) % bot.LobbyCount];
+				if (lobby.LobbyUserCount < lobby.LobbyMaxUserCount)
+				{
+					reqPkt.LobbyId = lobby.LobbyId;
+					break;
+				}
+			}
+
+			bot.LobbyId = reqPkt.LobbyId;
+			SendRequest(bot, PACKET_ID::LOBBY_ENTER_REQ, sizeof(reqPkt), (char*)&reqPkt);
+			return;
+		}
+
+		case PACKET_ID::LOBBY_ENTER_RES:
+			if (isSuccess)
+			{
+				auto pResPkt = (NCommon::PktLobbyEnterRes*)pBody;
+				bot.MaxRoomCount = pResPkt->MaxRoomCount;
+				bot.State = BOT_STATE::LOBBY;
+			}
+			break;
+
+		case PACKET_ID::LOBBY_LEAVE_RES:
+			if (isSuccess) {
+				bot.State = BOT_STATE::LOGIN;
+			}
+			break;
+
+		case PACKET_ID::ROOM_ENTER_RES:
+			if (isSuccess) {
+				bot.State = BOT_STATE::ROOM;
+			}
+			break;
+
+		case PACKET_ID::ROOM_LEAVE_RES:
+			if (isSuccess) {
+				bot.State = BOT_STATE::LOBBY;
+			}
+			break;
+
+		case PACKET_ID::ROOM_QUICK_MATCH_RES:
+			if (isSuccess)
+			{
+				bot.State = BOT_STATE::MATCHING;
+				bot.MatchStartTime = bot.ReqSendTime;
+				return;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		ScheduleNextAction(bot);
+	}
+
+	void BotManager::OnClose(const int connIndex)
+	{
+		auto& bot = m_BotList[connIndex];
+		if (bot.State >= BOT_STATE::LOGIN) {
+			--m_LoginCount;
+		}
+
+		bot.State = BOT_STATE::DISCONNECTED;
+		ClearWait(bot);
+		bot.NextActionTime = NowMicroSec() + RECONNECT_DELAY_MILLISEC * 1000;
+	}
+
+	void BotManager::Disconnect(Bot& bot, const int64_t retryAfterMilliSec)
+	{
+		if (bot.State >= BOT_STATE::LOGIN) {
+			--m_LoginCount;
+		}
+
+		m_Engine.Close(bot.Index);
+
+		bot.State = BOT_STATE::DISCONNECTED;
+		ClearWait(bot);
+		bot.NextActionTime = NowMicroSec() + retryAfterMilliSec * 1000;
+	}
+
+	void BotManager::ClearWait(Bot& bot)
+	{
+		bot.WaitReqId = 0;
+		bot.WaitResId = 0;
+		bot.PendingCount = 0;
+		bot.IsSequence = false;
+	}
+
+	void BotManager::ScheduleNextAction(Bot& bot)
+	{
+		// 모든 봇이 같은 박자로 움직이지 않도록 생각 시간을 0.5 ~ 1.5 배로 흔든다.
+		auto thinkTime = (int64_t)m_Config.ThinkTimeMilliSec * 1000;
+		auto jitter = thinkTime > 0 ? (int64_t)(m_Random() % (uint32_t)thinkTime) : 0;
+		bot.NextActionTime = NowMicroSec() + thinkTime / 2 + jitter;
+	}
+
+	int BotManager::PickWeighted(const int* pWeights, const int count)
+	{
+		int total = 0;
+		for (int i = 0; i < count; ++i) {
+			total += pWeights[i];
+		}
+
+		if (total <= 0) {
+			return -1;
+		}
+
+		auto pick = (int)(m_Random() % (uint32_t)total);
+		for (int i = 0; i < count; ++i)
+		{
+			if (pick < pWeights[i]) {
+				return i;
+			}
+			pick -= pWeights[i];
+		}
+		return count - 1;
+	}
+
+	int64_t BotManager::NowMicroSec()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
@@ -0,0 +1,127 @@
+﻿#pragma once
+
+#include <vector>
+#include <random>
+#include <stdint.h>
+
+#include "../Common/Packet.h"
+#include "ClientEngine.h"
+#include "LatencyRecorder.h"
+
+namespace NBotClient
+{
+	struct BotConfig
+	{
+		char ServerIP[32] = { 0, };
+		unsigned short Port = 0;
+
+		int BotCount = 0;
+		int StartBotIndex = 0; // 여러 프로세스로 돌릴 때 ID가 겹치지 않게 한다.
+		int ConnectPerSec = 0;
+		int DurationSec = 0;
+		int ThinkTimeMilliSec = 0; // 응답을 받은 후 다음 행동까지 기다리는 평균 시간
+		int RequestTimeoutMilliSec = 0;
+		int ReportIntervalSec = 0;
+		bool IsCompress = false; // 로그인할 때 서버에 압축을 요청한다.
+		bool IsSequence = false; // 로그인할 때 요청 순번을 쓰겠다고 알린다.
+		int PipelineDepth = 1; // 요청 순번을 쓸 때 방 채팅을 응답을 기다리지 않고 몇 개까지 이어서 보낼지
+
+		// 시나리오 가중치. 로비에 있을 때와 방에 있을 때 각각 해당하는 행동 중에서 고른다.
+		int WeightRoomCreate = 0;
+		int WeightRoomJoin = 0;
+		int WeightRoomQuickMatch = 0;
+		int WeightRoomChat = 0;
+		int WeightRoomLeave = 0;
+		int WeightLobbyChat = 0;
+		int WeightLobbyLeave = 0;
+		int WeightLogout = 0;
+	};
+
+	const int MAX_PIPELINE_DEPTH = 64;
+
+	enum class BOT_STATE : short
+	{
+		DISCONNECTED = 0,
+		CONNECTING = 1,
+		LOGIN = 2,
+		LOBBY = 3,
+		ROOM = 4,
+		MATCHING = 5, // 빠른 입장 대기열에 들어가서 배정 통보를 기다리는 중
+	};
+
+	struct Bot
+	{
+		int Index = 0;
+		BOT_STATE State = BOT_STATE::DISCONNECTED;
+		char ID[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+
+		short LobbyId = -1;
+		short MaxRoomCount = 0;
+
+		// 마지막으로 받은 로비 목록. 서버가 바뀌지 않았다고 하면 이것을 쓴다.
+		int LobbyListVersion = 0;
+		short LobbyCount = 0;
+		NCommon::LobbyListInfo LobbyList[NCommon::MAX_LOBBY_LIST_COUNT];
+
+		int64_t NextActionTime = 0;
+
+		short WaitReqId = 0;
+		short WaitResId = 0;
+		int64_t ReqSendTime = 0; // 응답을 기다리는 요청 중 가장 먼저 보낸 것의 시간
+
+		// 요청 순번. 서버가 받아 주면 응답을 기다리지 않고 요청을 이어서 보낼 수 있다.
+		bool IsSequence = false;
+		uint16_t NextSeq = 0;
+		short PendingCount = 0;
+		int64_t PendingSendTime[MAX_PIPELINE_DEPTH] = { 0, };
+		int64_t MatchStartTime = 0;
+	};
+
+	class BotManager : public IClientHandler
+	{
+	public:
+		BotManager();
+		virtual ~BotManager();
+
+		bool Init(const BotConfig& config);
+		void Run();
+		void PrintReport();
+
+	public:
+		void OnConnect(const int connIndex, const bool isSuccess) override;
+		void OnPacket(const int connIndex, const short packetId, const char* pBody, const short bodySize, const int requestSeq) override;
+		void OnClose(const int connIndex) override;
+
+	private:
+		void Tick(const int64_t curTime);
+		void DoLobbyAction(Bot& bot);
+		void DoRoomAction(Bot& bot);
+
+		void SendRequest(Bot& bot, const NCommon::PACKET_ID packetId, const short bodySize, const char* pBody);
+		void OnResponse(Bot& bot, const short packetId, const short errorCode, const char* pBody, const short bodySize);
+		void Disconnect(Bot& bot, const int64_t retryAfterMilliSec);
+		void ClearWait(Bot& bot);
+		void ScheduleNextAction(Bot& bot);
+
+		int PickWeighted(const int* pWeights, const int count);
+		int64_t NowMicroSec();
+
+	private:
+		BotConfig m_Config;
+		ClientEngine m_Engine;
+		LatencyRecorder m_Latency;
+
+		std::vector<Bot> m_BotList;
+		std::mt19937 m_Random;
+
+		int64_t m_StartTime = 0;
+		int64_t m_EndTime = 0;
+		double m_ConnectTokens = 0;
+
+		int64_t m_RequestCount = 0;
+		int64_t m_ResponseCount = 0;
+		int64_t m_NotifyCount = 0;
+		int64_t m_SeqMismatchCount = 0;
+		int m_LoginCount = 0;
+	};
+}
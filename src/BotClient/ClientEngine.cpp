@@ -0,0 +1,357 @@
+﻿#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "../Common/Packet.h"
+#include "../ServerNetLib/LZCodec.h"
+#include "ClientEngine.h"
+
+namespace NBotClient
+{
+	const int PACKET_HEADER_SIZE = sizeof(NCommon::PktHeader);
+	const int MAX_EPOLL_EVENT_COUNT = 256;
+
+	ClientEngine::ClientEngine() {}
+
+	ClientEngine::~ClientEngine()
+	{
+		Release();
+	}
+
+	bool ClientEngine::Init(const int maxConnectionCount, const int recvBufferSize, const int sendBufferSize, IClientHandler* pHandler)
+	{
+		m_pHandler = pHandler;
+
+		m_EpollFD = epoll_create1(0);
+		if (m_EpollFD < 0) {
+			return false;
+		}
+
+		m_ConnectionList.resize(maxConnectionCount);
+		for (int i = 0; i < maxConnectionCount; ++i)
+		{
+			auto& conn = m_ConnectionList[i];
+			conn.Index = i;
+			conn.RecvBuffer.resize(recvBufferSize);
+			conn.SendBuffer.resize(sendBufferSize);
+		}
+
+		m_DecompressBuffer.resize(recvBufferSize);
+
+		return true;
+	}
+
+	void ClientEngine::Release()
+	{
+		for (auto& conn : m_ConnectionList)
+		{
+			if (conn.FD >= 0) {
+				CloseConnection(conn, false);
+			}
+		}
+
+		if (m_EpollFD >= 0)
+		{
+			close(m_EpollFD);
+			m_EpollFD = -1;
+		}
+	}
+
+	bool ClientEngine::Connect(const int connIndex, const char* pIP, const unsigned short port)
+	{
+		auto& conn = m_ConnectionList[connIndex];
+		if (conn.State != CONNECTION_STATE::NONE) {
+			return false;
+		}
+
+		auto fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, IPPROTO_TCP);
+		if (fd < 0) {
+			return false;
+		}
+
+		int noDelay = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		inet_pton(AF_INET, pIP, &addr.sin_addr);
+
+		auto ret = connect(fd, (sockaddr*)&addr, sizeof(addr));
+		if (ret < 0 && errno != EINPROGRESS)
+		{
+			close(fd);
+			return false;
+		}
+
+		conn.FD = fd;
+		conn.RecvSize = 0;
+		conn.SendSize = 0;
+		conn.State = CONNECTION_STATE::CONNECTING;
+		conn.IsWaitWritable = true;
+
+		// 연결 완료는 쓰기 가능 이벤트로 알 수 있다.
+		epoll_event ev;
+		ev.events = EPOLLIN | EPOLLOUT;
+		ev.data.u32 = (uint32_t)connIndex;
+		epoll_ctl(m_EpollFD, EPOLL_CTL_ADD, fd, &ev);
+		return true;
+	}
+
+	/*
+	보낼 데이터를 버퍼에 담고 바로 send를 시도한다. 다 못 보낸 나머지는 쓰기 가능 이벤트 때 보낸다.
+	*/
+	bool ClientEngine::Send(const int connIndex, const short packetId, const short bodySize, const char* pBody, const int requestSeq)
+	{
+		auto& conn = m_ConnectionList[connIndex];
+		if (conn.State != CONNECTION_STATE::CONNECTED) {
+			return false;
+		}
+
+		auto headerSize = PACKET_HEADER_SIZE + (requestSeq >= 0 ? NCommon::PACKET_SEQUENCE_SIZE : 0);
+		auto totalSize = (int)bodySize + headerSize;
+		if (conn.SendSize + totalSize > (int)conn.SendBuffer.size()) {
+			return false;
+		}
+
+		NCommon::PktHeader header{ (short)totalSize, packetId, (unsigned char)(requestSeq >= 0 ? NCommon::PACKET_FLAG_SEQUENCE : 0) };
+		memcpy(&conn.SendBuffer[conn.SendSize], &header, PACKET_HEADER_SIZE);
+		if (requestSeq >= 0)
+		{
+			auto seq = (uint16_t)requestSeq;
+			memcpy(&conn.SendBuffer[conn.SendSize + PACKET_HEADER_SIZE], &seq, sizeof(seq));
+		}
+		if (bodySize > 0) {
+			memcpy(&conn.SendBuffer[conn.SendSize + headerSize], pBody, bodySize);
+		}
+		conn.SendSize += totalSize;
+
+		if (conn.IsWaitWritable) {
+			return true;
+		}
+
+		return FlushSend(conn);
+	}
+
+	void ClientEngine::Close(const int connIndex)
+	{
+		auto& conn = m_ConnectionList[connIndex];
+		if (conn.FD < 0) {
+			return;
+		}
+
+		CloseConnection(conn, false);
+	}
+
+	int ClientEngine::Poll(const int timeoutMilliSec)
+	{
+		epoll_event events[MAX_EPOLL_EVENT_COUNT];
+		auto eventCount = epoll_wait(m_EpollFD, events, MAX_EPOLL_EVENT_COUNT, timeoutMilliSec);
+
+		for (int i = 0; i < eventCount; ++i)
+		{
+			auto& conn = m_ConnectionList[events[i].data.u32];
+			if (conn.FD < 0) {
+				continue;
+			}
+
+			if (events[i].events & EPOLLOUT) {
+				OnWritable(conn);
+			}
+
+			if (conn.FD >= 0 && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+				OnReadable(conn);
+			}
+		}
+
+		return eventCount > 0 ? eventCount : 0;
+	}
+
+	void ClientEngine::OnWritable(Connection& conn)
+	{
+		if (conn.State == CONNECTION_STATE::CONNECTING)
+		{
+			int error = 0;
+			socklen_t len = sizeof(error);
+			getsockopt(conn.FD, SOL_SOCKET, SO_ERROR, &error, &len);
+			if (error != 0)
+			{
+				auto connIndex = conn.Index;
+				CloseConnection(conn, false);
+				m_pHandler->OnConnect(connIndex, false);
+				return;
+			}
+
+			conn.State = CONNECTION_STATE::CONNECTED;
+			UpdateWaitWritable(conn, false);
+			m_pHandler->OnConnect(conn.Index, true);
+			return;
+		}
+
+		FlushSend(conn);
+	}
+
+	void ClientEngine::OnReadable(Connection& conn)
+	{
+		if (conn.State == CONNECTION_STATE::CONNECTING)
+		{
+			// 연결 실패는 EPOLLERR 로 온다.
+			OnWritable(conn);
+			return;
+		}
+
+		while (true)
+		{
+			auto space = (int)conn.RecvBuffer.size() - conn.RecvSize;
+			auto recvSize = recv(conn.FD, &conn.RecvBuffer[conn.RecvSize], space, 0);
+			if (recvSize == 0)
+			{
+				CloseConnection(conn, true);
+				return;
+			}
+
+			if (recvSize < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					break;
+				}
+
+				CloseConnection(conn, true);
+				return;
+			}
+
+			conn.RecvSize += (int)recvSize;
+
+			auto readPos = 0;
+			while (conn.RecvSize - readPos >= PACKET_HEADER_SIZE)
+			{
+				auto pHeader = (NCommon::PktHeader*)&conn.RecvBuffer[readPos];
+				if (pHeader->TotalSize < PACKET_HEADER_SIZE || pHeader->TotalSize > (int)conn.RecvBuffer.size())
+				{
+					CloseConnection(conn, true);
+					return;
+				}
+
+				if (conn.RecvSize - readPos < pHeader->TotalSize) {
+					break;
+				}
+
+				auto connIndex = conn.Index;
+				auto pBody = &conn.RecvBuffer[readPos + PACKET_HEADER_SIZE];
+				auto bodySize = pHeader->TotalSize - PACKET_HEADER_SIZE;
+
+				auto requestSeq = -1;
+				if (pHeader->Reserve & NCommon::PACKET_FLAG_SEQUENCE)
+				{
+					if (bodySize < NCommon::PACKET_SEQUENCE_SIZE)
+					{
+						CloseConnection(conn, true);
+						return;
+					}
+
+					uint16_t seq;
+					memcpy(&seq, pBody, sizeof(seq));
+					requestSeq = seq;
+					pBody += NCommon::PACKET_SEQUENCE_SIZE;
+					bodySize -= NCommon::PACKET_SEQUENCE_SIZE;
+				}
+
+				if (pHeader->Reserve & NCommon::PACKET_FLAG_COMPRESSED)
+				{
+					bodySize = NServerNetLib::LZDecompress(pBody, bodySize, &m_DecompressBuffer[0], (int)m_DecompressBuffer.size());
+					if (bodySize < 0)
+					{
+						CloseConnection(conn, true);
+						return;
+					}
+					pBody = &m_DecompressBuffer[0];
+				}
+
+				m_pHandler->OnPacket(connIndex, pHeader->Id, pBody, (short)bodySize, requestSeq);
+
+				// 핸들러 안에서 접속을 끊었을 수 있다.
+				if (conn.FD < 0) {
+					return;
+				}
+
+				readPos += pHeader->TotalSize;
+			}
+
+			if (readPos > 0)
+			{
+				memmove(&conn.RecvBuffer[0], &conn.RecvBuffer[readPos], conn.RecvSize - readPos);
+				conn.RecvSize -= readPos;
+			}
+
+			if (recvSize < space) {
+				break;
+			}
+		}
+	}
+
+	bool ClientEngine::FlushSend(Connection& conn)
+	{
+		auto sendPos = 0;
+		while (sendPos < conn.SendSize)
+		{
+			auto ret = send(conn.FD, &conn.SendBuffer[sendPos], conn.SendSize - sendPos, MSG_NOSIGNAL);
+			if (ret < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					break;
+				}
+
+				CloseConnection(conn, true);
+				return false;
+			}
+
+			sendPos += (int)ret;
+		}
+
+		if (sendPos > 0)
+		{
+			memmove(&conn.SendBuffer[0], &conn.SendBuffer[sendPos], conn.SendSize - sendPos);
+			conn.SendSize -= sendPos;
+		}
+
+		UpdateWaitWritable(conn, conn.SendSize > 0);
+		return true;
+	}
+
+	void ClientEngine::UpdateWaitWritable(Connection& conn, const bool isWait)
+	{
+		if (conn.IsWaitWritable == isWait) {
+			return;
+		}
+
+		conn.IsWaitWritable = isWait;
+
+		epoll_event ev;
+		ev.events = isWait ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+		ev.data.u32 = (uint32_t)conn.Index;
+		epoll_ctl(m_EpollFD, EPOLL_CTL_MOD, conn.FD, &ev);
+	}
+
+	void ClientEngine::CloseConnection(Connection& conn, const bool isNotify)
+	{
+		epoll_ctl(m_EpollFD, EPOLL_CTL_DEL, conn.FD, nullptr);
+		close(conn.FD);
+
+		conn.FD = -1;
+		conn.State = CONNECTION_STATE::NONE;
+		conn.RecvSize = 0;
+		conn.SendSize = 0;
+		conn.IsWaitWritable = false;
+
+		if (isNotify) {
+			m_pHandler->OnClose(conn.Index);
+		}
+	}
+}
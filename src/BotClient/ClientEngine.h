@@ -0,0 +1,75 @@
+﻿#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+namespace NBotClient
+{
+	enum class CONNECTION_STATE : short
+	{
+		NONE = 0,
+		CONNECTING = 1,
+		CONNECTED = 2,
+	};
+
+	struct Connection
+	{
+		int Index = 0;
+		int FD = -1;
+		CONNECTION_STATE State = CONNECTION_STATE::NONE;
+
+		std::vector<char> RecvBuffer;
+		int RecvSize = 0;
+
+		std::vector<char> SendBuffer;
+		int SendSize = 0;
+		bool IsWaitWritable = false;
+	};
+
+	class IClientHandler
+	{
+	public:
+		virtual ~IClientHandler() {}
+
+		virtual void OnConnect(const int connIndex, const bool isSuccess) = 0;
+		// requestSeq 는 서버가 돌려준 요청 순번. 없으면 -1
+		virtual void OnPacket(const int connIndex, const short packetId, const char* pBody, const short bodySize, const int requestSeq) = 0;
+		virtual void OnClose(const int connIndex) = 0;
+	};
+
+	// epoll 기반의 클라이언트 다중 접속 엔진. 한 스레드에서 Poll()을 반복 호출해서 사용한다.
+	class ClientEngine
+	{
+	public:
+		ClientEngine();
+		~ClientEngine();
+
+		bool Init(const int maxConnectionCount, const int recvBufferSize, const int sendBufferSize, IClientHandler* pHandler);
+		void Release();
+
+		bool Connect(const int connIndex, const char* pIP, const unsigned short port);
+		// requestSeq 가 0 이상이면 헤더 뒤에 요청 순번을 붙인다. 로그인 때 LOGIN_FLAG_SEQUENCE 를 받은 뒤에만 쓴다.
+		bool Send(const int connIndex, const short packetId, const short bodySize, const char* pBody, const int requestSeq = -1);
+		void Close(const int connIndex);
+
+		// 이벤트가 있으면 처리하고 처리한 이벤트 수를 돌려준다.
+		int Poll(const int timeoutMilliSec);
+
+		bool IsConnected(const int connIndex) { return m_ConnectionList[connIndex].State == CONNECTION_STATE::CONNECTED; }
+
+	private:
+		void OnWritable(Connection& conn);
+		void OnReadable(Connection& conn);
+		bool FlushSend(Connection& conn);
+		void UpdateWaitWritable(Connection& conn, const bool isWait);
+		void CloseConnection(Connection& conn, const bool isNotify);
+
+	private:
+		int m_EpollFD = -1;
+		IClientHandler* m_pHandler = nullptr;
+
+		std::vector<Connection> m_ConnectionList;
+
+		std::vector<char> m_DecompressBuffer; // 압축된 Body 를 풀어 둘 곳. 모든 접속이 같이 쓴다.
+	};
+}
@@ -0,0 +1,116 @@
+﻿#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+namespace NBotClient
+{
+	struct LatencySummary
+	{
+		int64_t Count = 0;
+		int64_t ErrorCount = 0;
+		int64_t TimeoutCount = 0;
+
+		double AvgMicroSec = 0;
+		int64_t P50MicroSec = 0;
+		int64_t P90MicroSec = 0;
+		int64_t P99MicroSec = 0;
+		int64_t P999MicroSec = 0;
+		int64_t MaxMicroSec = 0;
+	};
+
+	// 요청 ~ 응답 시간을 PACKET_ID 별로 모아 두었다가 마지막에 백분위수를 계산한다.
+	// 샘플을 전부 보관하므로 측정 중에는 push_back 외에 하는 일이 없다.
+	class LatencyRecorder
+	{
+	public:
+		void Init(const int maxPacketId)
+		{
+			m_Samples.clear();
+			m_Samples.resize(maxPacketId);
+			m_ErrorCount.assign(maxPacketId, 0);
+			m_TimeoutCount.assign(maxPacketId, 0);
+		}
+
+		void Record(const short packetId, const int64_t elapsedMicroSec)
+		{
+			if (IsValid(packetId)) {
+				m_Samples[packetId].push_back((uint32_t)elapsedMicroSec);
+			}
+		}
+
+		void RecordError(const short packetId)
+		{
+			if (IsValid(packetId)) {
+				++m_ErrorCount[packetId];
+			}
+		}
+
+		void RecordTimeout(const short packetId)
+		{
+			if (IsValid(packetId)) {
+				++m_TimeoutCount[packetId];
+			}
+		}
+
+		int64_t TotalCount()
+		{
+			int64_t count = 0;
+			for (auto& samples : m_Samples) {
+				count += (int64_t)samples.size();
+			}
+			return count;
+		}
+
+		bool HasData(const short packetId)
+		{
+			return IsValid(packetId) && (m_Samples[packetId].empty() == false || m_TimeoutCount[packetId] > 0);
+		}
+
+		LatencySummary GetSummary(const short packetId)
+		{
+			LatencySummary summary;
+			if (IsValid(packetId) == false) {
+				return summary;
+			}
+
+			auto samples = m_Samples[packetId];
+			summary.Count = (int64_t)samples.size();
+			summary.ErrorCount = m_ErrorCount[packetId];
+			summary.TimeoutCount = m_TimeoutCount[packetId];
+			if (samples.empty()) {
+				return summary;
+			}
+
+			std::sort(samples.begin(), samples.end());
+
+			int64_t total = 0;
+			for (auto sample : samples) {
+				total += sample;
+			}
+
+			summary.AvgMicroSec = (double)total / samples.size();
+			summary.P50MicroSec = Percentile(samples, 0.50);
+			summary.P90MicroSec = Percentile(samples, 0.90);
+			summary.P99MicroSec = Percentile(samples, 0.99);
+			summary.P999MicroSec = Percentile(samples, 0.999);
+			summary.MaxMicroSec = samples.back();
+			return summary;
+		}
+
+	private:
+		bool IsValid(const short packetId) { return packetId >= 0 && packetId < (short)m_Samples.size(); }
+
+		static int64_t Percentile(const std::vector<uint32_t>& sortedSamples, const double ratio)
+		{
+			auto index = (size_t)(ratio * (sortedSamples.size() - 1) + 0.5);
+			return sortedSamples[index];
+		}
+
+	private:
+		std::vector<std::vector<uint32_t>> m_Samples;
+		std::vector<int64_t> m_ErrorCount;
+		std::vector<int64_t> m_TimeoutCount;
+	};
+}
@@ -0,0 +1,59 @@
+﻿#include <stdio.h>
+#include <string>
+#include "../LogicLib/IniReader.h"
+#include "BotManager.h"
+
+/*
+서버에 봇을 붙여서 부하를 주고 패킷별 응답 시간을 측정한다.
+사용법: BotClient [설정 파일 경로]
+*/
+int main(int argc, char* argv[])
+{
+	std::string filePath = "../resources/BotConfig.ini";
+	if (argc > 1) {
+		filePath = argv[1];
+	}
+
+	INIReader reader(filePath);
+	if (reader.ParseError() < 0)
+	{
+		printf("Can't load %s\n", filePath.c_str());
+		return 1;
+	}
+
+	NBotClient::BotConfig config;
+	snprintf(config.ServerIP, sizeof(config.ServerIP), "%s", reader.Get("Bot", "ServerIP", "127.0.0.1").c_str());
+	config.Port = (unsigned short)reader.GetInteger("Bot", "Port", 32452);
+	config.BotCount = (int)reader.GetInteger("Bot", "BotCount", 100);
+	config.StartBotIndex = (int)reader.GetInteger("Bot", "StartBotIndex", 0);
+	config.ConnectPerSec = (int)reader.GetInteger("Bot", "ConnectPerSec", 100);
+	config.DurationSec = (int)reader.GetInteger("Bot", "DurationSec", 30);
+	config.ThinkTimeMilliSec = (int)reader.GetInteger("Bot", "ThinkTimeMilliSec", 100);
+	config.RequestTimeoutMilliSec = (int)reader.GetInteger("Bot", "RequestTimeoutMilliSec", 5000);
+	config.ReportIntervalSec = (int)reader.GetInteger("Bot", "ReportIntervalSec", 5);
+	config.IsCompress = reader.GetBoolean("Bot", "Compress", false);
+	config.IsSequence = reader.GetBoolean("Bot", "Sequence", false);
+	config.PipelineDepth = (int)reader.GetInteger("Bot", "PipelineDepth", 1);
+
+	config.WeightRoomCreate = (int)reader.GetInteger("Scenario", "RoomCreate", 10);
+	config.WeightRoomJoin = (int)reader.GetInteger("Scenario", "RoomJoin", 30);
+	config.WeightRoomQuickMatch = (int)reader.GetInteger("Scenario", "RoomQuickMatch", 0);
+	config.WeightRoomChat = (int)reader.GetInteger("Scenario", "RoomChat", 60);
+	config.WeightRoomLeave = (int)reader.GetInteger("Scenario", "RoomLeave", 10);
+	config.WeightLobbyChat = (int)reader.GetInteger("Scenario", "LobbyChat", 0);
+	config.WeightLobbyLeave = (int)reader.GetInteger("Scenario", "LobbyLeave", 5);
+	config.WeightLogout = (int)reader.GetInteger("Scenario", "Logout", 1);
+
+	NBotClient::BotManager botMgr;
+	if (botMgr.Init(config) == false)
+	{
+		printf("BotManager Init Fail\n");
+		return 1;
+	}
+
+	printf("%d bots -> %s:%d, %d sec\n", config.BotCount, config.ServerIP, config.Port, config.DurationSec);
+
+	botMgr.Run();
+	botMgr.PrintReport();
+	return 0;
+}
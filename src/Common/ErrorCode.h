@@ -8,6 +8,7 @@ namespace NCommon
 		NONE = 0,
 
 		UNASSIGNED_ERROR = 201,
+		PACKET_INVALID_BODY_SIZE = 202, // Body ũ⳪  ʵ尡 Packet.idl ǿ  ʴ
 
 		MAIN_INIT_NETWORK_INIT_FAIL = 206,
 
@@ -44,6 +45,7 @@ namespace NCommon
 		ROOM_ENTER_NOT_CREATED = 275,
 		ROOM_ENTER_MEMBER_FULL = 276,
 		ROOM_ENTER_EMPTY_ROOM = 277,
+		ROOM_ENTER_NO_JOINABLE_ROOM = 278,
 
 
 		ROOM_LEAVE_INVALID_DOMAIN = 286,
@@ -58,6 +60,14 @@ namespace NCommon
 
 		LOBBY_CHAT_INVALID_DOMAIN = 306,
 		LOBBY_CHAT_INVALID_LOBBY_INDEX = 307,
+		LOBBY_CHAT_TOO_MANY = 308,
+
+		ROOM_QUICK_MATCH_INVALID_DOMAIN = 311,
+		ROOM_QUICK_MATCH_INVALID_LOBBY_INDEX = 312,
+		ROOM_QUICK_MATCH_ALREADY_WAITING = 313,
+
+		ROOM_LIST_INVALID_DOMAIN = 316,
+		ROOM_LIST_INVALID_LOBBY_INDEX = 317,
 
 		ROOM_MASTER_GAME_START_INVALID_DOMAIN = 401,
 		ROOM_MASTER_GAME_START_INVALID_LOBBY_INDEX = 402,
@@ -65,5 +75,19 @@ namespace NCommon
 		ROOM_MASTER_GAME_START_INVALID_MASTER = 404,
 		ROOM_MASTER_GAME_START_INVALID_GAME_STATE = 405,
 		ROOM_MASTER_GAME_START_INVALID_USER_COUNT = 406,
+		ROOM_GAME_START_ALREADY_READY = 407,
+		ROOM_GAME_START_TIMEOUT = 408,
+		ROOM_GAME_START_CANCELED = 409,
+
+		ROOM_GAME_SELECT_INVALID_DOMAIN = 411,
+		ROOM_GAME_SELECT_INVALID_LOBBY_INDEX = 412,
+		ROOM_GAME_SELECT_INVALID_ROOM_INDEX = 413,
+		ROOM_GAME_SELECT_INVALID_GAME_STATE = 414,
+		ROOM_GAME_SELECT_NOT_PLAYER = 415,
+		ROOM_GAME_SELECT_ALREADY_SELECTED = 416,
+		ROOM_GAME_SELECT_INVALID_SELECT = 417,
+		ROOM_GAME_ABORTED = 418,
+
+		DEV_ECHO_INVALID_DATA_SIZE = 501,
 	};
 }
\ No newline at end of file
@@ -15,28 +15,82 @@ namespace NCommon
 		unsigned char Reserve;
 	};
 
+	// PktHeader::Reserve   ÷
+	const unsigned char PACKET_FLAG_COMPRESSED = 0x01; // Body  LZ4    ִ
+	const unsigned char PACKET_FLAG_SEQUENCE = 0x02; //  ٷ ڿ û (unsigned short) ִ. TotalSize    ʴ´
+
+	// û  ٿ  û óϴ    Ŭ̾Ʈ  Ŷ(, )   ٴ´.
+	//    óϹǷ  ٸ ʰ û ̾   ¦   ִ.
+	const int PACKET_SEQUENCE_SIZE = sizeof(unsigned short);
+
 	struct PktBase
 	{
 		short ErrorCode = (short)ERROR_CODE::NONE;
 		void SetError(ERROR_CODE error) { ErrorCode = (short)error; }
 	};
 
+	//- ڿ( , ä) UTF-8   տ Ʈ (short) δ.  ڴ  ʴ´.
+	// ڿ  ִ Ŷ ִ ũ ü    Ʈ .
+	// length Ʈ ȿ  ڰ ߸ ʴ ̸ ش.
+	inline short TrimUtf8Length(const char* pStr, const short length)
+	{
+		if (length <= 0) {
+			return 0;
+		}
+
+		auto start = (short)(length - 1);
+		while (start > 0 && length - start < 4 && ((unsigned char)pStr[start] & 0xC0) == 0x80) {
+			--start;
+		}
+
+		auto lead = (unsigned char)pStr[start];
+		short needSize = 1;
+		if ((lead & 0xE0) == 0xC0) needSize = 2;
+		else if ((lead & 0xF0) == 0xE0) needSize = 3;
+		else if ((lead & 0xF8) == 0xF0) needSize = 4;
+
+		return (length - start) >= needSize ? length : start;
+	}
+
+	//  ڷ  UTF-8 ڿ maxLength Ʈ ϰ  Ʈ  ش.
+	inline short CopyUtf8(char* pDest, const short maxLength, const char* pszSrc)
+	{
+		short length = 0;
+		while (length < maxLength && pszSrc[length] != '\0') {
+			++length;
+		}
+
+		length = TrimUtf8Length(pszSrc, length);
+		for (short i = 0; i < length; ++i) {
+			pDest[i] = pszSrc[i];
+		}
+		return length;
+	}
+
 	//- α û
+	// Flags  Ŭ̾Ʈ   ִ LOGIN_FLAG_XXX  ִ´.   ޾Ƶ ͸  Flags  ش.
+	//  Ŭ̾Ʈ Flags  Ƿ 0  .
 	const int MAX_USER_ID_SIZE = 16;
 	const int MAX_USER_PASSWORD_SIZE = 16;
+	const unsigned char LOGIN_FLAG_COMPRESS = 0x01; // PACKET_FLAG_COMPRESSED Ŷ ְ  ִ
+	const unsigned char LOGIN_FLAG_SEQUENCE = 0x02; // PACKET_FLAG_SEQUENCE  û  ٿ   ִ
 	struct PktLogInReq
 	{
 		char szID[MAX_USER_ID_SIZE+1] = { 0, };
 		char szPW[MAX_USER_PASSWORD_SIZE+1] = { 0, };
+		unsigned char Flags = 0;
 	};
 
 	struct PktLogInRes : PktBase
 	{
+		unsigned char Flags = 0;
 	};
 
 
 	//- ä Ʈ û
-	// Request Body .
+	// Version      ִ´(ó̸ 0). Body   0  .
+	//     IsNotModified  true ̰   ´.
+	//  LobbyCount ŭ .
 	const int MAX_LOBBY_LIST_COUNT = 20;
 	struct LobbyListInfo
 	{
@@ -45,9 +99,21 @@ namespace NCommon
 		short LobbyMaxUserCount;
 	};
 
-	struct PktLobbyListReq {};
+	struct PktLobbyListReq
+	{
+		int Version = 0;
+	};
 
 	struct PktLobbyListRes : PktBase
+	{
+		int Version = 0;
+		bool IsNotModified = false;
+		short LobbyCount = 0;
+		LobbyListInfo LobbyList[MAX_LOBBY_LIST_COUNT];
+	};
+
+	// Body (Version ) û  Ŭ̾Ʈ ִ   κ  . ׻ ü ũ .
+	struct PktLobbyListLegacyRes : PktBase
 	{
 		short LobbyCount = 0;
 		LobbyListInfo LobbyList[MAX_LOBBY_LIST_COUNT];
@@ -67,6 +133,46 @@ namespace NCommon
 	};
 
 
+	//- κ   û
+	// StartRoomIndex  ǿ ´    ִ MAX_ROOM_LIST_COUNT  ش.
+	//   NextRoomIndex  StartRoomIndex  ־ ûѴ(-1 ̸ ).  RoomCount ŭ .
+	//   RoomTitleLength Ʈ  Ƿ RoomList  ̰ ٸ RoomSmallInfo  ̾ ִ.
+	const int MAX_ROOM_LIST_COUNT = 12;
+	const int MAX_ROOM_TITLE_SIZE = 48; // UTF-8 Ʈ (ѱ 16 )
+	struct RoomSmallInfo
+	{
+		short RoomIndex;
+		short RoomUserCount; // 0 ̸  
+		short RoomMaxUserCount;
+		short GameState;
+		short RoomTitleLength;
+		char RoomTitle[MAX_ROOM_TITLE_SIZE];
+
+		short GetSendSize() const { return (short)(sizeof(RoomSmallInfo) - MAX_ROOM_TITLE_SIZE + RoomTitleLength); }
+	};
+
+	struct PktRoomListReq
+	{
+		short StartRoomIndex = 0;
+		bool IsOnlyHasSeat = false;	//  ڸ ִ 븸
+		bool IsOnlyWaiting = false;	//   ʴ 븸
+	};
+
+	struct PktRoomListRes : PktBase
+	{
+		short NextRoomIndex = -1;
+		short RoomCount = 0;
+		char RoomList[MAX_ROOM_LIST_COUNT * sizeof(RoomSmallInfo)];
+	};
+
+	//- κ ִ  ٲ   뺸.  ƽ  ٲ  Ƽ .
+	struct PktRoomChangedInfoNtf
+	{
+		short RoomCount = 0;
+		char RoomList[MAX_ROOM_LIST_COUNT * sizeof(RoomSmallInfo)];
+	};
+
+
 	//- κ񿡼  û
 	struct PktLobbyLeaveReq {};
 
@@ -75,30 +181,40 @@ namespace NCommon
 	};
 	
 	//- κ ä
-	const int MAX_LOBBY_CHAT_MSG_SIZE = 256;
+	const int MAX_LOBBY_CHAT_MSG_SIZE = 512; // UTF-8 Ʈ 
 	struct PktLobbyChatReq
 	{
-		wchar_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
+		short MsgLength = 0;
+		char Msg[MAX_LOBBY_CHAT_MSG_SIZE];
 	};
 
 	struct PktLobbyChatRes : PktBase
 	{
 	};
 
-	struct PktLobbyChatNtf
+	//- κ ä 뺸.  ƽ   ä Ƽ κ    .
+	// Data  ChatCount  LobbyChatEntry  ̾ ְ  ׸ ڿ MsgLength Ʈ Msg  ٴ´.
+	struct LobbyChatEntry
 	{
 		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
-		wchar_t Msg[MAX_LOBBY_CHAT_MSG_SIZE + 1] = { 0, };
+		short MsgLength = 0;
+	};
+
+	const int MAX_LOBBY_CHAT_NTF_DATA_SIZE = 2048;
+	struct PktLobbyChatNtf
+	{
+		short ChatCount = 0;
+		char Data[MAX_LOBBY_CHAT_NTF_DATA_SIZE];
 	};
 
 
 	//- 뿡  û
-	const int MAX_ROOM_TITLE_SIZE = 16;
 	struct PktRoomEnterReq
 	{
 		bool IsCreate;
 		short RoomIndex;
-		wchar_t RoomTitle[MAX_ROOM_TITLE_SIZE + 1];
+		short RoomTitleLength;
+		char RoomTitle[MAX_ROOM_TITLE_SIZE];
 	};
 
 	struct PktRoomEnterRes : PktBase
@@ -128,10 +244,11 @@ namespace NCommon
 		
 
 	//-  ä
-	const int MAX_ROOM_CHAT_MSG_SIZE = 256;
+	const int MAX_ROOM_CHAT_MSG_SIZE = 512; // UTF-8 Ʈ 
 	struct PktRoomChatReq
 	{
-		wchar_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
+		short MsgLength = 0;
+		char Msg[MAX_ROOM_CHAT_MSG_SIZE];
 	};
 
 	struct PktRoomChatRes : PktBase
@@ -141,7 +258,24 @@ namespace NCommon
 	struct PktRoomChatNtf
 	{
 		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
-		wchar_t Msg[MAX_ROOM_CHAT_MSG_SIZE + 1] = { 0, };
+		short MsgLength = 0;
+		char Msg[MAX_ROOM_CHAT_MSG_SIZE];
+	};
+
+	//-   û.  ⿭ ٴ ̰  뿡  NTF  ´.
+	// NTF  UserCount ŭ .
+	const int MAX_ROOM_USER_COUNT = 8;
+	struct PktRoomQuickMatchReq {};
+
+	struct PktRoomQuickMatchRes : PktBase
+	{
+	};
+
+	struct PktRoomQuickMatchNtf
+	{
+		short RoomIndex = -1;
+		short UserCount = 0;
+		char UserIDList[MAX_ROOM_USER_COUNT][MAX_USER_ID_SIZE + 1];
 	};
 
 	//    û
@@ -167,6 +301,69 @@ namespace NCommon
 		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
 	};
 
+	//    ûؼ  ۵ƴ. ð ų   ҵǸ ErrorCode   ´.
+	struct PktRoomGameBeginNtf : PktBase
+	{};
+
+	// .   ΰ  ӿ , 帶       .
+	enum class GAME_SELECT : char
+	{
+		NONE = -1,	// ð ȿ  ʾҴ.  忡 
+		SCISSORS = 0,
+		ROCK = 1,
+		PAPER = 2,
+	};
+
+	enum class GAME_RESULT : char
+	{
+		NONE = 0,
+		WIN = 1,	//    ȥ ̰ܼ  
+		LOSE = 2,	// ̹ 忡  
+		DRAW = 3,	// ܼ   
+		OUT = 4,	//  忡 ̹ 
+	};
+
+	const int GAME_MAX_ROUND_COUNT = 10; //          ä 
+
+	//  . SelectMilliSec ȿ ROOM_GAME_SELECT_REQ   Ѵ.
+	struct PktRoomGameRoundStartNtf
+	{
+		short RoundNo = 0;
+		int SelectMilliSec = 0;
+		short PlayerCount = 0; //̹ 忡   ִ  
+	};
+
+	struct PktRoomGameSelectReq
+	{
+		char Select = (char)GAME_SELECT::NONE;
+	};
+
+	struct PktRoomGameSelectRes : PktBase
+	{};
+
+	//   ˸.    ˸.
+	struct PktRoomGameSelectNtf
+	{
+		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
+	};
+
+	struct GameResultInfo
+	{
+		char UserID[MAX_USER_ID_SIZE + 1] = { 0, };
+		char Select = (char)GAME_SELECT::NONE;
+		char Result = (char)GAME_RESULT::NONE;
+	};
+
+	//  . IsGameEnd  WIN   ̰( ä  DRAW    ).
+	//    ErrorCode   ´.
+	struct PktRoomGameResultNtf : PktBase
+	{
+		short RoundNo = 0;
+		bool IsGameEnd = false;
+		short PlayerCount = 0;
+		GameResultInfo PlayerList[MAX_ROOM_USER_COUNT];
+	};
+
 	const int DEV_ECHO_DATA_MAX_SIZE = 1024;
 
 	struct PktDevEchoReq
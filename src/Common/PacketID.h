@@ -16,6 +16,9 @@ namespace NCommon
 				
 		LOBBY_LEAVE_REQ = 46,
 		LOBBY_LEAVE_RES = 47,
+
+		ROOM_LIST_REQ = 56,
+		ROOM_LIST_RES = 57,
 		
 		ROOM_ENTER_REQ = 61,
 		ROOM_ENTER_RES = 62,
@@ -35,6 +38,10 @@ namespace NCommon
 		LOBBY_CHAT_RES = 82,
 		LOBBY_CHAT_NTF = 83,
 
+		ROOM_QUICK_MATCH_REQ = 91,
+		ROOM_QUICK_MATCH_RES = 92,
+		ROOM_QUICK_MATCH_NTF = 93,
+
 		ROOM_MASTER_GAME_START_REQ = 101,
 		ROOM_MASTER_GAME_START_RES = 102,
 		ROOM_MASTER_GAME_START_NTF = 103,
@@ -43,6 +50,14 @@ namespace NCommon
 		ROOM_GAME_START_RES = 112,
 		ROOM_GAME_START_NTF = 113,
 
+		ROOM_GAME_BEGIN_NTF = 121,
+		ROOM_GAME_ROUND_START_NTF = 122,
+		ROOM_GAME_RESULT_NTF = 123,
+
+		ROOM_GAME_SELECT_REQ = 131,
+		ROOM_GAME_SELECT_RES = 132,
+		ROOM_GAME_SELECT_NTF = 133,
+
 
 
 		DEV_ECHO_REQ = 241,
@@ -0,0 +1,2527 @@
+﻿// 이 파일은 tools/packetgen.py 가 src/Common/Packet.idl 로 만든다. 직접 고치지 말고 Packet.idl 을 고친 뒤 다시 만든다.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Packet.h"
+
+namespace NCommon
+{
+	template <class T>
+	inline T ReadPacketField(const char* pData)
+	{
+		T value;
+		memcpy(&value, pData, sizeof(T));
+		return value;
+	}
+
+	template <class T>
+	inline void WritePacketField(char* pData, const T& value)
+	{
+		memcpy(pData, &value, sizeof(T));
+	}
+
+	// 고정 크기 문자열 필드. 남는 곳은 0 으로 채운다.
+	inline void CopyPacketString(char* pDest, const int size, const char* pszSrc)
+	{
+		int i = 0;
+		for (; pszSrc != nullptr && i < size && pszSrc[i] != '\0'; ++i) {
+			pDest[i] = pszSrc[i];
+		}
+		memset(pDest + i, 0, size - i);
+	}
+
+	// Packet.h 의 패킷 구조체 -> XxxLayout
+	template <class T>
+	struct PacketLayoutOf;
+
+
+	//- LobbyListInfo
+	struct LobbyListInfoLayout
+	{
+		static constexpr int LobbyId_Offset = 0;
+		static constexpr int LobbyId_Size = 2;
+		static constexpr int LobbyUserCount_Offset = LobbyId_Offset + LobbyId_Size;
+		static constexpr int LobbyUserCount_Size = 2;
+		static constexpr int LobbyMaxUserCount_Offset = LobbyUserCount_Offset + LobbyUserCount_Size;
+		static constexpr int LobbyMaxUserCount_Size = 2;
+		static constexpr int Size = LobbyMaxUserCount_Offset + LobbyMaxUserCount_Size;
+	};
+	static_assert(sizeof(LobbyListInfo) == LobbyListInfoLayout::Size, "Packet.idl 과 Packet.h 의 LobbyListInfo 가 다르다");
+
+	//- LobbyChatEntry
+	struct LobbyChatEntryLayout
+	{
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MsgLength_Offset = UserID_Offset + UserID_Size;
+		static constexpr int MsgLength_Size = 2;
+		static constexpr int Size = MsgLength_Offset + MsgLength_Size;
+	};
+	static_assert(sizeof(LobbyChatEntry) == LobbyChatEntryLayout::Size, "Packet.idl 과 Packet.h 의 LobbyChatEntry 가 다르다");
+
+	//- PktLogInReq (LOGIN_IN_REQ)
+	struct PktLogInReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOGIN_IN_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int szID_Offset = 0;
+		static constexpr int szID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int szPW_Offset = szID_Offset + szID_Size;
+		static constexpr int szPW_Size = (MAX_USER_PASSWORD_SIZE + 1);
+		static constexpr int Flags_Offset = szPW_Offset + szPW_Size;
+		static constexpr int Flags_Size = 1;
+		static constexpr int MinSize = Flags_Offset;
+		static constexpr int MaxSize = Flags_Offset + Flags_Size;
+	};
+	static_assert(sizeof(PktLogInReq) == PktLogInReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLogInReq 가 다르다");
+	template <> struct PacketLayoutOf<PktLogInReq> { using Type = PktLogInReqLayout; };
+
+	class PktLogInReqView
+	{
+	public:
+		using Layout = PktLogInReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* szID() const { return m_pData + Layout::szID_Offset; }
+		const char* szPW() const { return m_pData + Layout::szPW_Offset; }
+		uint8_t Flags() const { return m_Size < Layout::Flags_Offset + Layout::Flags_Size ? uint8_t() : ReadPacketField<uint8_t>(m_pData + Layout::Flags_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLogInReqWriter
+	{
+		using Layout = PktLogInReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* szID, const char* szPW, const uint8_t flags)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::szID_Offset, Layout::szID_Size, szID);
+			CopyPacketString(pBuffer + Layout::szPW_Offset, Layout::szPW_Size, szPW);
+			WritePacketField(pBuffer + Layout::Flags_Offset, flags);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLogInRes (LOGIN_IN_RES)
+	struct PktLogInResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOGIN_IN_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int Flags_Offset = ErrorCode_Offset + 2;
+		static constexpr int Flags_Size = 1;
+		static constexpr int MinSize = Flags_Offset;
+		static constexpr int MaxSize = Flags_Offset + Flags_Size;
+	};
+	static_assert(sizeof(PktLogInRes) == PktLogInResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLogInRes 가 다르다");
+	template <> struct PacketLayoutOf<PktLogInRes> { using Type = PktLogInResLayout; };
+
+	class PktLogInResView
+	{
+	public:
+		using Layout = PktLogInResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		uint8_t Flags() const { return m_Size < Layout::Flags_Offset + Layout::Flags_Size ? uint8_t() : ReadPacketField<uint8_t>(m_pData + Layout::Flags_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLogInResWriter
+	{
+		using Layout = PktLogInResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const uint8_t flags)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::Flags_Offset, flags);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyListReq (LOBBY_LIST_REQ)
+	struct PktLobbyListReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_LIST_REQ;
+		static constexpr bool IsOptional = true;
+		static constexpr int Version_Offset = 0;
+		static constexpr int Version_Size = 4;
+		static constexpr int MinSize = Version_Offset + Version_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktLobbyListReq) == PktLobbyListReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyListReq 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyListReq> { using Type = PktLobbyListReqLayout; };
+
+	class PktLobbyListReqView
+	{
+	public:
+		using Layout = PktLobbyListReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			m_IsEmpty = size < Layout::MinSize;
+			return true;
+		}
+
+		bool IsEmpty() const { return m_IsEmpty; }
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		int Version() const { return m_IsEmpty ? int() : ReadPacketField<int>(m_pData + Layout::Version_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+		bool m_IsEmpty = true;
+	};
+
+	struct PktLobbyListReqWriter
+	{
+		using Layout = PktLobbyListReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const int version)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::Version_Offset, version);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyListRes (LOBBY_LIST_RES)
+	struct PktLobbyListResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_LIST_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int Version_Offset = ErrorCode_Offset + 2;
+		static constexpr int Version_Size = 4;
+		static constexpr int IsNotModified_Offset = Version_Offset + Version_Size;
+		static constexpr int IsNotModified_Size = 1;
+		static constexpr int LobbyCount_Offset = IsNotModified_Offset + IsNotModified_Size;
+		static constexpr int LobbyCount_Size = 2;
+		static constexpr int LobbyList_Offset = LobbyCount_Offset + LobbyCount_Size;
+		static constexpr int LobbyList_ElemSize = LobbyListInfoLayout::Size;
+		static constexpr int LobbyList_MaxCount = MAX_LOBBY_LIST_COUNT;
+		static constexpr int MinSize = LobbyList_Offset;
+		static constexpr int MaxSize = LobbyList_Offset + LobbyList_ElemSize * LobbyList_MaxCount;
+	};
+	static_assert(sizeof(PktLobbyListRes) == PktLobbyListResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyListRes 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyListRes> { using Type = PktLobbyListResLayout; };
+
+	class PktLobbyListResView
+	{
+	public:
+		using Layout = PktLobbyListResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)LobbyCount();
+			if (count < 0 || count > Layout::LobbyList_MaxCount) {
+				return false;
+			}
+			return size >= Layout::LobbyList_Offset + count * Layout::LobbyList_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		int Version() const { return ReadPacketField<int>(m_pData + Layout::Version_Offset); }
+		bool IsNotModified() const { return ReadPacketField<bool>(m_pData + Layout::IsNotModified_Offset); }
+		short LobbyCount() const { return ReadPacketField<short>(m_pData + Layout::LobbyCount_Offset); }
+		LobbyListInfo LobbyList(const int index) const { return ReadPacketField<LobbyListInfo>(m_pData + Layout::LobbyList_Offset + index * Layout::LobbyList_ElemSize); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyListResWriter
+	{
+		using Layout = PktLobbyListResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const int version, const bool isNotModified, const short lobbyCount, const LobbyListInfo* pLobbyList)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::Version_Offset, version);
+			WritePacketField(pBuffer + Layout::IsNotModified_Offset, isNotModified);
+			WritePacketField(pBuffer + Layout::LobbyCount_Offset, lobbyCount);
+
+			auto lobbyListSize = (int)lobbyCount * Layout::LobbyList_ElemSize;
+			if ((int)lobbyCount < 0 || (int)lobbyCount > Layout::LobbyList_MaxCount || Layout::LobbyList_Offset + lobbyListSize > capacity) {
+				return -1;
+			}
+			if (lobbyListSize > 0) {
+				memcpy(pBuffer + Layout::LobbyList_Offset, pLobbyList, lobbyListSize);
+			}
+
+			return Layout::LobbyList_Offset + lobbyListSize;
+		}
+	};
+
+	//- PktLobbyEnterReq (LOBBY_ENTER_REQ)
+	struct PktLobbyEnterReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_ENTER_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int LobbyId_Offset = 0;
+		static constexpr int LobbyId_Size = 2;
+		static constexpr int MinSize = LobbyId_Offset + LobbyId_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktLobbyEnterReq) == PktLobbyEnterReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyEnterReq 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyEnterReq> { using Type = PktLobbyEnterReqLayout; };
+
+	class PktLobbyEnterReqView
+	{
+	public:
+		using Layout = PktLobbyEnterReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short LobbyId() const { return ReadPacketField<short>(m_pData + Layout::LobbyId_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyEnterReqWriter
+	{
+		using Layout = PktLobbyEnterReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short lobbyId)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::LobbyId_Offset, lobbyId);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyEnterRes (LOBBY_ENTER_RES)
+	struct PktLobbyEnterResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_ENTER_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MaxUserCount_Offset = ErrorCode_Offset + 2;
+		static constexpr int MaxUserCount_Size = 2;
+		static constexpr int MaxRoomCount_Offset = MaxUserCount_Offset + MaxUserCount_Size;
+		static constexpr int MaxRoomCount_Size = 2;
+		static constexpr int MinSize = MaxRoomCount_Offset + MaxRoomCount_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktLobbyEnterRes) == PktLobbyEnterResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyEnterRes 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyEnterRes> { using Type = PktLobbyEnterResLayout; };
+
+	class PktLobbyEnterResView
+	{
+	public:
+		using Layout = PktLobbyEnterResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		short MaxUserCount() const { return ReadPacketField<short>(m_pData + Layout::MaxUserCount_Offset); }
+		short MaxRoomCount() const { return ReadPacketField<short>(m_pData + Layout::MaxRoomCount_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyEnterResWriter
+	{
+		using Layout = PktLobbyEnterResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const short maxUserCount, const short maxRoomCount)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::MaxUserCount_Offset, maxUserCount);
+			WritePacketField(pBuffer + Layout::MaxRoomCount_Offset, maxRoomCount);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomListReq (ROOM_LIST_REQ)
+	struct PktRoomListReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_LIST_REQ;
+		static constexpr bool IsOptional = true;
+		static constexpr int StartRoomIndex_Offset = 0;
+		static constexpr int StartRoomIndex_Size = 2;
+		static constexpr int IsOnlyHasSeat_Offset = StartRoomIndex_Offset + StartRoomIndex_Size;
+		static constexpr int IsOnlyHasSeat_Size = 1;
+		static constexpr int IsOnlyWaiting_Offset = IsOnlyHasSeat_Offset + IsOnlyHasSeat_Size;
+		static constexpr int IsOnlyWaiting_Size = 1;
+		static constexpr int MinSize = IsOnlyWaiting_Offset + IsOnlyWaiting_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomListReq) == PktRoomListReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomListReq 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomListReq> { using Type = PktRoomListReqLayout; };
+
+	class PktRoomListReqView
+	{
+	public:
+		using Layout = PktRoomListReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			m_IsEmpty = size < Layout::MinSize;
+			return true;
+		}
+
+		bool IsEmpty() const { return m_IsEmpty; }
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short StartRoomIndex() const { return m_IsEmpty ? short() : ReadPacketField<short>(m_pData + Layout::StartRoomIndex_Offset); }
+		bool IsOnlyHasSeat() const { return m_IsEmpty ? bool() : ReadPacketField<bool>(m_pData + Layout::IsOnlyHasSeat_Offset); }
+		bool IsOnlyWaiting() const { return m_IsEmpty ? bool() : ReadPacketField<bool>(m_pData + Layout::IsOnlyWaiting_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+		bool m_IsEmpty = true;
+	};
+
+	struct PktRoomListReqWriter
+	{
+		using Layout = PktRoomListReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short startRoomIndex, const bool isOnlyHasSeat, const bool isOnlyWaiting)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::StartRoomIndex_Offset, startRoomIndex);
+			WritePacketField(pBuffer + Layout::IsOnlyHasSeat_Offset, isOnlyHasSeat);
+			WritePacketField(pBuffer + Layout::IsOnlyWaiting_Offset, isOnlyWaiting);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomListRes (ROOM_LIST_RES)
+	struct PktRoomListResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_LIST_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int NextRoomIndex_Offset = ErrorCode_Offset + 2;
+		static constexpr int NextRoomIndex_Size = 2;
+		static constexpr int RoomCount_Offset = NextRoomIndex_Offset + NextRoomIndex_Size;
+		static constexpr int RoomCount_Size = 2;
+		static constexpr int RoomList_Offset = RoomCount_Offset + RoomCount_Size;
+		static constexpr int RoomList_ElemSize = 1;
+		static constexpr int RoomList_MaxCount = MAX_ROOM_LIST_COUNT * sizeof(RoomSmallInfo);
+		static constexpr int MinSize = RoomList_Offset;
+		static constexpr int MaxSize = RoomList_Offset + RoomList_ElemSize * RoomList_MaxCount;
+	};
+	static_assert(sizeof(PktRoomListRes) == PktRoomListResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomListRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomListRes> { using Type = PktRoomListResLayout; };
+
+	class PktRoomListResView
+	{
+	public:
+		using Layout = PktRoomListResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return size <= Layout::MaxSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		short NextRoomIndex() const { return ReadPacketField<short>(m_pData + Layout::NextRoomIndex_Offset); }
+		short RoomCount() const { return ReadPacketField<short>(m_pData + Layout::RoomCount_Offset); }
+		int RoomListSize() const { return m_Size - Layout::RoomList_Offset; }
+		const char* RoomList() const { return m_pData + Layout::RoomList_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomListResWriter
+	{
+		using Layout = PktRoomListResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const short nextRoomIndex, const short roomCount, const int roomListSize, const char* pRoomList)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::NextRoomIndex_Offset, nextRoomIndex);
+			WritePacketField(pBuffer + Layout::RoomCount_Offset, roomCount);
+
+			if (roomListSize < 0 || roomListSize > Layout::RoomList_MaxCount || Layout::RoomList_Offset + roomListSize > capacity) {
+				return -1;
+			}
+			if (roomListSize > 0) {
+				memcpy(pBuffer + Layout::RoomList_Offset, pRoomList, roomListSize);
+			}
+
+			return Layout::RoomList_Offset + roomListSize;
+		}
+	};
+
+	//- PktRoomChangedInfoNtf (ROOM_CHANGED_INFO_NTF)
+	struct PktRoomChangedInfoNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_CHANGED_INFO_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int RoomCount_Offset = 0;
+		static constexpr int RoomCount_Size = 2;
+		static constexpr int RoomList_Offset = RoomCount_Offset + RoomCount_Size;
+		static constexpr int RoomList_ElemSize = 1;
+		static constexpr int RoomList_MaxCount = MAX_ROOM_LIST_COUNT * sizeof(RoomSmallInfo);
+		static constexpr int MinSize = RoomList_Offset;
+		static constexpr int MaxSize = RoomList_Offset + RoomList_ElemSize * RoomList_MaxCount;
+	};
+	static_assert(sizeof(PktRoomChangedInfoNtf) == PktRoomChangedInfoNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomChangedInfoNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomChangedInfoNtf> { using Type = PktRoomChangedInfoNtfLayout; };
+
+	class PktRoomChangedInfoNtfView
+	{
+	public:
+		using Layout = PktRoomChangedInfoNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return size <= Layout::MaxSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short RoomCount() const { return ReadPacketField<short>(m_pData + Layout::RoomCount_Offset); }
+		int RoomListSize() const { return m_Size - Layout::RoomList_Offset; }
+		const char* RoomList() const { return m_pData + Layout::RoomList_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomChangedInfoNtfWriter
+	{
+		using Layout = PktRoomChangedInfoNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short roomCount, const int roomListSize, const char* pRoomList)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::RoomCount_Offset, roomCount);
+
+			if (roomListSize < 0 || roomListSize > Layout::RoomList_MaxCount || Layout::RoomList_Offset + roomListSize > capacity) {
+				return -1;
+			}
+			if (roomListSize > 0) {
+				memcpy(pBuffer + Layout::RoomList_Offset, pRoomList, roomListSize);
+			}
+
+			return Layout::RoomList_Offset + roomListSize;
+		}
+	};
+
+	//- PktLobbyLeaveReq (LOBBY_LEAVE_REQ)
+	struct PktLobbyLeaveReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_LEAVE_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktLobbyLeaveReq> { using Type = PktLobbyLeaveReqLayout; };
+
+	class PktLobbyLeaveReqView
+	{
+	public:
+		using Layout = PktLobbyLeaveReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyLeaveReqWriter
+	{
+		using Layout = PktLobbyLeaveReqLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyLeaveRes (LOBBY_LEAVE_RES)
+	struct PktLobbyLeaveResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_LEAVE_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktLobbyLeaveRes) == PktLobbyLeaveResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyLeaveRes 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyLeaveRes> { using Type = PktLobbyLeaveResLayout; };
+
+	class PktLobbyLeaveResView
+	{
+	public:
+		using Layout = PktLobbyLeaveResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyLeaveResWriter
+	{
+		using Layout = PktLobbyLeaveResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyChatReq (LOBBY_CHAT_REQ)
+	struct PktLobbyChatReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_CHAT_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MsgLength_Offset = 0;
+		static constexpr int MsgLength_Size = 2;
+		static constexpr int Msg_Offset = MsgLength_Offset + MsgLength_Size;
+		static constexpr int Msg_ElemSize = 1;
+		static constexpr int Msg_MaxCount = MAX_LOBBY_CHAT_MSG_SIZE;
+		static constexpr int MinSize = Msg_Offset;
+		static constexpr int MaxSize = Msg_Offset + Msg_ElemSize * Msg_MaxCount;
+	};
+	static_assert(sizeof(PktLobbyChatReq) == PktLobbyChatReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyChatReq 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyChatReq> { using Type = PktLobbyChatReqLayout; };
+
+	class PktLobbyChatReqView
+	{
+	public:
+		using Layout = PktLobbyChatReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)MsgLength();
+			if (count < 0 || count > Layout::Msg_MaxCount) {
+				return false;
+			}
+			return size >= Layout::Msg_Offset + count * Layout::Msg_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short MsgLength() const { return ReadPacketField<short>(m_pData + Layout::MsgLength_Offset); }
+		const char* Msg() const { return m_pData + Layout::Msg_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyChatReqWriter
+	{
+		using Layout = PktLobbyChatReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short msgLength, const char* pMsg)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::MsgLength_Offset, msgLength);
+
+			auto msgSize = (int)msgLength * Layout::Msg_ElemSize;
+			if ((int)msgLength < 0 || (int)msgLength > Layout::Msg_MaxCount || Layout::Msg_Offset + msgSize > capacity) {
+				return -1;
+			}
+			if (msgSize > 0) {
+				memcpy(pBuffer + Layout::Msg_Offset, pMsg, msgSize);
+			}
+
+			return Layout::Msg_Offset + msgSize;
+		}
+	};
+
+	//- PktLobbyChatRes (LOBBY_CHAT_RES)
+	struct PktLobbyChatResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_CHAT_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktLobbyChatRes) == PktLobbyChatResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyChatRes 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyChatRes> { using Type = PktLobbyChatResLayout; };
+
+	class PktLobbyChatResView
+	{
+	public:
+		using Layout = PktLobbyChatResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyChatResWriter
+	{
+		using Layout = PktLobbyChatResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktLobbyChatNtf (LOBBY_CHAT_NTF)
+	struct PktLobbyChatNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::LOBBY_CHAT_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int ChatCount_Offset = 0;
+		static constexpr int ChatCount_Size = 2;
+		static constexpr int Data_Offset = ChatCount_Offset + ChatCount_Size;
+		static constexpr int Data_ElemSize = 1;
+		static constexpr int Data_MaxCount = MAX_LOBBY_CHAT_NTF_DATA_SIZE;
+		static constexpr int MinSize = Data_Offset;
+		static constexpr int MaxSize = Data_Offset + Data_ElemSize * Data_MaxCount;
+	};
+	static_assert(sizeof(PktLobbyChatNtf) == PktLobbyChatNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktLobbyChatNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktLobbyChatNtf> { using Type = PktLobbyChatNtfLayout; };
+
+	class PktLobbyChatNtfView
+	{
+	public:
+		using Layout = PktLobbyChatNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return size <= Layout::MaxSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ChatCount() const { return ReadPacketField<short>(m_pData + Layout::ChatCount_Offset); }
+		int DataSize() const { return m_Size - Layout::Data_Offset; }
+		const char* Data() const { return m_pData + Layout::Data_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktLobbyChatNtfWriter
+	{
+		using Layout = PktLobbyChatNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short chatCount, const int dataSize, const char* pData)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ChatCount_Offset, chatCount);
+
+			if (dataSize < 0 || dataSize > Layout::Data_MaxCount || Layout::Data_Offset + dataSize > capacity) {
+				return -1;
+			}
+			if (dataSize > 0) {
+				memcpy(pBuffer + Layout::Data_Offset, pData, dataSize);
+			}
+
+			return Layout::Data_Offset + dataSize;
+		}
+	};
+
+	//- PktRoomEnterReq (ROOM_ENTER_REQ)
+	struct PktRoomEnterReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_ENTER_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int IsCreate_Offset = 0;
+		static constexpr int IsCreate_Size = 1;
+		static constexpr int RoomIndex_Offset = IsCreate_Offset + IsCreate_Size;
+		static constexpr int RoomIndex_Size = 2;
+		static constexpr int RoomTitleLength_Offset = RoomIndex_Offset + RoomIndex_Size;
+		static constexpr int RoomTitleLength_Size = 2;
+		static constexpr int RoomTitle_Offset = RoomTitleLength_Offset + RoomTitleLength_Size;
+		static constexpr int RoomTitle_ElemSize = 1;
+		static constexpr int RoomTitle_MaxCount = MAX_ROOM_TITLE_SIZE;
+		static constexpr int MinSize = RoomTitle_Offset;
+		static constexpr int MaxSize = RoomTitle_Offset + RoomTitle_ElemSize * RoomTitle_MaxCount;
+	};
+	static_assert(sizeof(PktRoomEnterReq) == PktRoomEnterReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomEnterReq 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomEnterReq> { using Type = PktRoomEnterReqLayout; };
+
+	class PktRoomEnterReqView
+	{
+	public:
+		using Layout = PktRoomEnterReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)RoomTitleLength();
+			if (count < 0 || count > Layout::RoomTitle_MaxCount) {
+				return false;
+			}
+			return size >= Layout::RoomTitle_Offset + count * Layout::RoomTitle_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		bool IsCreate() const { return ReadPacketField<bool>(m_pData + Layout::IsCreate_Offset); }
+		short RoomIndex() const { return ReadPacketField<short>(m_pData + Layout::RoomIndex_Offset); }
+		short RoomTitleLength() const { return ReadPacketField<short>(m_pData + Layout::RoomTitleLength_Offset); }
+		const char* RoomTitle() const { return m_pData + Layout::RoomTitle_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomEnterReqWriter
+	{
+		using Layout = PktRoomEnterReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const bool isCreate, const short roomIndex, const short roomTitleLength, const char* pRoomTitle)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::IsCreate_Offset, isCreate);
+			WritePacketField(pBuffer + Layout::RoomIndex_Offset, roomIndex);
+			WritePacketField(pBuffer + Layout::RoomTitleLength_Offset, roomTitleLength);
+
+			auto roomTitleSize = (int)roomTitleLength * Layout::RoomTitle_ElemSize;
+			if ((int)roomTitleLength < 0 || (int)roomTitleLength > Layout::RoomTitle_MaxCount || Layout::RoomTitle_Offset + roomTitleSize > capacity) {
+				return -1;
+			}
+			if (roomTitleSize > 0) {
+				memcpy(pBuffer + Layout::RoomTitle_Offset, pRoomTitle, roomTitleSize);
+			}
+
+			return Layout::RoomTitle_Offset + roomTitleSize;
+		}
+	};
+
+	//- PktRoomEnterRes (ROOM_ENTER_RES)
+	struct PktRoomEnterResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_ENTER_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomEnterRes) == PktRoomEnterResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomEnterRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomEnterRes> { using Type = PktRoomEnterResLayout; };
+
+	class PktRoomEnterResView
+	{
+	public:
+		using Layout = PktRoomEnterResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomEnterResWriter
+	{
+		using Layout = PktRoomEnterResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomEnterUserInfoNtf (ROOM_ENTER_NEW_USER_NTF)
+	struct PktRoomEnterUserInfoNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_ENTER_NEW_USER_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MinSize = UserID_Offset + UserID_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomEnterUserInfoNtf) == PktRoomEnterUserInfoNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomEnterUserInfoNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomEnterUserInfoNtf> { using Type = PktRoomEnterUserInfoNtfLayout; };
+
+	class PktRoomEnterUserInfoNtfView
+	{
+	public:
+		using Layout = PktRoomEnterUserInfoNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* UserID() const { return m_pData + Layout::UserID_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomEnterUserInfoNtfWriter
+	{
+		using Layout = PktRoomEnterUserInfoNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* pszUserID)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::UserID_Offset, Layout::UserID_Size, pszUserID);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomLeaveReq (ROOM_LEAVE_REQ)
+	struct PktRoomLeaveReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_LEAVE_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktRoomLeaveReq> { using Type = PktRoomLeaveReqLayout; };
+
+	class PktRoomLeaveReqView
+	{
+	public:
+		using Layout = PktRoomLeaveReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomLeaveReqWriter
+	{
+		using Layout = PktRoomLeaveReqLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomLeaveRes (ROOM_LEAVE_RES)
+	struct PktRoomLeaveResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_LEAVE_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomLeaveRes) == PktRoomLeaveResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomLeaveRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomLeaveRes> { using Type = PktRoomLeaveResLayout; };
+
+	class PktRoomLeaveResView
+	{
+	public:
+		using Layout = PktRoomLeaveResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomLeaveResWriter
+	{
+		using Layout = PktRoomLeaveResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomLeaveUserInfoNtf (ROOM_LEAVE_USER_NTF)
+	struct PktRoomLeaveUserInfoNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_LEAVE_USER_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MinSize = UserID_Offset + UserID_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomLeaveUserInfoNtf) == PktRoomLeaveUserInfoNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomLeaveUserInfoNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomLeaveUserInfoNtf> { using Type = PktRoomLeaveUserInfoNtfLayout; };
+
+	class PktRoomLeaveUserInfoNtfView
+	{
+	public:
+		using Layout = PktRoomLeaveUserInfoNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* UserID() const { return m_pData + Layout::UserID_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomLeaveUserInfoNtfWriter
+	{
+		using Layout = PktRoomLeaveUserInfoNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* pszUserID)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::UserID_Offset, Layout::UserID_Size, pszUserID);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomChatReq (ROOM_CHAT_REQ)
+	struct PktRoomChatReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_CHAT_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MsgLength_Offset = 0;
+		static constexpr int MsgLength_Size = 2;
+		static constexpr int Msg_Offset = MsgLength_Offset + MsgLength_Size;
+		static constexpr int Msg_ElemSize = 1;
+		static constexpr int Msg_MaxCount = MAX_ROOM_CHAT_MSG_SIZE;
+		static constexpr int MinSize = Msg_Offset;
+		static constexpr int MaxSize = Msg_Offset + Msg_ElemSize * Msg_MaxCount;
+	};
+	static_assert(sizeof(PktRoomChatReq) == PktRoomChatReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomChatReq 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomChatReq> { using Type = PktRoomChatReqLayout; };
+
+	class PktRoomChatReqView
+	{
+	public:
+		using Layout = PktRoomChatReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)MsgLength();
+			if (count < 0 || count > Layout::Msg_MaxCount) {
+				return false;
+			}
+			return size >= Layout::Msg_Offset + count * Layout::Msg_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short MsgLength() const { return ReadPacketField<short>(m_pData + Layout::MsgLength_Offset); }
+		const char* Msg() const { return m_pData + Layout::Msg_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomChatReqWriter
+	{
+		using Layout = PktRoomChatReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short msgLength, const char* pMsg)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::MsgLength_Offset, msgLength);
+
+			auto msgSize = (int)msgLength * Layout::Msg_ElemSize;
+			if ((int)msgLength < 0 || (int)msgLength > Layout::Msg_MaxCount || Layout::Msg_Offset + msgSize > capacity) {
+				return -1;
+			}
+			if (msgSize > 0) {
+				memcpy(pBuffer + Layout::Msg_Offset, pMsg, msgSize);
+			}
+
+			return Layout::Msg_Offset + msgSize;
+		}
+	};
+
+	//- PktRoomChatRes (ROOM_CHAT_RES)
+	struct PktRoomChatResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_CHAT_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomChatRes) == PktRoomChatResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomChatRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomChatRes> { using Type = PktRoomChatResLayout; };
+
+	class PktRoomChatResView
+	{
+	public:
+		using Layout = PktRoomChatResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomChatResWriter
+	{
+		using Layout = PktRoomChatResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomChatNtf (ROOM_CHAT_NTF)
+	struct PktRoomChatNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_CHAT_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MsgLength_Offset = UserID_Offset + UserID_Size;
+		static constexpr int MsgLength_Size = 2;
+		static constexpr int Msg_Offset = MsgLength_Offset + MsgLength_Size;
+		static constexpr int Msg_ElemSize = 1;
+		static constexpr int Msg_MaxCount = MAX_ROOM_CHAT_MSG_SIZE;
+		static constexpr int MinSize = Msg_Offset;
+		static constexpr int MaxSize = Msg_Offset + Msg_ElemSize * Msg_MaxCount;
+	};
+	static_assert(sizeof(PktRoomChatNtf) == PktRoomChatNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomChatNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomChatNtf> { using Type = PktRoomChatNtfLayout; };
+
+	class PktRoomChatNtfView
+	{
+	public:
+		using Layout = PktRoomChatNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)MsgLength();
+			if (count < 0 || count > Layout::Msg_MaxCount) {
+				return false;
+			}
+			return size >= Layout::Msg_Offset + count * Layout::Msg_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* UserID() const { return m_pData + Layout::UserID_Offset; }
+		short MsgLength() const { return ReadPacketField<short>(m_pData + Layout::MsgLength_Offset); }
+		const char* Msg() const { return m_pData + Layout::Msg_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomChatNtfWriter
+	{
+		using Layout = PktRoomChatNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* pszUserID, const short msgLength, const char* pMsg)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::UserID_Offset, Layout::UserID_Size, pszUserID);
+			WritePacketField(pBuffer + Layout::MsgLength_Offset, msgLength);
+
+			auto msgSize = (int)msgLength * Layout::Msg_ElemSize;
+			if ((int)msgLength < 0 || (int)msgLength > Layout::Msg_MaxCount || Layout::Msg_Offset + msgSize > capacity) {
+				return -1;
+			}
+			if (msgSize > 0) {
+				memcpy(pBuffer + Layout::Msg_Offset, pMsg, msgSize);
+			}
+
+			return Layout::Msg_Offset + msgSize;
+		}
+	};
+
+	//- PktRoomQuickMatchReq (ROOM_QUICK_MATCH_REQ)
+	struct PktRoomQuickMatchReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_QUICK_MATCH_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktRoomQuickMatchReq> { using Type = PktRoomQuickMatchReqLayout; };
+
+	class PktRoomQuickMatchReqView
+	{
+	public:
+		using Layout = PktRoomQuickMatchReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomQuickMatchReqWriter
+	{
+		using Layout = PktRoomQuickMatchReqLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomQuickMatchRes (ROOM_QUICK_MATCH_RES)
+	struct PktRoomQuickMatchResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_QUICK_MATCH_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomQuickMatchRes) == PktRoomQuickMatchResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomQuickMatchRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomQuickMatchRes> { using Type = PktRoomQuickMatchResLayout; };
+
+	class PktRoomQuickMatchResView
+	{
+	public:
+		using Layout = PktRoomQuickMatchResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomQuickMatchResWriter
+	{
+		using Layout = PktRoomQuickMatchResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomQuickMatchNtf (ROOM_QUICK_MATCH_NTF)
+	struct PktRoomQuickMatchNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_QUICK_MATCH_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int RoomIndex_Offset = 0;
+		static constexpr int RoomIndex_Size = 2;
+		static constexpr int UserCount_Offset = RoomIndex_Offset + RoomIndex_Size;
+		static constexpr int UserCount_Size = 2;
+		static constexpr int UserIDList_Offset = UserCount_Offset + UserCount_Size;
+		static constexpr int UserIDList_ElemSize = (MAX_USER_ID_SIZE + 1);
+		static constexpr int UserIDList_MaxCount = MAX_ROOM_USER_COUNT;
+		static constexpr int MinSize = UserIDList_Offset;
+		static constexpr int MaxSize = UserIDList_Offset + UserIDList_ElemSize * UserIDList_MaxCount;
+	};
+	static_assert(sizeof(PktRoomQuickMatchNtf) == PktRoomQuickMatchNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomQuickMatchNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomQuickMatchNtf> { using Type = PktRoomQuickMatchNtfLayout; };
+
+	class PktRoomQuickMatchNtfView
+	{
+	public:
+		using Layout = PktRoomQuickMatchNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)UserCount();
+			if (count < 0 || count > Layout::UserIDList_MaxCount) {
+				return false;
+			}
+			return size >= Layout::UserIDList_Offset + count * Layout::UserIDList_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short RoomIndex() const { return ReadPacketField<short>(m_pData + Layout::RoomIndex_Offset); }
+		short UserCount() const { return ReadPacketField<short>(m_pData + Layout::UserCount_Offset); }
+		const char* UserIDList(const int index) const { return m_pData + Layout::UserIDList_Offset + index * Layout::UserIDList_ElemSize; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomQuickMatchNtfWriter
+	{
+		using Layout = PktRoomQuickMatchNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short roomIndex, const short userCount, const char* pUserIDList)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::RoomIndex_Offset, roomIndex);
+			WritePacketField(pBuffer + Layout::UserCount_Offset, userCount);
+
+			auto userIDListSize = (int)userCount * Layout::UserIDList_ElemSize;
+			if ((int)userCount < 0 || (int)userCount > Layout::UserIDList_MaxCount || Layout::UserIDList_Offset + userIDListSize > capacity) {
+				return -1;
+			}
+			if (userIDListSize > 0) {
+				memcpy(pBuffer + Layout::UserIDList_Offset, pUserIDList, userIDListSize);
+			}
+
+			return Layout::UserIDList_Offset + userIDListSize;
+		}
+	};
+
+	//- PktRoomMaterGameStartReq (ROOM_MASTER_GAME_START_REQ)
+	struct PktRoomMaterGameStartReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_MASTER_GAME_START_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktRoomMaterGameStartReq> { using Type = PktRoomMaterGameStartReqLayout; };
+
+	class PktRoomMaterGameStartReqView
+	{
+	public:
+		using Layout = PktRoomMaterGameStartReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomMaterGameStartReqWriter
+	{
+		using Layout = PktRoomMaterGameStartReqLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomMaterGameStartRes (ROOM_MASTER_GAME_START_RES)
+	struct PktRoomMaterGameStartResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_MASTER_GAME_START_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomMaterGameStartRes) == PktRoomMaterGameStartResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomMaterGameStartRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomMaterGameStartRes> { using Type = PktRoomMaterGameStartResLayout; };
+
+	class PktRoomMaterGameStartResView
+	{
+	public:
+		using Layout = PktRoomMaterGameStartResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomMaterGameStartResWriter
+	{
+		using Layout = PktRoomMaterGameStartResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomMaterGameStartNtf (ROOM_MASTER_GAME_START_NTF)
+	struct PktRoomMaterGameStartNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_MASTER_GAME_START_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktRoomMaterGameStartNtf> { using Type = PktRoomMaterGameStartNtfLayout; };
+
+	class PktRoomMaterGameStartNtfView
+	{
+	public:
+		using Layout = PktRoomMaterGameStartNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomMaterGameStartNtfWriter
+	{
+		using Layout = PktRoomMaterGameStartNtfLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameStartReq (ROOM_GAME_START_REQ)
+	struct PktRoomGameStartReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_START_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int MinSize = 0;
+		static constexpr int MaxSize = MinSize;
+	};
+	template <> struct PacketLayoutOf<PktRoomGameStartReq> { using Type = PktRoomGameStartReqLayout; };
+
+	class PktRoomGameStartReqView
+	{
+	public:
+		using Layout = PktRoomGameStartReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameStartReqWriter
+	{
+		using Layout = PktRoomGameStartReqLayout;
+
+		static int Encode(char*, const int capacity)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameStartRes (ROOM_GAME_START_RES)
+	struct PktRoomGameStartResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_START_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameStartRes) == PktRoomGameStartResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameStartRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameStartRes> { using Type = PktRoomGameStartResLayout; };
+
+	class PktRoomGameStartResView
+	{
+	public:
+		using Layout = PktRoomGameStartResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameStartResWriter
+	{
+		using Layout = PktRoomGameStartResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameStartNtf (ROOM_GAME_START_NTF)
+	struct PktRoomGameStartNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_START_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MinSize = UserID_Offset + UserID_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameStartNtf) == PktRoomGameStartNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameStartNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameStartNtf> { using Type = PktRoomGameStartNtfLayout; };
+
+	class PktRoomGameStartNtfView
+	{
+	public:
+		using Layout = PktRoomGameStartNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* UserID() const { return m_pData + Layout::UserID_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameStartNtfWriter
+	{
+		using Layout = PktRoomGameStartNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* pszUserID)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::UserID_Offset, Layout::UserID_Size, pszUserID);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameBeginNtf (ROOM_GAME_BEGIN_NTF)
+	struct PktRoomGameBeginNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_BEGIN_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameBeginNtf) == PktRoomGameBeginNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameBeginNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameBeginNtf> { using Type = PktRoomGameBeginNtfLayout; };
+
+	class PktRoomGameBeginNtfView
+	{
+	public:
+		using Layout = PktRoomGameBeginNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameBeginNtfWriter
+	{
+		using Layout = PktRoomGameBeginNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- GameResultInfo
+	struct GameResultInfoLayout
+	{
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int Select_Offset = UserID_Offset + UserID_Size;
+		static constexpr int Select_Size = 1;
+		static constexpr int Result_Offset = Select_Offset + Select_Size;
+		static constexpr int Result_Size = 1;
+		static constexpr int Size = Result_Offset + Result_Size;
+	};
+	static_assert(sizeof(GameResultInfo) == GameResultInfoLayout::Size, "Packet.idl 과 Packet.h 의 GameResultInfo 가 다르다");
+
+	//- PktRoomGameRoundStartNtf (ROOM_GAME_ROUND_START_NTF)
+	struct PktRoomGameRoundStartNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_ROUND_START_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int RoundNo_Offset = 0;
+		static constexpr int RoundNo_Size = 2;
+		static constexpr int SelectMilliSec_Offset = RoundNo_Offset + RoundNo_Size;
+		static constexpr int SelectMilliSec_Size = 4;
+		static constexpr int PlayerCount_Offset = SelectMilliSec_Offset + SelectMilliSec_Size;
+		static constexpr int PlayerCount_Size = 2;
+		static constexpr int MinSize = PlayerCount_Offset + PlayerCount_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameRoundStartNtf) == PktRoomGameRoundStartNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameRoundStartNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameRoundStartNtf> { using Type = PktRoomGameRoundStartNtfLayout; };
+
+	class PktRoomGameRoundStartNtfView
+	{
+	public:
+		using Layout = PktRoomGameRoundStartNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short RoundNo() const { return ReadPacketField<short>(m_pData + Layout::RoundNo_Offset); }
+		int SelectMilliSec() const { return ReadPacketField<int>(m_pData + Layout::SelectMilliSec_Offset); }
+		short PlayerCount() const { return ReadPacketField<short>(m_pData + Layout::PlayerCount_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameRoundStartNtfWriter
+	{
+		using Layout = PktRoomGameRoundStartNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short roundNo, const int selectMilliSec, const short playerCount)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::RoundNo_Offset, roundNo);
+			WritePacketField(pBuffer + Layout::SelectMilliSec_Offset, selectMilliSec);
+			WritePacketField(pBuffer + Layout::PlayerCount_Offset, playerCount);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameResultNtf (ROOM_GAME_RESULT_NTF)
+	struct PktRoomGameResultNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_RESULT_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int RoundNo_Offset = ErrorCode_Offset + 2;
+		static constexpr int RoundNo_Size = 2;
+		static constexpr int IsGameEnd_Offset = RoundNo_Offset + RoundNo_Size;
+		static constexpr int IsGameEnd_Size = 1;
+		static constexpr int PlayerCount_Offset = IsGameEnd_Offset + IsGameEnd_Size;
+		static constexpr int PlayerCount_Size = 2;
+		static constexpr int PlayerList_Offset = PlayerCount_Offset + PlayerCount_Size;
+		static constexpr int PlayerList_ElemSize = GameResultInfoLayout::Size;
+		static constexpr int PlayerList_MaxCount = MAX_ROOM_USER_COUNT;
+		static constexpr int MinSize = PlayerList_Offset;
+		static constexpr int MaxSize = PlayerList_Offset + PlayerList_ElemSize * PlayerList_MaxCount;
+	};
+	static_assert(sizeof(PktRoomGameResultNtf) == PktRoomGameResultNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameResultNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameResultNtf> { using Type = PktRoomGameResultNtfLayout; };
+
+	class PktRoomGameResultNtfView
+	{
+	public:
+		using Layout = PktRoomGameResultNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)PlayerCount();
+			if (count < 0 || count > Layout::PlayerList_MaxCount) {
+				return false;
+			}
+			return size >= Layout::PlayerList_Offset + count * Layout::PlayerList_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		short RoundNo() const { return ReadPacketField<short>(m_pData + Layout::RoundNo_Offset); }
+		bool IsGameEnd() const { return ReadPacketField<bool>(m_pData + Layout::IsGameEnd_Offset); }
+		short PlayerCount() const { return ReadPacketField<short>(m_pData + Layout::PlayerCount_Offset); }
+		GameResultInfo PlayerList(const int index) const { return ReadPacketField<GameResultInfo>(m_pData + Layout::PlayerList_Offset + index * Layout::PlayerList_ElemSize); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameResultNtfWriter
+	{
+		using Layout = PktRoomGameResultNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const short roundNo, const bool isGameEnd, const short playerCount, const GameResultInfo* pPlayerList)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::RoundNo_Offset, roundNo);
+			WritePacketField(pBuffer + Layout::IsGameEnd_Offset, isGameEnd);
+			WritePacketField(pBuffer + Layout::PlayerCount_Offset, playerCount);
+
+			auto playerListSize = (int)playerCount * Layout::PlayerList_ElemSize;
+			if ((int)playerCount < 0 || (int)playerCount > Layout::PlayerList_MaxCount || Layout::PlayerList_Offset + playerListSize > capacity) {
+				return -1;
+			}
+			if (playerListSize > 0) {
+				memcpy(pBuffer + Layout::PlayerList_Offset, pPlayerList, playerListSize);
+			}
+
+			return Layout::PlayerList_Offset + playerListSize;
+		}
+	};
+
+	//- PktRoomGameSelectReq (ROOM_GAME_SELECT_REQ)
+	struct PktRoomGameSelectReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_SELECT_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int Select_Offset = 0;
+		static constexpr int Select_Size = 1;
+		static constexpr int MinSize = Select_Offset + Select_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameSelectReq) == PktRoomGameSelectReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameSelectReq 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameSelectReq> { using Type = PktRoomGameSelectReqLayout; };
+
+	class PktRoomGameSelectReqView
+	{
+	public:
+		using Layout = PktRoomGameSelectReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		int8_t Select() const { return ReadPacketField<int8_t>(m_pData + Layout::Select_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameSelectReqWriter
+	{
+		using Layout = PktRoomGameSelectReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const int8_t select)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::Select_Offset, select);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameSelectRes (ROOM_GAME_SELECT_RES)
+	struct PktRoomGameSelectResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_SELECT_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int MinSize = ErrorCode_Offset + 2;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameSelectRes) == PktRoomGameSelectResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameSelectRes 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameSelectRes> { using Type = PktRoomGameSelectResLayout; };
+
+	class PktRoomGameSelectResView
+	{
+	public:
+		using Layout = PktRoomGameSelectResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameSelectResWriter
+	{
+		using Layout = PktRoomGameSelectResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktRoomGameSelectNtf (ROOM_GAME_SELECT_NTF)
+	struct PktRoomGameSelectNtfLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::ROOM_GAME_SELECT_NTF;
+		static constexpr bool IsOptional = false;
+		static constexpr int UserID_Offset = 0;
+		static constexpr int UserID_Size = (MAX_USER_ID_SIZE + 1);
+		static constexpr int MinSize = UserID_Offset + UserID_Size;
+		static constexpr int MaxSize = MinSize;
+	};
+	static_assert(sizeof(PktRoomGameSelectNtf) == PktRoomGameSelectNtfLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktRoomGameSelectNtf 가 다르다");
+	template <> struct PacketLayoutOf<PktRoomGameSelectNtf> { using Type = PktRoomGameSelectNtfLayout; };
+
+	class PktRoomGameSelectNtfView
+	{
+	public:
+		using Layout = PktRoomGameSelectNtfLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+			return true;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		const char* UserID() const { return m_pData + Layout::UserID_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktRoomGameSelectNtfWriter
+	{
+		using Layout = PktRoomGameSelectNtfLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const char* pszUserID)
+		{
+			if (capacity < Layout::MaxSize) {
+				return -1;
+			}
+
+			CopyPacketString(pBuffer + Layout::UserID_Offset, Layout::UserID_Size, pszUserID);
+
+			return Layout::MaxSize;
+		}
+	};
+
+	//- PktDevEchoReq (DEV_ECHO_REQ)
+	struct PktDevEchoReqLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::DEV_ECHO_REQ;
+		static constexpr bool IsOptional = false;
+		static constexpr int DataSize_Offset = 0;
+		static constexpr int DataSize_Size = 2;
+		static constexpr int Datas_Offset = DataSize_Offset + DataSize_Size;
+		static constexpr int Datas_ElemSize = 1;
+		static constexpr int Datas_MaxCount = DEV_ECHO_DATA_MAX_SIZE;
+		static constexpr int MinSize = Datas_Offset;
+		static constexpr int MaxSize = Datas_Offset + Datas_ElemSize * Datas_MaxCount;
+	};
+	static_assert(sizeof(PktDevEchoReq) == PktDevEchoReqLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktDevEchoReq 가 다르다");
+	template <> struct PacketLayoutOf<PktDevEchoReq> { using Type = PktDevEchoReqLayout; };
+
+	class PktDevEchoReqView
+	{
+	public:
+		using Layout = PktDevEchoReqLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)DataSize();
+			if (count < 0 || count > Layout::Datas_MaxCount) {
+				return false;
+			}
+			return size >= Layout::Datas_Offset + count * Layout::Datas_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short DataSize() const { return ReadPacketField<short>(m_pData + Layout::DataSize_Offset); }
+		const char* Datas() const { return m_pData + Layout::Datas_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktDevEchoReqWriter
+	{
+		using Layout = PktDevEchoReqLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short dataSize, const char* pDatas)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::DataSize_Offset, dataSize);
+
+			auto datasSize = (int)dataSize * Layout::Datas_ElemSize;
+			if ((int)dataSize < 0 || (int)dataSize > Layout::Datas_MaxCount || Layout::Datas_Offset + datasSize > capacity) {
+				return -1;
+			}
+			if (datasSize > 0) {
+				memcpy(pBuffer + Layout::Datas_Offset, pDatas, datasSize);
+			}
+
+			return Layout::Datas_Offset + datasSize;
+		}
+	};
+
+	//- PktDevEchoRes (DEV_ECHO_RES)
+	struct PktDevEchoResLayout
+	{
+		static constexpr PACKET_ID Id = PACKET_ID::DEV_ECHO_RES;
+		static constexpr bool IsOptional = false;
+		static constexpr int ErrorCode_Offset = 0;
+		static constexpr int DataSize_Offset = ErrorCode_Offset + 2;
+		static constexpr int DataSize_Size = 2;
+		static constexpr int Datas_Offset = DataSize_Offset + DataSize_Size;
+		static constexpr int Datas_ElemSize = 1;
+		static constexpr int Datas_MaxCount = DEV_ECHO_DATA_MAX_SIZE;
+		static constexpr int MinSize = Datas_Offset;
+		static constexpr int MaxSize = Datas_Offset + Datas_ElemSize * Datas_MaxCount;
+	};
+	static_assert(sizeof(PktDevEchoRes) == PktDevEchoResLayout::MaxSize, "Packet.idl 과 Packet.h 의 PktDevEchoRes 가 다르다");
+	template <> struct PacketLayoutOf<PktDevEchoRes> { using Type = PktDevEchoResLayout; };
+
+	class PktDevEchoResView
+	{
+	public:
+		using Layout = PktDevEchoResLayout;
+
+		bool Parse(const char* pData, const int size)
+		{
+			m_pData = pData;
+			m_Size = size;
+			if (size < Layout::MinSize) {
+				return false;
+			}
+
+			auto count = (int)DataSize();
+			if (count < 0 || count > Layout::Datas_MaxCount) {
+				return false;
+			}
+			return size >= Layout::Datas_Offset + count * Layout::Datas_ElemSize;
+		}
+
+		const char* GetBody() const { return m_pData; }
+		int GetBodySize() const { return m_Size; }
+
+		short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }
+		short DataSize() const { return ReadPacketField<short>(m_pData + Layout::DataSize_Offset); }
+		const char* Datas() const { return m_pData + Layout::Datas_Offset; }
+
+	private:
+		const char* m_pData = nullptr;
+		int m_Size = 0;
+	};
+
+	struct PktDevEchoResWriter
+	{
+		using Layout = PktDevEchoResLayout;
+
+		static int Encode(char* pBuffer, const int capacity, const short errorCode, const short dataSize, const char* pDatas)
+		{
+			if (capacity < Layout::MinSize) {
+				return -1;
+			}
+
+			WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);
+			WritePacketField(pBuffer + Layout::DataSize_Offset, dataSize);
+
+			auto datasSize = (int)dataSize * Layout::Datas_ElemSize;
+			if ((int)dataSize < 0 || (int)dataSize > Layout::Datas_MaxCount || Layout::Datas_Offset + datasSize > capacity) {
+				return -1;
+			}
+			if (datasSize > 0) {
+				memcpy(pBuffer + Layout::Datas_Offset, pDatas, datasSize);
+			}
+
+			return Layout::Datas_Offset + datasSize;
+		}
+	};
+
+	// 받은 Body 가 패킷 정의에 맞는지 검사한다. 스키마에 없는 패킷은 통과시킨다.
+	inline bool IsValidPacketBody(const short packetId, const char* pData, const int size)
+	{
+		switch ((PACKET_ID)packetId)
+		{
+		case PACKET_ID::LOGIN_IN_REQ: return PktLogInReqView().Parse(pData, size);
+		case PACKET_ID::LOGIN_IN_RES: return PktLogInResView().Parse(pData, size);
+		case PACKET_ID::LOBBY_LIST_REQ: return PktLobbyListReqView().Parse(pData, size);
+		case PACKET_ID::LOBBY_LIST_RES: return PktLobbyListResView().Parse(pData, size);
+		case PACKET_ID::LOBBY_ENTER_REQ: return PktLobbyEnterReqView().Parse(pData, size);
+		case PACKET_ID::LOBBY_ENTER_RES: return PktLobbyEnterResView().Parse(pData, size);
+		case PACKET_ID::ROOM_LIST_REQ: return PktRoomListReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_LIST_RES: return PktRoomListResView().Parse(pData, size);
+		case PACKET_ID::ROOM_CHANGED_INFO_NTF: return PktRoomChangedInfoNtfView().Parse(pData, size);
+		case PACKET_ID::LOBBY_LEAVE_REQ: return PktLobbyLeaveReqView().Parse(pData, size);
+		case PACKET_ID::LOBBY_LEAVE_RES: return PktLobbyLeaveResView().Parse(pData, size);
+		case PACKET_ID::LOBBY_CHAT_REQ: return PktLobbyChatReqView().Parse(pData, size);
+		case PACKET_ID::LOBBY_CHAT_RES: return PktLobbyChatResView().Parse(pData, size);
+		case PACKET_ID::LOBBY_CHAT_NTF: return PktLobbyChatNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_ENTER_REQ: return PktRoomEnterReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_ENTER_RES: return PktRoomEnterResView().Parse(pData, size);
+		case PACKET_ID::ROOM_ENTER_NEW_USER_NTF: return PktRoomEnterUserInfoNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_LEAVE_REQ: return PktRoomLeaveReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_LEAVE_RES: return PktRoomLeaveResView().Parse(pData, size);
+		case PACKET_ID::ROOM_LEAVE_USER_NTF: return PktRoomLeaveUserInfoNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_CHAT_REQ: return PktRoomChatReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_CHAT_RES: return PktRoomChatResView().Parse(pData, size);
+		case PACKET_ID::ROOM_CHAT_NTF: return PktRoomChatNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_QUICK_MATCH_REQ: return PktRoomQuickMatchReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_QUICK_MATCH_RES: return PktRoomQuickMatchResView().Parse(pData, size);
+		case PACKET_ID::ROOM_QUICK_MATCH_NTF: return PktRoomQuickMatchNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_MASTER_GAME_START_REQ: return PktRoomMaterGameStartReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_MASTER_GAME_START_RES: return PktRoomMaterGameStartResView().Parse(pData, size);
+		case PACKET_ID::ROOM_MASTER_GAME_START_NTF: return PktRoomMaterGameStartNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_START_REQ: return PktRoomGameStartReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_START_RES: return PktRoomGameStartResView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_START_NTF: return PktRoomGameStartNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_BEGIN_NTF: return PktRoomGameBeginNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_ROUND_START_NTF: return PktRoomGameRoundStartNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_RESULT_NTF: return PktRoomGameResultNtfView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_SELECT_REQ: return PktRoomGameSelectReqView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_SELECT_RES: return PktRoomGameSelectResView().Parse(pData, size);
+		case PACKET_ID::ROOM_GAME_SELECT_NTF: return PktRoomGameSelectNtfView().Parse(pData, size);
+		case PACKET_ID::DEV_ECHO_REQ: return PktDevEchoReqView().Parse(pData, size);
+		case PACKET_ID::DEV_ECHO_RES: return PktDevEchoResView().Parse(pData, size);
+		default: return true;
+		}
+	}
+
+	// 요청 패킷에 대한 응답 패킷 ID. 응답이 없으면 0.
+	inline short GetPacketResponseId(const short packetId)
+	{
+		switch ((PACKET_ID)packetId)
+		{
+		case PACKET_ID::LOGIN_IN_REQ: return (short)PACKET_ID::LOGIN_IN_RES;
+		case PACKET_ID::LOBBY_LIST_REQ: return (short)PACKET_ID::LOBBY_LIST_RES;
+		case PACKET_ID::LOBBY_ENTER_REQ: return (short)PACKET_ID::LOBBY_ENTER_RES;
+		case PACKET_ID::ROOM_LIST_REQ: return (short)PACKET_ID::ROOM_LIST_RES;
+		case PACKET_ID::LOBBY_LEAVE_REQ: return (short)PACKET_ID::LOBBY_LEAVE_RES;
+		case PACKET_ID::LOBBY_CHAT_REQ: return (short)PACKET_ID::LOBBY_CHAT_RES;
+		case PACKET_ID::ROOM_ENTER_REQ: return (short)PACKET_ID::ROOM_ENTER_RES;
+		case PACKET_ID::ROOM_LEAVE_REQ: return (short)PACKET_ID::ROOM_LEAVE_RES;
+		case PACKET_ID::ROOM_CHAT_REQ: return (short)PACKET_ID::ROOM_CHAT_RES;
+		case PACKET_ID::ROOM_QUICK_MATCH_REQ: return (short)PACKET_ID::ROOM_QUICK_MATCH_RES;
+		case PACKET_ID::ROOM_MASTER_GAME_START_REQ: return (short)PACKET_ID::ROOM_MASTER_GAME_START_RES;
+		case PACKET_ID::ROOM_GAME_START_REQ: return (short)PACKET_ID::ROOM_GAME_START_RES;
+		case PACKET_ID::ROOM_GAME_SELECT_REQ: return (short)PACKET_ID::ROOM_GAME_SELECT_RES;
+		case PACKET_ID::DEV_ECHO_REQ: return (short)PACKET_ID::DEV_ECHO_RES;
+		default: return 0;
+		}
+	}
+}
@@ -0,0 +1,310 @@
+﻿#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "../ServerNetLib/ILog.h"
+#include "../ServerNetLib/NetStats.h"
+#include "ServerMetrics.h"
+#include "AdminServer.h"
+
+using LOG_TYPE = NServerNetLib::LOG_TYPE;
+
+namespace NLogicLib
+{
+	namespace
+	{
+		void AppendFormat(std::string& out, const char* pFormat, ...)
+		{
+			char szText[512];
+
+			va_list args;
+			va_start(args, pFormat);
+			auto len = vsnprintf(szText, sizeof(szText), pFormat, args);
+			va_end(args);
+
+			if (len > 0) {
+				out.append(szText, len < (int)sizeof(szText) ? len : (int)sizeof(szText) - 1);
+			}
+		}
+
+		int64_t Load(const std::atomic<int64_t>& value) { return value.load(std::memory_order_relaxed); }
+		int Load(const std::atomic<int>& value) { return value.load(std::memory_order_relaxed); }
+	}
+
+	AdminServer::AdminServer() {}
+
+	AdminServer::~AdminServer()
+	{
+		Stop();
+	}
+
+#ifdef _WIN32
+
+	bool AdminServer::Start(const char* pSocketPath, ServerMetrics* pMetrics, NetStats* pNetStats, ILog* pLogger)
+	{
+		pLogger->Write(LOG_TYPE::L_WARN, "%s | Admin socket is not supported on Windows.", __FUNCTION__);
+		return false;
+	}
+
+	void AdminServer::Stop() {}
+	void AdminServer::Run() {}
+	void AdminServer::ServeClient(const int clientFD) {}
+
+#else
+
+	bool AdminServer::Start(const char* pSocketPath, ServerMetrics* pMetrics, NetStats* pNetStats, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefMetrics = pMetrics;
+		m_pRefNetStats = pNetStats;
+		m_SocketPath = pSocketPath;
+
+		sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		if (m_SocketPath.size() >= sizeof(addr.sun_path))
+		{
+			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Admin socket path too long. %s", __FUNCTION__, pSocketPath);
+			return false;
+		}
+		memcpy(addr.sun_path, m_SocketPath.c_str(), m_SocketPath.size());
+
+		m_ListenFD = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (m_ListenFD < 0)
+		{
+			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Admin socket create fail.", __FUNCTION__);
+			return false;
+		}
+
+		// 이전 실행에서 남은 소켓 파일이 있으면 bind가 실패하므로 지운다.
+		unlink(m_SocketPath.c_str());
+
+		if (bind(m_ListenFD, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(m_ListenFD, 8) < 0)
+		{
+			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Admin socket bind/listen fail. %s", __FUNCTION__, pSocketPath);
+			close(m_ListenFD);
+			m_ListenFD = -1;
+			return false;
+		}
+
+		m_IsRun = true;
+		m_Thread = std::thread([this]() { Run(); });
+
+		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | Admin socket listen. %s", __FUNCTION__, pSocketPath);
+		return true;
+	}
+
+	void AdminServer::Stop()
+	{
+		if (m_IsRun.exchange(false) == false) {
+			return;
+		}
+
+		if (m_Thread.joinable()) {
+			m_Thread.join();
+		}
+
+		close(m_ListenFD);
+		m_ListenFD = -1;
+		unlink(m_SocketPath.c_str());
+	}
+
+	void AdminServer::Run()
+	{
+		// 패킷 처리 스레드와 CPU를 다투지 않도록 가장 낮은 우선순위로 돈다.
+		sched_param param;
+		param.sched_priority = 0;
+		pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+		while (m_IsRun)
+		{
+			pollfd pfd{ m_ListenFD, POLLIN, 0 };
+			if (poll(&pfd, 1, 200) <= 0) {
+				continue;
+			}
+
+			auto clientFD = accept(m_ListenFD, nullptr, nullptr);
+			if (clientFD < 0) {
+				continue;
+			}
+
+			ServeClient(clientFD);
+			close(clientFD);
+		}
+	}
+
+	void AdminServer::ServeClient(const int clientFD)
+	{
+		// 요청은 선택 사항이다. 잠깐 기다려 보고 아무것도 안 오면 Prometheus 형식으로 보낸다.
+		char request[256] = { 0, };
+		pollfd pfd{ clientFD, POLLIN, 0 };
+		if (poll(&pfd, 1, 100) > 0) {
+			recv(clientFD, request, sizeof(request) - 1, 0);
+		}
+
+		auto isHttp = strncmp(request, "GET ", 4) == 0;
+		auto isPlainText = strncmp(request, "text", 4) == 0 || (isHttp && strstr(request, "/text") != nullptr);
+
+		auto body = isPlainText ? MakePlainText() : MakePrometheusText();
+
+		std::string response;
+		if (isHttp)
+		{
+			AppendFormat(response, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %d\r\n\r\n", (int)body.size());
+		}
+		response += body;
+
+		size_t sent = 0;
+		while (sent < response.size())
+		{
+			auto ret = send(clientFD, response.c_str() + sent, response.size() - sent, MSG_NOSIGNAL);
+			if (ret <= 0) {
+				break;
+			}
+			sent += (size_t)ret;
+		}
+	}
+
+#endif
+
+	std::string AdminServer::MakePrometheusText()
+	{
+		std::string out;
+		out.reserve(16 * 1024);
+
+		auto& net = *m_pRefNetStats;
+		AppendFormat(out, "# TYPE crossserver_net_accept_total counter\ncrossserver_net_accept_total %lld\n", (long long)Load(net.AcceptCount));
+		AppendFormat(out, "# TYPE crossserver_net_close_total counter\ncrossserver_net_close_total %lld\n", (long long)Load(net.CloseCount));
+		AppendFormat(out, "# TYPE crossserver_net_recv_bytes_total counter\ncrossserver_net_recv_bytes_total %lld\n", (long long)Load(net.RecvBytes));
+		AppendFormat(out, "# TYPE crossserver_net_send_bytes_total counter\ncrossserver_net_send_bytes_total %lld\n", (long long)Load(net.SendBytes));
+		AppendFormat(out, "# TYPE crossserver_net_recv_packets_total counter\ncrossserver_net_recv_packets_total %lld\n", (long long)Load(net.RecvPacketCount));
+		AppendFormat(out, "# TYPE crossserver_net_send_packets_total counter\ncrossserver_net_send_packets_total %lld\n", (long long)Load(net.SendPacketCount));
+		AppendFormat(out, "# TYPE crossserver_net_send_calls_total counter\ncrossserver_net_send_calls_total %lld\n", (long long)Load(net.SendCallCount));
+		AppendFormat(out, "# TYPE crossserver_net_send_buffer_full_total counter\ncrossserver_net_send_buffer_full_total %lld\n", (long long)Load(net.SendBufferFullCount));
+		AppendFormat(out, "# TYPE crossserver_net_compressed_send_total counter\ncrossserver_net_compressed_send_total %lld\n", (long long)Load(net.CompressedSendCount));
+		AppendFormat(out, "# TYPE crossserver_net_compress_saved_bytes_total counter\ncrossserver_net_compress_saved_bytes_total %lld\n", (long long)Load(net.CompressSavedBytes));
+		AppendFormat(out, "# TYPE crossserver_session_pool_size gauge\ncrossserver_session_pool_size %d\n", Load(net.SessionPoolSize));
+		AppendFormat(out, "# TYPE crossserver_session_connected gauge\ncrossserver_session_connected %d\n", Load(net.ConnectedSessionCount));
+		AppendFormat(out, "# TYPE crossserver_packet_queue_depth gauge\ncrossserver_packet_queue_depth %d\n", Load(net.PacketQueueDepth));
+
+		auto& metrics = *m_pRefMetrics;
+		AppendFormat(out, "# TYPE crossserver_user_count gauge\ncrossserver_user_count %d\n", Load(metrics.UserCount));
+		AppendFormat(out, "# TYPE crossserver_user_pool_size gauge\ncrossserver_user_pool_size %d\n", Load(metrics.MaxUserCount));
+
+		out += "# TYPE crossserver_lobby_user_count gauge\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_lobby_user_count{lobby=\"%d\"} %d\n", i, Load(metrics.GetLobbyMetric(i).UserCount));
+		}
+
+		out += "# TYPE crossserver_lobby_room_used gauge\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_lobby_room_used{lobby=\"%d\"} %d\n", i, Load(metrics.GetLobbyMetric(i).UsedRoomCount));
+		}
+
+		out += "# TYPE crossserver_lobby_room_active gauge\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_lobby_room_active{lobby=\"%d\"} %d\n", i, Load(metrics.GetLobbyMetric(i).ActiveRoomCount));
+		}
+
+		out += "# TYPE crossserver_room_tick_total counter\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_room_tick_total{lobby=\"%d\"} %lld\n", i, (long long)Load(metrics.GetLobbyMetric(i).RoomTickCount));
+		}
+
+		out += "# TYPE crossserver_room_tick_overrun_total counter\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_room_tick_overrun_total{lobby=\"%d\"} %lld\n", i, (long long)Load(metrics.GetLobbyMetric(i).RoomTickOverrunCount));
+		}
+
+		out += "# TYPE crossserver_room_tick_dropped_total counter\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_room_tick_dropped_total{lobby=\"%d\"} %lld\n", i, (long long)Load(metrics.GetLobbyMetric(i).RoomTickDroppedCount));
+		}
+
+		out += "# TYPE crossserver_room_tick_deferred_rooms_total counter\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_room_tick_deferred_rooms_total{lobby=\"%d\"} %lld\n", i, (long long)Load(metrics.GetLobbyMetric(i).RoomTickDeferredCount));
+		}
+
+		out += "# TYPE crossserver_room_tick_max_seconds gauge\n";
+		for (int i = 0; i < metrics.LobbyCount(); ++i) {
+			AppendFormat(out, "crossserver_room_tick_max_seconds{lobby=\"%d\"} %g\n", i, (double)Load(metrics.GetLobbyMetric(i).RoomTickMaxMicroSec) / 1000000.0);
+		}
+
+		out += "# TYPE crossserver_packet_process_seconds histogram\n";
+		for (int id = 0; id < MAX_PACKET_METRIC_COUNT; ++id)
+		{
+			auto& packet = metrics.GetPacketMetric(id);
+			auto count = Load(packet.Count);
+			if (count == 0) {
+				continue;
+			}
+
+			int64_t cumulative = 0;
+			for (int bucket = 0; bucket < PACKET_LATENCY_BUCKET_COUNT - 1; ++bucket)
+			{
+				cumulative += Load(packet.Buckets[bucket]);
+				AppendFormat(out, "crossserver_packet_process_seconds_bucket{packet_id=\"%d\",le=\"%g\"} %lld\n",
+					id, (double)((int64_t)1 << bucket) / 1000000.0, (long long)cumulative);
+			}
+			AppendFormat(out, "crossserver_packet_process_seconds_bucket{packet_id=\"%d\",le=\"+Inf\"} %lld\n", id, (long long)count);
+			AppendFormat(out, "crossserver_packet_process_seconds_sum{packet_id=\"%d\"} %g\n", id, (double)Load(packet.TotalNanoSec) / 1000000000.0);
+			AppendFormat(out, "crossserver_packet_process_seconds_count{packet_id=\"%d\"} %lld\n", id, (long long)count);
+		}
+
+		return out;
+	}
+
+	std::string AdminServer::MakePlainText()
+	{
+		std::string out;
+		out.reserve(8 * 1024);
+
+		auto& net = *m_pRefNetStats;
+		auto& metrics = *m_pRefMetrics;
+
+		AppendFormat(out, "[Network]\n");
+		AppendFormat(out, "Session      : %d / %d\n", Load(net.ConnectedSessionCount), Load(net.SessionPoolSize));
+		AppendFormat(out, "Accept/Close : %lld / %lld\n", (long long)Load(net.AcceptCount), (long long)Load(net.CloseCount));
+		AppendFormat(out, "Recv         : %lld packets, %lld bytes\n", (long long)Load(net.RecvPacketCount), (long long)Load(net.RecvBytes));
+		AppendFormat(out, "Send         : %lld packets, %lld bytes, %lld calls\n", (long long)Load(net.SendPacketCount), (long long)Load(net.SendBytes), (long long)Load(net.SendCallCount));
+		AppendFormat(out, "SendBuffFull : %lld\n", (long long)Load(net.SendBufferFullCount));
+		AppendFormat(out, "Compress     : %lld packets, %lld bytes saved\n", (long long)Load(net.CompressedSendCount), (long long)Load(net.CompressSavedBytes));
+		AppendFormat(out, "PacketQueue  : %d\n", Load(net.PacketQueueDepth));
+
+		AppendFormat(out, "\n[Logic]\n");
+		AppendFormat(out, "User         : %d / %d\n", Load(metrics.UserCount), Load(metrics.MaxUserCount));
+		for (int i = 0; i < metrics.LobbyCount(); ++i)
+		{
+			auto& lobby = metrics.GetLobbyMetric(i);
+			AppendFormat(out, "Lobby %-6d : user %d / %d, room %d / %d, active %d\n", i,
+				Load(lobby.UserCount), Load(lobby.MaxUserCount), Load(lobby.UsedRoomCount), Load(lobby.MaxRoomCount), Load(lobby.ActiveRoomCount));
+			AppendFormat(out, "  RoomTick   : %lld ticks, overrun %lld, dropped %lld, deferred rooms %lld, max %lld us\n",
+				(long long)Load(lobby.RoomTickCount), (long long)Load(lobby.RoomTickOverrunCount), (long long)Load(lobby.RoomTickDroppedCount),
+				(long long)Load(lobby.RoomTickDeferredCount), (long long)Load(lobby.RoomTickMaxMicroSec));
+		}
+
+		AppendFormat(out, "\n[Packet]  id      count    avg(us)\n");
+		for (int id = 0; id < MAX_PACKET_METRIC_COUNT; ++id)
+		{
+			auto& packet = metrics.GetPacketMetric(id);
+			auto count = Load(packet.Count);
+			if (count == 0) {
+				continue;
+			}
+
+			AppendFormat(out, "        %4d %10lld %10.2f\n", id, (long long)count, (double)Load(packet.TotalNanoSec) / count / 1000.0);
+		}
+
+		return out;
+	}
+}
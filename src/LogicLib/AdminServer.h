@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace NServerNetLib
+{
+	class ILog;
+	struct NetStats;
+}
+
+namespace NLogicLib
+{
+	class ServerMetrics;
+
+	// 로컬 Unix 도메인 소켓으로 서버 상태를 보여준다.
+	// 접속해서 "text" 를 보내면 사람이 읽기 쉬운 형식, 그 외(HTTP GET 포함)는 Prometheus 형식으로 응답한다.
+	// 예) curl --unix-socket /tmp/crossserver.sock http://localhost/metrics
+	class AdminServer
+	{
+		using ILog = NServerNetLib::ILog;
+		using NetStats = NServerNetLib::NetStats;
+
+	public:
+		AdminServer();
+		~AdminServer();
+
+		bool Start(const char* pSocketPath, ServerMetrics* pMetrics, NetStats* pNetStats, ILog* pLogger);
+		void Stop();
+
+	private:
+		void Run();
+		void ServeClient(const int clientFD);
+
+		std::string MakePrometheusText();
+		std::string MakePlainText();
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+		ServerMetrics* m_pRefMetrics = nullptr;
+		NetStats* m_pRefNetStats = nullptr;
+
+		std::string m_SocketPath;
+		int m_ListenFD = -1;
+
+		std::atomic<bool> m_IsRun{ false };
+		std::thread m_Thread;
+	};
+}
@@ -1,23 +1,34 @@
 #pragma once
 
 #include <time.h>
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <vector>
 #include "../ServerNetLib/ILog.h"
 #include "../ServerNetLib/TcpNetwork.h"
+#include "TaskScheduler.h"
 
 namespace NLogicLib
 {
+	// α ˻ ۾ 忡 Ƿ atomic  д.     ϳ̴.
 	struct ConnectedUser
 	{
 		void Clear()
 		{
-			m_IsLoginSuccess = false;
-			m_ConnectedTime = 0;
+			m_IsLoginSuccess.store(false, std::memory_order_relaxed);
+			m_ConnectedTime.store(0, std::memory_order_relaxed);
 		}
 
-		bool m_IsLoginSuccess = false;
-		time_t m_ConnectedTime = 0;
+		std::atomic<bool> m_IsLoginSuccess{ false };
+		std::atomic<time_t> m_ConnectedTime{ 0 };
+	};
+
+	// α ˻翡 ð Ѱٰ  . ˻ϴ ̿ ٽ ߴ ConnectedTime  ȮѴ.
+	struct LoginExpiredSession
+	{
+		int SessionIndex;
+		time_t ConnectedTime;
 	};
 
 	class ConnectedUserManager
@@ -33,22 +44,26 @@ namespace NLogicLib
 			m_pRefLogger = pLogger;
 			m_pRefNetwork = pNetwork;
 
-			for (int i = 0; i < maxSessionCount; ++i)
-			{
-				ConnectedUserList.emplace_back(ConnectedUser());
-			}
+			// atomic  ű  Ƿ ũ⸦ ؼ .
+			std::vector<ConnectedUser> userList(maxSessionCount);
+			ConnectedUserList.swap(userList);
 
 			m_IsLoginCheck = pConfig->IsLoginCheck;
 		}
 
+		void SetScheduler(TaskScheduler* pScheduler)
+		{
+			m_pRefScheduler = pScheduler;
+		}
+
 		void SetConnectSession(const int sessionIndex)
 		{
-			time(&ConnectedUserList[sessionIndex].m_ConnectedTime);
+			ConnectedUserList[sessionIndex].m_ConnectedTime.store(time(nullptr), std::memory_order_relaxed);
 		}
 
 		void SetLogin(const int sessionIndex)
 		{
-			ConnectedUserList[sessionIndex].m_IsLoginSuccess = true;
+			ConnectedUserList[sessionIndex].m_IsLoginSuccess.store(true, std::memory_order_relaxed);
 		}
 
 		void SetDisConnectSession(const int sessionIndex)
@@ -56,12 +71,24 @@ namespace NLogicLib
 			ConnectedUserList[sessionIndex].Clear();
 		}
 
+		/*
+		60иʸ ü  ۾ 忡  ˻ϰ,     忡  ´.
+		˻ϴ    Ŷ ó Ѵ. ۾ 尡   ڸ ˻ϰ ´.
+		*/
 		void LoginCheck()
 		{
 			if (m_IsLoginCheck == false) {
 				return;
 			}
 
+			if (m_IsSweeping)
+			{
+				if (m_SweepGroup.IsDone() == false) {
+					return;
+				}
+				CloseExpiredSession();
+			}
+
 			auto curTime = std::chrono::system_clock::now();
 			auto diffTime = std::chrono::duration_cast<std::chrono::milliseconds>(curTime - m_LatestLoginCheckTime);
 
@@ -76,48 +103,91 @@ namespace NLogicLib
 			}
 
 			auto curSecTime = std::chrono::system_clock::to_time_t(curTime);
-
 			const auto maxSessionCount = (int)ConnectedUserList.size();
 
-			if (m_LatestLogincheckIndex >= maxSessionCount) {
-				m_LatestLogincheckIndex = -1;
+			if (m_pRefScheduler == nullptr)
+			{
+				SweepLogin(0, maxSessionCount, curSecTime);
+				CloseExpiredSession();
+				return;
 			}
 
-			++m_LatestLogincheckIndex;
+			m_IsSweeping = true;
+			m_pRefScheduler->ParallelFor(m_SweepGroup, 0, maxSessionCount, LOGIN_CHECK_GRAIN_SIZE, [this, curSecTime](const int begin, const int end) {
+				SweepLogin(begin, end, curSecTime);
+			});
 
-			auto lastCheckIndex = m_LatestLogincheckIndex + 100;
-			if (lastCheckIndex > maxSessionCount) {
-				lastCheckIndex = maxSessionCount;
+			if (m_SweepGroup.IsDone()) {
+				CloseExpiredSession();
 			}
+		}
 
-			for (; m_LatestLogincheckIndex < lastCheckIndex; ++m_LatestLogincheckIndex)
-			{
-				auto i = m_LatestLogincheckIndex;
+	private:
+		// ۾ 忡 θ. ConnectedUserList  б⸸ Ѵ.
+		void SweepLogin(const int begin, const int end, const time_t curSecTime)
+		{
+			std::vector<LoginExpiredSession> expiredList;
 
-				if (ConnectedUserList[i].m_ConnectedTime == 0 ||
-					ConnectedUserList[i].m_IsLoginSuccess == false)
+			for (int i = begin; i < end; ++i)
+			{
+				auto connectedTime = ConnectedUserList[i].m_ConnectedTime.load(std::memory_order_relaxed);
+				if (connectedTime == 0 ||
+					ConnectedUserList[i].m_IsLoginSuccess.load(std::memory_order_relaxed))
 				{
 					continue;
 				}
 
-				auto diff = curSecTime - ConnectedUserList[i].m_ConnectedTime;
-				if (diff >= 180)
+				if (curSecTime - connectedTime >= LOGIN_WAIT_TIME_SEC) {
+					expiredList.push_back({ i, connectedTime });
+				}
+			}
+
+			if (expiredList.empty()) {
+				return;
+			}
+
+			std::lock_guard<std::mutex> guard(m_ExpiredLock);
+			m_ExpiredList.insert(m_ExpiredList.end(), expiredList.begin(), expiredList.end());
+		}
+
+		//  忡 θ.
+		void CloseExpiredSession()
+		{
+			m_IsSweeping = false;
+
+			for (auto& expired : m_ExpiredList)
+			{
+				auto& user = ConnectedUserList[expired.SessionIndex];
+				if (user.m_ConnectedTime.load(std::memory_order_relaxed) != expired.ConnectedTime ||
+					user.m_IsLoginSuccess.load(std::memory_order_relaxed))
 				{
-					m_pRefLogger->Write(NServerNetLib::LOG_TYPE::L_WARN, "%s | Login Wait Time Over. sessionIndex(%d).", __FUNCTION__, i);
-					m_pRefNetwork->ForcingClose(i);
+					continue;
 				}
+
+				m_pRefLogger->Write(NServerNetLib::LOG_TYPE::L_WARN, "%s | Login Wait Time Over. sessionIndex(%d).", __FUNCTION__, expired.SessionIndex);
+				m_pRefNetwork->ForcingClose(expired.SessionIndex);
 			}
+			m_ExpiredList.clear();
 		}
 
 	private:
+		const int LOGIN_WAIT_TIME_SEC = 180;
+		const int LOGIN_CHECK_GRAIN_SIZE = 256;
+
 		ILog* m_pRefLogger;
 		TcpNet* m_pRefNetwork;
+		TaskScheduler* m_pRefScheduler = nullptr;
 
 		std::vector<ConnectedUser> ConnectedUserList;
 
 		bool m_IsLoginCheck = false;
 
 		std::chrono::system_clock::time_point m_LatestLoginCheckTime = std::chrono::system_clock::now();
-		int m_LatestLogincheckIndex = -1;
+
+		TaskGroup m_SweepGroup;
+		bool m_IsSweeping = false;
+
+		std::mutex m_ExpiredLock;
+		std::vector<LoginExpiredSession> m_ExpiredList;
 	};
 }
\ No newline at end of file
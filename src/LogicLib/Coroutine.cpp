@@ -0,0 +1,71 @@
+﻿#include <new>
+
+#include "Coroutine.h"
+
+namespace NLogicLib
+{
+	namespace
+	{
+		// 128, 256, 512, 1024, 2048 바이트. 이보다 큰 프레임은 풀을 쓰지 않는다.
+		const int FRAME_SIZE_CLASS_COUNT = 5;
+		const size_t FRAME_MIN_SIZE = 128;
+
+		struct FreeFrame
+		{
+			FreeFrame* pNext;
+		};
+
+		thread_local FreeFrame* t_FreeFrameList[FRAME_SIZE_CLASS_COUNT] = {};
+
+		int FrameSizeClass(const size_t size)
+		{
+			auto classSize = FRAME_MIN_SIZE;
+			for (int i = 0; i < FRAME_SIZE_CLASS_COUNT; ++i)
+			{
+				if (size <= classSize) {
+					return i;
+				}
+				classSize <<= 1;
+			}
+			return -1;
+		}
+	}
+
+	void* CoroutineFramePool::Allocate(const size_t size)
+	{
+		auto sizeClass = FrameSizeClass(size);
+		if (sizeClass < 0) {
+			return ::operator new(size);
+		}
+
+		auto& pHead = t_FreeFrameList[sizeClass];
+		if (pHead != nullptr)
+		{
+			auto pFrame = pHead;
+			pHead = pFrame->pNext;
+			return pFrame;
+		}
+
+		return ::operator new(FRAME_MIN_SIZE << sizeClass);
+	}
+
+	void CoroutineFramePool::Free(void* pFrame, const size_t size)
+	{
+		auto sizeClass = FrameSizeClass(size);
+		if (sizeClass < 0)
+		{
+			::operator delete(pFrame);
+			return;
+		}
+
+		auto pFreeFrame = (FreeFrame*)pFrame;
+		pFreeFrame->pNext = t_FreeFrameList[sizeClass];
+		t_FreeFrameList[sizeClass] = pFreeFrame;
+	}
+
+	TaskGroup& DetachedTaskGroup()
+	{
+		static TaskGroup s_Group;
+		return s_Group;
+	}
+}
@@ -0,0 +1,175 @@
+﻿#pragma once
+
+#include <stddef.h>
+#include <exception>
+#include <coroutine>
+
+#include "TimerService.h"
+#include "TaskScheduler.h"
+
+namespace NLogicLib
+{
+	// 코루틴 프레임 풀. 크기별로 스레드마다 빈 블록 목록을 두어 잠그지 않고, 한 번 잡은 블록은 돌려주지 않고 다시 쓴다.
+	// 다른 스레드에서 지운 프레임은 그 스레드의 목록으로 간다.
+	class CoroutineFramePool
+	{
+	public:
+		static void* Allocate(const size_t size);
+		static void Free(void* pFrame, const size_t size);
+	};
+
+	/*
+	패킷 핸들러나 게임 흐름을 코루틴으로 쓸 때의 반환 타입. 부르면 첫 co_await 까지 바로 실행하고, 끝나면 프레임을 스스로 지운다.
+	기다려 주는 쪽이 없으므로 멈추기 전에 쓸 값(패킷 Body 등)은 지역 변수로 복사해 두고, 이어질 때는 룸 상태를 다시 확인한다.
+	*/
+	struct CoTask
+	{
+		struct promise_type
+		{
+			CoTask get_return_object() { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+
+			static void* operator new(size_t size) { return CoroutineFramePool::Allocate(size); }
+			static void operator delete(void* pFrame, size_t size) { CoroutineFramePool::Free(pFrame, size); }
+		};
+	};
+
+	// 기다리지 않는 작업을 넣을 때 쓰는 묶음. 넣은 쪽 프레임이 먼저 사라져도 남아 있어야 한다.
+	TaskGroup& DetachedTaskGroup();
+
+	enum class WAIT_RESULT : char
+	{
+		SIGNALED,
+		TIMEOUT,
+		CANCELED,
+	};
+
+	/*
+	다른 유저의 요청을 기다릴 때 쓴다. 코루틴 하나가 Wait 로 멈추고, 같은 로비의 핸들러가 Set 이나 Cancel 을 부르면 그 자리에서 이어서 실행한다.
+	시간 제한을 주면 로비의 TimerService 가 TIMEOUT 으로 깨운다. 기다리는 코루틴이 없을 때 Set 하면 다음 Wait 가 바로 지나간다.
+	*/
+	class CoEvent
+	{
+	public:
+		struct Awaiter
+		{
+			bool await_ready()
+			{
+				if (pEvent->m_IsSet == false) {
+					return false;
+				}
+
+				pEvent->m_IsSet = false;
+				Result = WAIT_RESULT::SIGNALED;
+				return true;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				pEvent->m_pWaiter = this;
+				Handle = handle;
+
+				if (TimeoutMilliSec > 0 && pTimer != nullptr) {
+					pEvent->m_TimeoutTimerId = pTimer->AddTimer(TimeoutMilliSec, &CoEvent::OnTimeout, pEvent);
+				}
+			}
+
+			WAIT_RESULT await_resume() { return Result; }
+
+			CoEvent* pEvent = nullptr;
+			TimerService* pTimer = nullptr;
+			int TimeoutMilliSec = 0;
+			std::coroutine_handle<> Handle{};
+			WAIT_RESULT Result = WAIT_RESULT::SIGNALED;
+		};
+
+		// timeoutMilliSec 가 0 이면 Set/Cancel 까지 기다린다.
+		Awaiter Wait(TimerService* pTimer, const int timeoutMilliSec) { return Awaiter{ this, pTimer, timeoutMilliSec }; }
+
+		void Set()
+		{
+			if (m_pWaiter == nullptr)
+			{
+				m_IsSet = true;
+				return;
+			}
+			Resume(WAIT_RESULT::SIGNALED);
+		}
+
+		// 기다릴 이유가 없어졌을 때. 기다리는 코루틴이 있으면 CANCELED 로 깨우고, 남은 신호도 지운다.
+		void Cancel()
+		{
+			m_IsSet = false;
+			if (m_pWaiter != nullptr) {
+				Resume(WAIT_RESULT::CANCELED);
+			}
+		}
+
+		bool IsWaiting() { return m_pWaiter != nullptr; }
+
+	private:
+		static void OnTimeout(void* pContext)
+		{
+			auto pEvent = (CoEvent*)pContext;
+			pEvent->m_TimeoutTimerId = TimerId();
+			if (pEvent->m_pWaiter != nullptr) {
+				pEvent->Resume(WAIT_RESULT::TIMEOUT);
+			}
+		}
+
+		void Resume(const WAIT_RESULT result)
+		{
+			auto pWaiter = m_pWaiter;
+			m_pWaiter = nullptr;
+
+			if (m_TimeoutTimerId.IsValid()) {
+				pWaiter->pTimer->CancelTimer(m_TimeoutTimerId);
+			}
+
+			// 이어서 실행한 코루틴이 끝나면 pWaiter 가 있던 프레임도 사라지므로 먼저 꺼내 둔다.
+			auto handle = pWaiter->Handle;
+			pWaiter->Result = result;
+			handle.resume();
+		}
+
+	private:
+		Awaiter* m_pWaiter = nullptr;
+		TimerId m_TimeoutTimerId;
+		bool m_IsSet = false;
+	};
+
+	/*
+	co_await RunAsync(pScheduler, pTimer, func);
+	func 를 작업 스레드에서 실행하고, 끝나면 pTimer 를 돌리는 스레드(로비를 맡은 로직 샤드)의 다음 Update 에서 이어서 실행한다.
+	저장소 읽기/쓰기처럼 로직 스레드를 막으면 안 되는 일에 쓴다. func 는 로비 데이터를 건드리면 안 된다.
+	*/
+	template <class Func>
+	struct RunAsyncAwaiter
+	{
+		bool await_ready() { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			// 이어진 코루틴이 끝나면 이 Awaiter 도 사라지므로 Post 뒤에는 this 를 쓰지 않는다.
+			pScheduler->Submit(DetachedTaskGroup(), [this, handle]() {
+				AsyncFunc();
+				pTimer->Post(handle);
+			});
+		}
+
+		void await_resume() {}
+
+		TaskScheduler* pScheduler;
+		TimerService* pTimer;
+		Func AsyncFunc;
+	};
+
+	template <class Func>
+	RunAsyncAwaiter<Func> RunAsync(TaskScheduler* pScheduler, TimerService* pTimer, Func func)
+	{
+		return RunAsyncAwaiter<Func>{ pScheduler, pTimer, std::move(func) };
+	}
+}
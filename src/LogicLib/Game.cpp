@@ -1,5 +1,6 @@
-#include <chrono>
+﻿#include <chrono>
 
+#include "../Common/ErrorCode.h"
 #include "Game.h"
 
 
@@ -9,23 +10,185 @@ namespace NLogicLib
 
 	Game::~Game() {}*/
 
+	namespace
+	{
+		// 타이머가 라운드를 끝내지 못했다고 볼 때까지 선택 시간 뒤로 더 기다리는 시간
+		const int64_t SELECT_TIME_GRACE_MILLISEC = 5000;
+
+		// a 가 b 를 이기는가. 가위(0) < 바위(1) < 보(2) < 가위(0)
+		bool IsBeat(const GAME_SELECT a, const GAME_SELECT b)
+		{
+			return ((int)a - (int)b + 3) % 3 == 1;
+		}
+	}
+
+	void Game::Init(const short maxPlayerCount)
+	{
+		m_PlayerList.reserve(maxPlayerCount);
+	}
+
 	void Game::Clear()
 	{
 		m_State = GameState::NONE;
+		m_RoundNo = 0;
+		m_AlivePlayerCount = 0;
+		m_SelectCount = 0;
+		m_PlayerList.clear();
+	}
+
+	void Game::AddPlayer(const short userIndex)
+	{
+		GamePlayer player;
+		player.UserIndex = userIndex;
+		m_PlayerList.push_back(player);
+		++m_AlivePlayerCount;
 	}
 
-	bool Game::CheckSelectTime()
+	void Game::StartRound(const int64_t curMilliSec, const int selectMilliSec)
 	{
-		auto curTime = std::chrono::system_clock::now();
-		auto curSecTime = std::chrono::system_clock::to_time_t(curTime);
+		++m_RoundNo;
+		m_SelectTime = curMilliSec + selectMilliSec;
+		m_SelectCount = 0;
 
-		auto diff = curSecTime - m_SelectTime;
-		if (diff >= 60)
+		for (auto& player : m_PlayerList)
+		{
+			player.Select = GAME_SELECT::NONE;
+			player.Result = player.IsOut ? GAME_RESULT::OUT : GAME_RESULT::NONE;
+		}
+	}
+
+	ERROR_CODE Game::Select(const short userIndex, const char select)
+	{
+		if (select < (char)GAME_SELECT::SCISSORS || select > (char)GAME_SELECT::PAPER) {
+			return ERROR_CODE::ROOM_GAME_SELECT_INVALID_SELECT;
+		}
+
+		auto pPlayer = FindPlayer(userIndex);
+		if (pPlayer == nullptr || pPlayer->IsOut) {
+			return ERROR_CODE::ROOM_GAME_SELECT_NOT_PLAYER;
+		}
+
+		if (pPlayer->Select != GAME_SELECT::NONE) {
+			return ERROR_CODE::ROOM_GAME_SELECT_ALREADY_SELECTED;
+		}
+
+		pPlayer->Select = (GAME_SELECT)select;
+		++m_SelectCount;
+		return ERROR_CODE::NONE;
+	}
+
+	void Game::LeavePlayer(const short userIndex)
+	{
+		auto pPlayer = FindPlayer(userIndex);
+		if (pPlayer == nullptr || pPlayer->IsOut) {
+			return;
+		}
+
+		if (pPlayer->Select != GAME_SELECT::NONE) {
+			--m_SelectCount;
+		}
+
+		pPlayer->IsOut = true;
+		pPlayer->Select = GAME_SELECT::NONE;
+		pPlayer->Result = GAME_RESULT::LOSE;
+		--m_AlivePlayerCount;
+	}
+
+	bool Game::IsAllSelected()
+	{
+		return m_SelectCount >= m_AlivePlayerCount;
+	}
+
+	bool Game::IsAlivePlayer(const short userIndex)
+	{
+		auto pPlayer = FindPlayer(userIndex);
+		return pPlayer != nullptr && pPlayer->IsOut == false;
+	}
+
+	/*
+	고른 것의 종류가 두 가지일 때만 승부가 난다. 진 쪽과 고르지 않은 유저가 빠진다.
+	한 명이 남으면 그 유저가 이기고, 아무도 남지 않거나 마지막 라운드까지 가면 남은 유저끼리 비긴 채로 끝난다.
+	*/
+	bool Game::ResolveRound()
+	{
+		auto selectMask = 0;
+		for (auto& player : m_PlayerList)
+		{
+			if (player.IsOut == false && player.Select != GAME_SELECT::NONE) {
+				selectMask |= 1 << (int)player.Select;
+			}
+		}
+
+		// 두 가지만 나왔으면 이기는 쪽을 찾는다.
+		auto winSelect = GAME_SELECT::NONE;
+		if (selectMask == 0b011 || selectMask == 0b110 || selectMask == 0b101)
+		{
+			auto first = (selectMask & 1) ? GAME_SELECT::SCISSORS : GAME_SELECT::ROCK;
+			auto second = (selectMask & 4) ? GAME_SELECT::PAPER : GAME_SELECT::ROCK;
+			winSelect = IsBeat(first, second) ? first : second;
+		}
+
+		// 다른 유저가 모두 나가서 혼자 남았으면 무엇을 냈든 그 유저가 이긴다.
+		auto isLastPlayer = m_AlivePlayerCount == 1;
+
+		short survivorCount = 0;
+		for (auto& player : m_PlayerList)
+		{
+			if (player.IsOut)
+			{
+				// 이번 라운드 중에 나간 유저는 LeavePlayer 가 LOSE 로 두었다.
+				if (player.Result != GAME_RESULT::LOSE) {
+					player.Result = GAME_RESULT::OUT;
+				}
+				continue;
+			}
+
+			auto isLose = isLastPlayer == false && (player.Select == GAME_SELECT::NONE || (winSelect != GAME_SELECT::NONE && player.Select != winSelect));
+			if (isLose)
+			{
+				player.IsOut = true;
+				player.Result = GAME_RESULT::LOSE;
+				continue;
+			}
+
+			player.Result = GAME_RESULT::DRAW;
+			++survivorCount;
+		}
+		m_AlivePlayerCount = survivorCount;
+
+		if (survivorCount == 1)
+		{
+			for (auto& player : m_PlayerList)
+			{
+				if (player.IsOut == false) {
+					player.Result = GAME_RESULT::WIN;
+				}
+			}
+			return true;
+		}
+
+		return survivorCount == 0 || m_RoundNo >= NCommon::GAME_MAX_ROUND_COUNT;
+	}
+
+	bool Game::CheckSelectTime(const int64_t curMilliSec)
+	{
+		auto diff = curMilliSec - m_SelectTime;
+		if (diff >= SELECT_TIME_GRACE_MILLISEC)
 		{
-			//
 			return true;
 		}
 
 		return false;
 	}
-}
\ No newline at end of file
+
+	GamePlayer* Game::FindPlayer(const short userIndex)
+	{
+		for (auto& player : m_PlayerList)
+		{
+			if (player.UserIndex == userIndex) {
+				return &player;
+			}
+		}
+		return nullptr;
+	}
+}
@@ -1,5 +1,13 @@
 #pragma once
 
+#include <stdint.h>
+#include <vector>
+
+#include "../Common/Packet.h"
+
+namespace NCommon { enum class ERROR_CODE :short; }
+using ERROR_CODE = NCommon::ERROR_CODE;
+
 namespace NLogicLib
 {
 	enum class GameState 
@@ -10,23 +18,66 @@ namespace NLogicLib
 		END
 	};
 
+	using GAME_SELECT = NCommon::GAME_SELECT;
+	using GAME_RESULT = NCommon::GAME_RESULT;
+
+	struct GamePlayer
+	{
+		short UserIndex = -1;
+		GAME_SELECT Select = GAME_SELECT::NONE;	// ̹ 忡  
+		GAME_RESULT Result = GAME_RESULT::NONE;	//   
+		bool IsOut = false;						// ų    ʴ´
+	};
+
+	/*
+	  .   ΰ ϰ, 帶       .
+	    忡 .      ų     .
+	  Init   ŭ  ΰ ٽ Ƿ 帶 ޸𸮸  ʴ´.
+	*/
 	class Game
 	{
 	public:
 		Game() {}
 		virtual ~Game() {}
 
+		void Init(const short maxPlayerCount);
 		void Clear();
 		GameState GetState() { return m_State;  }
 		void SetState(const GameState state) { m_State = state; }
-		bool CheckSelectTime();
+
+		void AddPlayer(const short userIndex);
+		void StartRound(const int64_t curMilliSec, const int selectMilliSec);
+		ERROR_CODE Select(const short userIndex, const char select);
+
+		//     .
+		void LeavePlayer(const short userIndex);
+
+		bool IsAllSelected();
+
+		// ̹  и Ѵ.   true.
+		bool ResolveRound();
+
+		short GetRoundNo() { return m_RoundNo; }
+		short GetAlivePlayerCount() { return m_AlivePlayerCount; }
+		short GetPlayerCount() { return (short)m_PlayerList.size(); }
+		GamePlayer& GetPlayer(const short index) { return m_PlayerList[index]; }
+		bool IsAlivePlayer(const short userIndex);
+
+		// ð steady_clock и.  ƽ ƽ     ѱ.
+		//  ð  µ 尡  ʾҴ.  Ÿ̸Ӱ Ƿ ̸ false .
+		bool CheckSelectTime(const int64_t curMilliSec);
+
+	private:
+		GamePlayer* FindPlayer(const short userIndex);
 
 	private:
 		GameState m_State = GameState::NONE;
 
-		int64_t m_SelectTime;
-		int m_GameSelect1; // (0), (1), (2)
-		int m_GameSelect2;
+		int64_t m_SelectTime = 0;		//̹   ľ ϴ ð
+		short m_RoundNo = 0;
+		short m_AlivePlayerCount = 0;
+		short m_SelectCount = 0;		//̹ 忡    
+		std::vector<GamePlayer> m_PlayerList;
 	};
 
-}
\ No newline at end of file
+}
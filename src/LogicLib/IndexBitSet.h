@@ -0,0 +1,127 @@
+﻿#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "utils.h"
+
+namespace NLogicLib
+{
+	// 0 ~ (count-1) 인덱스 집합. 64비트 워드 비트맵 위에 "비어 있지 않은 워드" 요약 비트맵을 한 단 더 두어서
+	// 4096개까지는 워드 두 개만 보고 가장 작은 인덱스를 찾는다.
+	class IndexBitSet
+	{
+	public:
+		void Init(const int count)
+		{
+			m_Size = count;
+			m_Count = 0;
+			m_Words.assign((count + 63) / 64, 0);
+			m_SummaryWords.assign((m_Words.size() + 63) / 64, 0);
+		}
+
+		void Set(const int index)
+		{
+			auto& word = m_Words[index >> 6];
+			auto bit = 1ULL << (index & 63);
+			if (word & bit) {
+				return;
+			}
+
+			word |= bit;
+			m_SummaryWords[index >> 12] |= 1ULL << ((index >> 6) & 63);
+			++m_Count;
+		}
+
+		void Reset(const int index)
+		{
+			auto& word = m_Words[index >> 6];
+			auto bit = 1ULL << (index & 63);
+			if ((word & bit) == 0) {
+				return;
+			}
+
+			word &= ~bit;
+			if (word == 0) {
+				m_SummaryWords[index >> 12] &= ~(1ULL << ((index >> 6) & 63));
+			}
+			--m_Count;
+		}
+
+		void Update(const int index, const bool isSet)
+		{
+			if (isSet) {
+				Set(index);
+			}
+			else {
+				Reset(index);
+			}
+		}
+
+		bool Test(const int index) const
+		{
+			return (m_Words[index >> 6] & (1ULL << (index & 63))) != 0;
+		}
+
+		// 없으면 -1
+		int FindFirst() const
+		{
+			for (int i = 0; i < (int)m_SummaryWords.size(); ++i)
+			{
+				if (m_SummaryWords[i] == 0) {
+					continue;
+				}
+
+				auto wordIndex = (i << 6) + CountTrailingZero(m_SummaryWords[i]);
+				return (wordIndex << 6) + CountTrailingZero(m_Words[wordIndex]);
+			}
+			return -1;
+		}
+
+		// startIndex 이상인 것 중 가장 작은 인덱스. 없으면 -1
+		int FindNext(const int startIndex) const
+		{
+			if (startIndex <= 0) {
+				return FindFirst();
+			}
+
+			if (startIndex >= m_Size) {
+				return -1;
+			}
+
+			auto wordIndex = startIndex >> 6;
+			auto word = m_Words[wordIndex] & (~0ULL << (startIndex & 63));
+			if (word != 0) {
+				return (wordIndex << 6) + CountTrailingZero(word);
+			}
+
+			// 나머지는 요약 비트맵에서 비어 있지 않은 다음 워드를 찾는다.
+			auto nextWordIndex = wordIndex + 1;
+			auto summaryIndex = nextWordIndex >> 6;
+			if (summaryIndex >= (int)m_SummaryWords.size()) {
+				return -1;
+			}
+
+			auto summary = m_SummaryWords[summaryIndex] & (~0ULL << (nextWordIndex & 63));
+			while (summary == 0)
+			{
+				if (++summaryIndex >= (int)m_SummaryWords.size()) {
+					return -1;
+				}
+				summary = m_SummaryWords[summaryIndex];
+			}
+
+			auto foundWordIndex = (summaryIndex << 6) + CountTrailingZero(summary);
+			return (foundWordIndex << 6) + CountTrailingZero(m_Words[foundWordIndex]);
+		}
+
+		int Count() const { return m_Count; }
+		int Size() const { return m_Size; }
+
+	private:
+		std::vector<uint64_t> m_Words;
+		std::vector<uint64_t> m_SummaryWords;
+		int m_Size = 0;
+		int m_Count = 0;
+	};
+}
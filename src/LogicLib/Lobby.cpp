@@ -1,12 +1,17 @@
-#include <algorithm>
+﻿#include <algorithm>
+#include <chrono>
+#include <string.h>
 
 #include "../ServerNetLib/ILog.h"
 #include "../ServerNetLib/TcpNetwork.h"
 #include "../Common/Packet.h"
+#include "../Common/PacketSchema.h"
 #include "../Common/ErrorCode.h"
 #include "User.h"
+#include "Game.h"
 #include "Room.h"
 #include "Lobby.h"
+#include "LobbyManager.h"
 #include "utils.h"
 
 using PACKET_ID = NCommon::PACKET_ID;
@@ -27,41 +32,83 @@ namespace NLogicLib
 			LobbyUser lobbyUser;
 			lobbyUser.Index = (short)i;
 			lobbyUser.pUser = nullptr;
+			lobbyUser.NextFreeIndex = (i + 1) < maxLobbyUserCount ? (short)(i + 1) : -1;
 
 			m_UserList.push_back(lobbyUser);
 		}
 
+		m_FreeUserSlotHead = maxLobbyUserCount > 0 ? 0 : -1;
+
+		m_UserIndexList.assign(maxLobbyUserCount, nullptr);
+		m_UserIDDic.Init(maxLobbyUserCount);
+		m_QuickMatchQueue.reserve(maxLobbyUserCount);
+
+		m_RoomList.resize(maxRoomCountByLobby);
+
+		// 룸마다 게임 시작 대기 타이머 하나씩은 늘 쓴다.
+		m_CurMilliSec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		m_pTimerService = std::make_unique<TimerService>();
+		m_pTimerService->Init(maxRoomCountByLobby, m_CurMilliSec);
+
+		for (int i = 0; i < maxRoomCountByLobby; ++i)
+		{
+			m_RoomList[i].Init((short)i, maxRoomUserCount, this);
+		}
+
+		m_FreeRoomSet.Init(maxRoomCountByLobby);
+		m_HasSeatRoomSet.Init(maxRoomCountByLobby);
+		m_WaitingRoomSet.Init(maxRoomCountByLobby);
+		m_JoinableRoomSet.Init(maxRoomCountByLobby);
+		m_UsedRoomSet.Init(maxRoomCountByLobby);
+		m_ChangedRoomSet.Init(maxRoomCountByLobby);
+		m_RoomSummaryList.resize(maxRoomCountByLobby);
+
 		for (int i = 0; i < maxRoomCountByLobby; ++i)
 		{
-			m_RoomList.emplace_back(new Room());
-			m_RoomList[i]->Init((short)i, maxRoomUserCount);
+			m_FreeRoomSet.Set(i);
+			UpdateRoomSummary(&m_RoomList[i]);
 		}
 	}
 
 	void Lobby::Release()
 	{
-		for (int i = 0; i < (int)m_RoomList.size(); ++i)
-		{
-			delete m_RoomList[i];
+		// 룸을 기다리는 코루틴을 끝내서 프레임을 돌려받는다.
+		for (auto& room : m_RoomList) {
+			room.Clear();
 		}
-
 		m_RoomList.clear();
 	}
 
+	void Lobby::UpdateTimer(const int64_t curMilliSec)
+	{
+		m_CurMilliSec = curMilliSec;
+		m_pTimerService->Update(curMilliSec);
+	}
+
+	void Lobby::SetRoomTick(const int tickPerSec, const int maxRoomUpdatePerTick)
+	{
+		m_RoomTickScheduler.Init(tickPerSec, maxRoomUpdatePerTick, m_CurMilliSec);
+	}
+
+	void Lobby::UpdateRoomTick(const int64_t curMilliSec)
+	{
+		m_RoomTickScheduler.Update(curMilliSec);
+	}
+
 	void Lobby::SetNetwork(TcpNet* pNetwork, ILog* pLogger)
 	{
 		m_pRefLogger = pLogger;
 		m_pRefNetwork = pNetwork;
 
-		for (auto pRoom : m_RoomList)
+		for (auto& room : m_RoomList)
 		{
-			pRoom->SetNetwork(pNetwork, pLogger);
+			room.SetNetwork(pNetwork, pLogger);
 		}
 	}
 
 	ERROR_CODE Lobby::EnterUser(User* pUser)
 	{
-		if ((int)m_UserIndexDic.size() >= m_MaxUserCount) {
+		if (m_UserCount >= m_MaxUserCount) {
 			return ERROR_CODE::LOBBY_ENTER_MAX_USER_COUNT;
 		}
 
@@ -74,9 +121,17 @@ namespace NLogicLib
 			return addRet;
 		}
 
+		// 유저 인덱스는 UserManager 의 풀 크기까지 갈 수 있으므로 처음 보는 큰 인덱스일 때만 늘린다.
+		auto userIndex = pUser->GetIndex();
+		if (userIndex >= (int)m_UserIndexList.size()) {
+			m_UserIndexList.resize(userIndex + 1, nullptr);
+		}
+
 		pUser->EnterLobby(m_LobbyIndex);
-		m_UserIndexDic.insert({ pUser->GetIndex(), pUser });
-		m_UserIDDic.insert({ pUser->GetID().c_str(), pUser });
+		m_UserIndexList[userIndex] = pUser;
+		m_UserIDDic.Insert(pUser->GetID(), pUser);
+		++m_UserCount;
+		NotifyUserCountChanged();
 
 		return ERROR_CODE::NONE;
 	}
@@ -89,77 +144,313 @@ namespace NLogicLib
 		}
 
 		pUser->LeaveLobby();
+		CancelQuickMatch(pUser);
 
-		m_UserIndexDic.erase(pUser->GetIndex());
-		m_UserIDDic.erase(pUser->GetID().c_str());
-		RemoveUser(userIndex);
+		m_UserIndexList[userIndex] = nullptr;
+		m_UserIDDic.Erase(pUser->GetID());
+		--m_UserCount;
+		NotifyUserCountChanged();
+		RemoveUser(pUser);
 		
 		return ERROR_CODE::NONE;
 	}
 		
 	User* Lobby::FindUser(const int userIndex)
 	{
-		auto findIter = m_UserIndexDic.find(userIndex);
-		return findIter != m_UserIndexDic.end() ? (User*)findIter->second : nullptr;
+		if (userIndex < 0 || userIndex >= (int)m_UserIndexList.size()) {
+			return nullptr;
+		}
+
+		return m_UserIndexList[userIndex];
 	}
 
 	ERROR_CODE Lobby::AddUser(User* pUser)
 	{
-		auto findIter = std::find_if(std::begin(m_UserList), std::end(m_UserList), [](auto& lobbyUser) { return lobbyUser.pUser == nullptr; });
-		if (findIter == std::end(m_UserList)) {
+		if (m_FreeUserSlotHead < 0) {
 			return ERROR_CODE::LOBBY_ENTER_EMPTY_USER_LIST;
 		}
 
-		findIter->pUser = pUser;
+		auto& lobbyUser = m_UserList[m_FreeUserSlotHead];
+		m_FreeUserSlotHead = lobbyUser.NextFreeIndex;
+
+		lobbyUser.pUser = pUser;
+		lobbyUser.NextFreeIndex = -1;
+		pUser->SetLobbySlotIndex(lobbyUser.Index);
 		return ERROR_CODE::NONE;
 	}
 
-	void Lobby::RemoveUser(const int userIndex)
+	void Lobby::RemoveUser(User* pUser)
 	{
-		auto findIter = std::find_if(std::begin(m_UserList), std::end(m_UserList), [userIndex](auto& lobbyUser) { return lobbyUser.pUser != nullptr && lobbyUser.pUser->GetIndex() == userIndex; });
-		if (findIter == std::end(m_UserList)) {
+		auto slotIndex = pUser->GetLobbySlotIndex();
+		if (IsInBounds<short>(slotIndex, 0, (short)m_UserList.size()) == false || m_UserList[slotIndex].pUser != pUser) {
 			return;
 		}
 
-		findIter->pUser = nullptr;
+		auto& lobbyUser = m_UserList[slotIndex];
+		lobbyUser.pUser = nullptr;
+		lobbyUser.NextFreeIndex = m_FreeUserSlotHead;
+		m_FreeUserSlotHead = slotIndex;
+
+		pUser->SetLobbySlotIndex(-1);
+	}
+
+	void Lobby::NotifyUserCountChanged()
+	{
+		if (m_pRefLobbyMgr != nullptr) {
+			m_pRefLobbyMgr->OnLobbyUserCountChanged();
+		}
 	}
 
 	short Lobby::GetUserCount()
 	{ 
-		return static_cast<short>(m_UserIndexDic.size()); 
+		return m_UserCount;
 	}
 
 	void Lobby::SendToAllUser(const short packetId, const short dataSize, char* pData, const int passUserindex)
 	{
-		for (auto& pUser : m_UserIndexDic)
+		for (auto& lobbyUser : m_UserList)
 		{
-			if (pUser.second->GetIndex() == passUserindex) {
+			auto pUser = lobbyUser.pUser;
+			if (pUser == nullptr || pUser->GetIndex() == passUserindex) {
 				continue;
 			}
 
-			if (pUser.second->IsCurDomainInLobby() == false) {
+			if (pUser->IsCurDomainInLobby() == false) {
 				continue;
 			}
 
-			m_pRefNetwork->SendData(pUser.second->GetSessionIndex(), packetId, dataSize, pData);
+			m_pRefNetwork->SendData(pUser->GetSessionIndex(), packetId, dataSize, pData);
 		}
 	}
 
 	Room* Lobby::GetAvailableRoom()
 	{
-		for (int i = 0; i < (int)m_RoomList.size(); ++i)
+		auto roomIndex = m_FreeRoomSet.FindFirst();
+		return roomIndex >= 0 ? &m_RoomList[roomIndex] : nullptr;
+	}
+
+	Room* Lobby::GetJoinableRoom()
+	{
+		auto roomIndex = m_JoinableRoomSet.FindFirst();
+		return roomIndex >= 0 ? &m_RoomList[roomIndex] : nullptr;
+	}
+
+	short Lobby::GetUsedRoomCount()
+	{
+		return (short)(m_RoomList.size() - m_FreeRoomSet.Count());
+	}
+
+	ERROR_CODE Lobby::RequestQuickMatch(User* pUser)
+	{
+		if (pUser->GetQuickMatchTicket() != 0) {
+			return ERROR_CODE::ROOM_QUICK_MATCH_ALREADY_WAITING;
+		}
+
+		// 취소된 표가 아직 대기열에 남아 있을 수 있으므로 매번 새 번호를 준다.
+		if (++m_QuickMatchTicketSeq <= 0) {
+			m_QuickMatchTicketSeq = 1;
+		}
+
+		pUser->SetQuickMatchTicket(m_QuickMatchTicketSeq);
+		m_QuickMatchQueue.push_back({ pUser, m_QuickMatchTicketSeq });
+		return ERROR_CODE::NONE;
+	}
+
+	void Lobby::CancelQuickMatch(User* pUser)
+	{
+		pUser->SetQuickMatchTicket(0);
+	}
+
+	void Lobby::ProcessQuickMatch()
+	{
+		if (m_QuickMatchQueue.empty()) {
+			return;
+		}
+
+		// 대기 순서대로 사람이 있는 룸부터 채우고, 없으면 빈 룸을 연다. 들어갈 룸이 없으면 다음 번에 다시 본다.
+		int waitCount = 0;
+		for (auto& ticket : m_QuickMatchQueue)
+		{
+			auto pUser = ticket.pUser;
+			if (pUser->GetQuickMatchTicket() != ticket.TicketNo || pUser->GetLobbyIndex() != m_LobbyIndex || pUser->IsCurDomainInLobby() == false) {
+				continue;
+			}
+
+			auto pRoom = GetJoinableRoom();
+			if (pRoom == nullptr)
+			{
+				pRoom = GetAvailableRoom();
+				if (pRoom != nullptr) {
+					pRoom->CreateRoom("QuickMatch", 10);
+				}
+			}
+
+			if (pRoom == nullptr || pRoom->EnterUser(pUser) != ERROR_CODE::NONE)
+			{
+				m_QuickMatchQueue[waitCount++] = ticket;
+				continue;
+			}
+
+			CancelQuickMatch(pUser);
+			pUser->EnterRoom(m_LobbyIndex, pRoom->GetIndex());
+
+			pRoom->NotifyEnterUserInfo(pUser->GetIndex(), pUser->GetID().c_str());
+			pRoom->NotifyQuickMatch(pUser->GetSessionIndex());
+		}
+
+		m_QuickMatchQueue.resize(waitCount);
+	}
+
+	void Lobby::OnRoomChanged(Room* pRoom)
+	{
+		auto roomIndex = pRoom->GetIndex();
+		auto isUsed = pRoom->IsUsed();
+		auto hasSeat = isUsed && pRoom->GetUserCount() < pRoom->MaxUserCount();
+		auto gameState = pRoom->GetGameObj()->GetState();
+		auto isWaiting = isUsed && gameState == GameState::NONE;
+		auto isPlaying = isUsed && (gameState == GameState::STARTING || gameState == GameState::ING);
+
+		m_FreeRoomSet.Update(roomIndex, isUsed == false);
+		m_UsedRoomSet.Update(roomIndex, isUsed);
+		m_HasSeatRoomSet.Update(roomIndex, hasSeat);
+		m_WaitingRoomSet.Update(roomIndex, isWaiting);
+		m_JoinableRoomSet.Update(roomIndex, hasSeat && isWaiting);
+		m_RoomTickScheduler.SetActive(pRoom, isPlaying);
+
+		UpdateRoomSummary(pRoom);
+		m_ChangedRoomSet.Set(roomIndex);
+	}
+
+	void Lobby::UpdateRoomSummary(Room* pRoom)
+	{
+		auto& summary = m_RoomSummaryList[pRoom->GetIndex()];
+		summary.RoomIndex = pRoom->GetIndex();
+		summary.RoomUserCount = pRoom->GetUserCount();
+		summary.RoomMaxUserCount = pRoom->MaxUserCount();
+		summary.GameState = (short)pRoom->GetGameObj()->GetState();
+		summary.RoomTitleLength = pRoom->GetTitleLength();
+		memcpy(summary.RoomTitle, pRoom->GetTitle(), summary.RoomTitleLength);
+	}
+
+	void Lobby::SendRoomList(const int sessionIndex, const short startRoomIndex, const bool isOnlyHasSeat, const bool isOnlyWaiting)
+	{
+		// 필터에 맞는 룸 집합을 골라서 StartRoomIndex 부터 차례로 담는다.
+		auto pRoomSet = &m_UsedRoomSet;
+		if (isOnlyHasSeat && isOnlyWaiting) {
+			pRoomSet = &m_JoinableRoomSet;
+		}
+		else if (isOnlyHasSeat) {
+			pRoomSet = &m_HasSeatRoomSet;
+		}
+		else if (isOnlyWaiting) {
+			pRoomSet = &m_WaitingRoomSet;
+		}
+
+		// 송신 버퍼에 바로 쓴다.
+		using Layout = NCommon::PktRoomListResLayout;
+		auto pBody = m_pRefNetwork->ReserveSend(sessionIndex, (short)PACKET_ID::ROOM_LIST_RES, Layout::MaxSize);
+		if (pBody == nullptr) {
+			return;
+		}
+
+		short roomCount = 0;
+		short dataSize = 0;
+		auto roomIndex = pRoomSet->FindNext(startRoomIndex);
+		while (roomIndex >= 0 && roomCount < NCommon::MAX_ROOM_LIST_COUNT)
+		{
+			auto& summary = m_RoomSummaryList[roomIndex];
+			memcpy(pBody + Layout::RoomList_Offset + dataSize, &summary, summary.GetSendSize());
+			dataSize += summary.GetSendSize();
+			++roomCount;
+
+			roomIndex = pRoomSet->FindNext(roomIndex + 1);
+		}
+
+		NCommon::WritePacketField(pBody + Layout::ErrorCode_Offset, (short)ERROR_CODE::NONE);
+		NCommon::WritePacketField(pBody + Layout::NextRoomIndex_Offset, (short)roomIndex);
+		NCommon::WritePacketField(pBody + Layout::RoomCount_Offset, roomCount);
+
+		m_pRefNetwork->CommitSend(sessionIndex, (short)(Layout::RoomList_Offset + dataSize));
+	}
+
+	void Lobby::SendRoomChangedInfo()
+	{
+		if (m_ChangedRoomSet.Count() == 0) {
+			return;
+		}
+
+		// 한 틱 동안 여러 번 바뀐 룸도 마지막 상태로 한 번만 보낸다.
+		NCommon::PktRoomChangedInfoNtf ntfPkt;
+		short dataSize = 0;
+		auto roomIndex = m_ChangedRoomSet.FindFirst();
+		while (roomIndex >= 0)
 		{
-			if (m_RoomList[i]->IsUsed() == false) {
-				return m_RoomList[i];
+			auto& summary = m_RoomSummaryList[roomIndex];
+			memcpy(&ntfPkt.RoomList[dataSize], &summary, summary.GetSendSize());
+			dataSize += summary.GetSendSize();
+			++ntfPkt.RoomCount;
+
+			m_ChangedRoomSet.Reset(roomIndex);
+			roomIndex = m_ChangedRoomSet.FindNext(roomIndex + 1);
+
+			if (ntfPkt.RoomCount == NCommon::MAX_ROOM_LIST_COUNT || roomIndex < 0)
+			{
+				auto sendSize = sizeof(ntfPkt) - sizeof(ntfPkt.RoomList) + dataSize;
+				SendToAllUser((short)PACKET_ID::ROOM_CHANGED_INFO_NTF, (short)sendSize, (char*)&ntfPkt);
+				ntfPkt.RoomCount = 0;
+				dataSize = 0;
 			}
 		}
-		return nullptr;
+	}
+
+	ERROR_CODE Lobby::Chat(User* pUser, const char* pMsg, const short msgLength)
+	{
+		auto curMilliSec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		if (pUser->ConsumeChatToken(curMilliSec, m_ChatPerSec, m_ChatBurstCount) == false) {
+			return ERROR_CODE::LOBBY_CHAT_TOO_MANY;
+		}
+
+		if (msgLength <= 0) {
+			return ERROR_CODE::NONE;
+		}
+
+		// 이번 틱에 모은 것이 넘치면 먼저 보내고 다시 모은다.
+		auto entrySize = (short)(sizeof(NCommon::LobbyChatEntry) + msgLength);
+		if (m_ChatNtfDataSize + entrySize > NCommon::MAX_LOBBY_CHAT_NTF_DATA_SIZE) {
+			SendChat();
+		}
+
+		NCommon::LobbyChatEntry entry;
+		auto& userID = pUser->GetID();
+		memcpy(entry.UserID, userID.c_str(), sizeof(entry.UserID));
+		entry.MsgLength = msgLength;
+
+		auto pWrite = &m_ChatNtf.Data[m_ChatNtfDataSize];
+		memcpy(pWrite, &entry, sizeof(entry));
+		memcpy(pWrite + sizeof(entry), pMsg, msgLength);
+
+		m_ChatNtfDataSize += entrySize;
+		++m_ChatNtf.ChatCount;
+		return ERROR_CODE::NONE;
+	}
+
+	void Lobby::SendChat()
+	{
+		if (m_ChatNtf.ChatCount == 0) {
+			return;
+		}
+
+		auto sendSize = (short)(sizeof(m_ChatNtf.ChatCount) + m_ChatNtfDataSize);
+		SendToAllUser((short)PACKET_ID::LOBBY_CHAT_NTF, sendSize, (char*)&m_ChatNtf);
+
+		m_ChatNtf.ChatCount = 0;
+		m_ChatNtfDataSize = 0;
 	}
 
 	Room* Lobby::GetRoom(const short roomIndex)
 	{
 		if(IsInBounds<short>(roomIndex, 0, (short)m_RoomList.size()))
-			return m_RoomList[roomIndex];
+			return &m_RoomList[roomIndex];
 
 		return nullptr;
 	}
@@ -1,9 +1,16 @@
-#pragma once
+﻿#pragma once
 
 #include <vector>
+#include <memory>
 #include <unordered_map>
 
-//#include "Room.h"
+#include "../Common/Packet.h"
+#include "UserIDMap.h"
+#include "IndexBitSet.h"
+
+#include "Room.h"
+#include "TimerService.h"
+#include "RoomTickScheduler.h"
 
 namespace NServerNetLib
 {
@@ -28,33 +35,74 @@ namespace NLogicLib
 
 	class User;
 	class Room;
+	class LobbyManager;
 	
 	struct LobbyUser
 	{
 		short Index = 0;
 		User* pUser = nullptr;
+		short NextFreeIndex = -1; //비어 있는 슬롯끼리 잇는 스택. pUser 가 nullptr 일 때만 의미가 있다.
+	};
+
+	struct QuickMatchTicket
+	{
+		User* pUser = nullptr;
+		int TicketNo = 0;
 	};
 
 	class Lobby
 	{
 	public:
 		Lobby();
+		Lobby(Lobby&&) = default; //LobbyManager 가 resize 로 만든다
 		virtual ~Lobby();
 
 		void Init(const short lobbyIndex, const short maxLobbyUserCount, const short maxRoomCountByLobby, const short maxRoomUserCount);
 		void Release();
 		void SetNetwork(TcpNet* pNetwork, ILog* pLogger);
+		void SetLobbyManager(LobbyManager* pLobbyMgr) { m_pRefLobbyMgr = pLobbyMgr; }
+		void SetChatRateLimit(const int chatPerSec, const int chatBurstCount) { m_ChatPerSec = chatPerSec; m_ChatBurstCount = chatBurstCount; }
+		void SetRoomTick(const int tickPerSec, const int maxRoomUpdatePerTick);
 		short GetIndex() { return m_LobbyIndex; }
 
+		// 이 로비의 룸이 쓰는 타이머. 로비를 맡은 스레드에서만 쓰고, 그 스레드의 StateCheck 에서 UpdateTimer 로 돌린다.
+		// curMilliSec 은 StateCheck 가 루프마다 한 번 읽은 steady_clock 밀리초(리플레이는 기록된 시간).
+		TimerService* GetTimerService() { return m_pTimerService.get(); }
+		void UpdateTimer(const int64_t curMilliSec);
+
+		// 마지막 UpdateTimer 의 시간. 룸이 라운드 시간을 잴 때 룸 틱과 같은 시계를 쓰도록 여기서 읽는다.
+		int64_t GetCurMilliSec() { return m_CurMilliSec; }
+
+		// 게임 중인 룸만 고정 간격으로 Room::Update 한다. UpdateTimer 와 같은 스레드에서 같은 시간으로 부른다.
+		void UpdateRoomTick(const int64_t curMilliSec);
+		int GetActiveRoomCount() { return m_RoomTickScheduler.ActiveRoomCount(); }
+		RoomTickStats& GetRoomTickStats() { return m_RoomTickScheduler.GetStats(); }
+
 		ERROR_CODE EnterUser(User* pUser);
 		ERROR_CODE LeaveUser(const int userIndex);
 		
 		short GetUserCount();
 		
 		Room* GetAvailableRoom();
+		Room* GetJoinableRoom();
 		Room* GetRoom(const short roomIndex);
 		short MaxUserCount() { return (short)m_MaxUserCount; }
 		short MaxRoomCount() { return (short)m_RoomList.size(); }
+		short GetUsedRoomCount();
+
+		ERROR_CODE RequestQuickMatch(User* pUser);
+		void CancelQuickMatch(User* pUser);
+		void ProcessQuickMatch();
+
+		void SendRoomList(const int sessionIndex, const short startRoomIndex, const bool isOnlyHasSeat, const bool isOnlyWaiting);
+		void SendRoomChangedInfo();
+
+		// 채팅은 모아 두었다가 SendChat 에서 로비 유저마다 LOBBY_CHAT_NTF 하나로 보낸다.
+		ERROR_CODE Chat(User* pUser, const char* pMsg, const short msgLength);
+		void SendChat();
+
+		// 룸의 사용 여부, 인원, 게임 상태가 바뀌면 Room 이 불러서 룸 인덱스 집합을 갱신한다.
+		void OnRoomChanged(Room* pRoom);
 
 	protected:
 		void SendToAllUser(const short packetId, const short dataSize, char* pData, const int passUserindex = -1);
@@ -62,19 +110,46 @@ namespace NLogicLib
 	protected:
 		User* FindUser(const int userIndex);
 		ERROR_CODE AddUser(User* pUser);
-		void RemoveUser(const int userIndex);
+		void RemoveUser(User* pUser);
+		void NotifyUserCountChanged();
+		void UpdateRoomSummary(Room* pRoom);
 
 	protected:
 		ILog* m_pRefLogger;
 		TcpNet* m_pRefNetwork;
+		LobbyManager* m_pRefLobbyMgr = nullptr;
 
 		short m_LobbyIndex = 0;
 		short m_MaxUserCount = 0;
 		std::vector<LobbyUser> m_UserList;
-		std::unordered_map<int, User*> m_UserIndexDic;
-		std::unordered_map<const char*, User*> m_UserIDDic;
+		short m_FreeUserSlotHead = -1;
+		std::vector<User*> m_UserIndexList; //유저 인덱스(UserManager 풀의 위치)로 바로 찾는다
+		short m_UserCount = 0;
+		UserIDMap m_UserIDDic;
+
+		std::vector<Room> m_RoomList; //룸과 게임 객체를 한 덩어리로 잡아 둔다. Init 이후에는 크기를 바꾸지 않는다
+		std::unique_ptr<TimerService> m_pTimerService;
+		int64_t m_CurMilliSec = 0;
+		RoomTickScheduler m_RoomTickScheduler;
+
+		IndexBitSet m_FreeRoomSet;		//사용하지 않는 룸
+		IndexBitSet m_HasSeatRoomSet;	//사용 중이고 빈 자리가 있는 룸
+		IndexBitSet m_WaitingRoomSet;	//사용 중이고 게임을 하지 않는(GameState::NONE) 룸
+		IndexBitSet m_JoinableRoomSet;	//빈 자리가 있고 게임 대기 중인 룸. 빠른 입장에서 쓴다
+		IndexBitSet m_UsedRoomSet;		//사용 중인 룸. 룸 목록에서 쓴다
+
+		// 룸 목록/변경 통보에 그대로 복사해 넣을 룸 요약. 바뀐 룸만 다시 만든다.
+		std::vector<NCommon::RoomSmallInfo> m_RoomSummaryList;
+		IndexBitSet m_ChangedRoomSet;	//이번 틱에 바뀌어서 ROOM_CHANGED_INFO_NTF 로 보낼 룸
+
+		// 취소는 유저의 표만 지우고 대기열에서는 ProcessQuickMatch 때 걸러낸다.
+		std::vector<QuickMatchTicket> m_QuickMatchQueue;
+		int m_QuickMatchTicketSeq = 0;
 
-		std::vector<Room*> m_RoomList;
+		int m_ChatPerSec = 0;		//유저 한 명이 1초에 보낼 수 있는 채팅 수. 0 이면 제한 없음
+		int m_ChatBurstCount = 0;	//한꺼번에 몰아서 보낼 수 있는 채팅 수
+		NCommon::PktLobbyChatNtf m_ChatNtf; //이번 틱에 모은 채팅
+		short m_ChatNtfDataSize = 0;
 	};
 }
 
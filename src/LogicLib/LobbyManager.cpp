@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <string.h>
+
 #include "../ServerNetLib/ILog.h"
 #include "../ServerNetLib/TcpNetwork.h"
 #include "../Common/Packet.h"
+#include "../Common/PacketSchema.h"
 #include "../Common/ErrorCode.h"
 
 #include "Lobby.h"
@@ -13,7 +17,12 @@ namespace NLogicLib
 {
 	LobbyManager::LobbyManager() {}
 
-	LobbyManager::~LobbyManager() {}
+	LobbyManager::~LobbyManager()
+	{
+		for (auto& lobby : m_LobbyList) {
+			lobby.Release();
+		}
+	}
 
 
 	void LobbyManager::Init(const LobbyManagerConfig config, TcpNet* pNetwork, ILog* pLogger)
@@ -21,13 +30,17 @@ namespace NLogicLib
 		m_pRefLogger = pLogger;
 		m_pRefNetwork = pNetwork;
 
+		//  ڱ κ ּҸ  Ƿ κ ڸ ʱȭϰ  ű ʴ´.
+		m_LobbyList.resize(config.MaxLobbyCount);
+
 		for (int i = 0; i < config.MaxLobbyCount; ++i)
 		{
-			Lobby lobby;
+			auto& lobby = m_LobbyList[i];
 			lobby.Init((short)i, (short)config.MaxLobbyUserCount, (short)config.MaxRoomCountByLobby, (short)config.MaxRoomUserCount);
 			lobby.SetNetwork(m_pRefNetwork, m_pRefLogger);
-
-			m_LobbyList.push_back(lobby);
+			lobby.SetLobbyManager(this);
+			lobby.SetChatRateLimit(config.LobbyChatPerSec, config.LobbyChatBurstCount);
+			lobby.SetRoomTick(config.RoomTickPerSec, config.MaxRoomUpdatePerTick);
 		}
 	}
 
@@ -39,25 +52,110 @@ namespace NLogicLib
 
 		return &m_LobbyList[lobbyId];
 	}
+
+	int LobbyManager::GetLobbyCount()
+	{
+		return (int)m_LobbyList.size();
+	}
 		
-	void LobbyManager::SendLobbyListInfo(const int sessionIndex)
+	void LobbyManager::SendLobbyListInfo(const int sessionIndex, const int clientVersion)
 	{
-		NCommon::PktLobbyListRes resPkt;
+		if (m_IsLobbyListChanged) {
+			RebuildLobbyListSnapshot();
+		}
+
+		if (clientVersion == m_LobbyListSnapshot.Version)
+		{
+			using Writer = NCommon::PktLobbyListResWriter;
+			auto pBody = m_pRefNetwork->ReserveSend(sessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, Writer::Layout::MinSize);
+			if (pBody == nullptr) {
+				return;
+			}
+
+			auto sendSize = Writer::Encode(pBody, Writer::Layout::MinSize, (short)ERROR_CODE::NONE, m_LobbyListSnapshot.Version, true, 0, nullptr);
+			m_pRefNetwork->CommitSend(sessionIndex, (short)sendSize);
+			return;
+		}
+
+		m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, m_LobbyListSnapshotSize, (char*)&m_LobbyListSnapshot);
+	}
+
+	void LobbyManager::SendLegacyLobbyListInfo(const int sessionIndex)
+	{
+		if (m_IsLobbyListChanged) {
+			RebuildLobbyListSnapshot();
+		}
+
+		m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, sizeof(m_LegacyLobbyListSnapshot), (char*)&m_LegacyLobbyListSnapshot);
+	}
+
+	void LobbyManager::RebuildLobbyListSnapshot()
+	{
+		auto& resPkt = m_LobbyListSnapshot;
 		resPkt.ErrorCode = (short)ERROR_CODE::NONE;
-		resPkt.LobbyCount = static_cast<short>(m_LobbyList.size());
+		resPkt.IsNotModified = false;
+		resPkt.LobbyCount = static_cast<short>(std::min((int)m_LobbyList.size(), NCommon::MAX_LOBBY_LIST_COUNT));
+
+		for (int i = 0; i < resPkt.LobbyCount; ++i)
+		{
+			auto& lobby = m_LobbyList[i];
+			resPkt.LobbyList[i].LobbyId = lobby.GetIndex();
+			resPkt.LobbyList[i].LobbyUserCount = lobby.GetUserCount();
+			resPkt.LobbyList[i].LobbyMaxUserCount = lobby.MaxUserCount();
+		}
+
+		// 0  Ŭ̾Ʈ    ʾҴٴ  Ƿ ǳʶڴ.
+		if (++resPkt.Version <= 0) {
+			resPkt.Version = 1;
+		}
+
+		m_LobbyListSnapshotSize = (short)(sizeof(resPkt) - (NCommon::MAX_LOBBY_LIST_COUNT - resPkt.LobbyCount) * sizeof(NCommon::LobbyListInfo));
 
-		int index = 0;
+		auto& legacyPkt = m_LegacyLobbyListSnapshot;
+		legacyPkt.ErrorCode = (short)ERROR_CODE::NONE;
+		legacyPkt.LobbyCount = resPkt.LobbyCount;
+		memcpy(legacyPkt.LobbyList, resPkt.LobbyList, sizeof(legacyPkt.LobbyList));
+
+		m_IsLobbyListChanged = false;
+	}
+
+	void LobbyManager::UpdateTimer(const int64_t curMilliSec)
+	{
 		for (auto& lobby : m_LobbyList)
 		{
-			resPkt.LobbyList[index].LobbyId = lobby.GetIndex();
-			resPkt.LobbyList[index].LobbyUserCount = lobby.GetUserCount();
-			resPkt.LobbyList[index].LobbyMaxUserCount = lobby.MaxUserCount();
+			lobby.UpdateTimer(curMilliSec);
+		}
+	}
 
-			++index;
+	void LobbyManager::UpdateRoomTick(const int64_t curMilliSec)
+	{
+		for (auto& lobby : m_LobbyList)
+		{
+			lobby.UpdateRoomTick(curMilliSec);
 		}
+	}
 
-		//  ͸ ̱    LobbyListInfo ũ   ȴ.
-		m_pRefNetwork->SendData(sessionIndex, (short)PACKET_ID::LOBBY_LIST_RES, sizeof(resPkt), (char*)&resPkt);
+	void LobbyManager::ProcessQuickMatch()
+	{
+		for (auto& lobby : m_LobbyList)
+		{
+			lobby.ProcessQuickMatch();
+		}
 	}
 
+	void LobbyManager::SendRoomChangedInfo()
+	{
+		for (auto& lobby : m_LobbyList)
+		{
+			lobby.SendRoomChangedInfo();
+		}
+	}
+
+	void LobbyManager::SendLobbyChat()
+	{
+		for (auto& lobby : m_LobbyList)
+		{
+			lobby.SendChat();
+		}
+	}
 }
\ No newline at end of file
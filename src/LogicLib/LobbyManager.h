@@ -1,7 +1,9 @@
-#pragma once
+﻿#pragma once
 #include <vector>
 #include <unordered_map>
 
+#include "../Common/Packet.h"
+
 namespace NServerNetLib
 {
 	class TcpNetwork;
@@ -20,6 +22,12 @@ namespace NLogicLib
 		int MaxLobbyUserCount;
 		int MaxRoomCountByLobby;
 		int MaxRoomUserCount;
+
+		int LobbyChatPerSec = 0;	//로비 채팅 횟수 제한. 0 이면 제한 없음
+		int LobbyChatBurstCount = 0;
+
+		int RoomTickPerSec = 20;		//게임 중인 룸을 Update 하는 횟수
+		int MaxRoomUpdatePerTick = 0;	//로비마다 한 틱에 Update 할 룸 수. 0 이면 제한 없음
 	};
 
 	struct LobbySmallInfo
@@ -41,15 +49,33 @@ namespace NLogicLib
 
 		void Init(const LobbyManagerConfig config, TcpNet* pNetwork, ILog* pLogger);
 		Lobby* GetLobby(short lobbyId);
+		int GetLobbyCount();
 
 	public:
-		void SendLobbyListInfo(const int sessionIndex);
+		void SendLobbyListInfo(const int sessionIndex, const int clientVersion = 0);
+		void SendLegacyLobbyListInfo(const int sessionIndex);
+		void UpdateTimer(const int64_t curMilliSec);
+		void UpdateRoomTick(const int64_t curMilliSec);
+		void ProcessQuickMatch();
+		void SendRoomChangedInfo();
+		void SendLobbyChat();
+
+		void OnLobbyUserCountChanged() { m_IsLobbyListChanged = true; }
+
+	private:
+		void RebuildLobbyListSnapshot();
 
 	private:
 		ILog* m_pRefLogger;
 		TcpNet* m_pRefNetwork;
 
 		std::vector<Lobby> m_LobbyList;
+
+		// 로비 목록 응답을 미리 만들어 두고 로비 인원이 바뀐 뒤 첫 요청 때만 다시 만든다.
+		NCommon::PktLobbyListRes m_LobbyListSnapshot;
+		short m_LobbyListSnapshotSize = 0;
+		NCommon::PktLobbyListLegacyRes m_LegacyLobbyListSnapshot;
+		bool m_IsLobbyListChanged = true;
 		
 	};
 }
\ No newline at end of file
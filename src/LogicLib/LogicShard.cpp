@@ -0,0 +1,296 @@
+﻿#include <string.h>
+#include <stddef.h>
+
+#include "../ServerNetLib/ILog.h"
+#include "../ServerNetLib/ITcpNetwork.h"
+#include "User.h"
+#include "UserManager.h"
+#include "Lobby.h"
+#include "LobbyManager.h"
+#include "PacketProcess.h"
+#include "TaskScheduler.h"
+#include "LogicShard.h"
+
+using LOG_TYPE = NServerNetLib::LOG_TYPE;
+using NET_ERROR_CODE = NServerNetLib::NET_ERROR_CODE;
+
+namespace NLogicLib
+{
+	void ShardNetwork::SetRequest(const RecvPacketInfo& packetInfo)
+	{
+		m_RequestSessionIndex = packetInfo.SessionIndex;
+		m_RequestSeq = packetInfo.RequestSeq;
+		m_ReplyPacketId = NCommon::GetPacketResponseId(packetInfo.PacketId);
+	}
+
+	NET_ERROR_CODE ShardNetwork::SendData(const int sessionIndex, const short packetId, const short size, const char* pMsg)
+	{
+		auto pBody = ReserveSend(sessionIndex, packetId, size);
+		if (pBody == nullptr) {
+			return NET_ERROR_CODE::CLIENT_SEND_BUFFER_FULL;
+		}
+
+		if (size > 0) {
+			memcpy(pBody, pMsg, size);
+		}
+		return CommitSend(sessionIndex, size);
+	}
+
+	char* ShardNetwork::ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize)
+	{
+		if (m_IsBuffering == false) {
+			return m_pRefNetwork->ReserveSend(sessionIndex, packetId, maxBodySize);
+		}
+
+		if (maxBodySize < 0) {
+			return nullptr;
+		}
+
+		auto needSize = m_SendQueueSize + (int)sizeof(SendRecord) + maxBodySize;
+		if (needSize > (int)m_SendQueue.size()) {
+			m_SendQueue.resize(needSize * 2);
+		}
+
+		SendRecord record;
+		record.SessionIndex = sessionIndex;
+		record.RequestSeq = (sessionIndex == m_RequestSessionIndex && packetId == m_ReplyPacketId) ? m_RequestSeq : -1;
+		record.PacketId = packetId;
+		record.BodySize = maxBodySize;
+		memcpy(&m_SendQueue[m_SendQueueSize], &record, sizeof(SendRecord));
+
+		m_ReservedBodySize = maxBodySize;
+		return &m_SendQueue[m_SendQueueSize + (int)sizeof(SendRecord)];
+	}
+
+	NET_ERROR_CODE ShardNetwork::CommitSend(const int sessionIndex, const short bodySize)
+	{
+		if (m_IsBuffering == false) {
+			return m_pRefNetwork->CommitSend(sessionIndex, bodySize);
+		}
+
+		auto reservedBodySize = m_ReservedBodySize;
+		m_ReservedBodySize = -1;
+
+		if (reservedBodySize < 0) {
+			return NET_ERROR_CODE::CLIENT_SEND_NOT_RESERVED;
+		}
+		if (bodySize < 0) {
+			return NET_ERROR_CODE::NONE;
+		}
+		if (bodySize > reservedBodySize) {
+			return NET_ERROR_CODE::CLIENT_SEND_RESERVE_SIZE_OVER;
+		}
+
+		// Body 는 정렬하지 않고 붙이므로 레코드도 memcpy 로 고친다.
+		memcpy(&m_SendQueue[m_SendQueueSize + offsetof(SendRecord, BodySize)], &bodySize, sizeof(bodySize));
+		m_SendQueueSize += (int)sizeof(SendRecord) + bodySize;
+		return NET_ERROR_CODE::NONE;
+	}
+
+	void ShardNetwork::ForcingClose(const int sessionIndex)
+	{
+		if (m_IsBuffering == false)
+		{
+			m_pRefNetwork->ForcingClose(sessionIndex);
+			return;
+		}
+
+		auto pBody = ReserveSend(sessionIndex, 0, 0);
+		if (pBody != nullptr) {
+			CommitSend(sessionIndex, 0);
+		}
+	}
+
+	/*
+	모아 둔 패킷을 모은 순서대로 진짜 네트워크에 넘긴다. 로직 스레드에서 부른다.
+	*/
+	void ShardNetwork::Drain()
+	{
+		auto readPos = 0;
+		while (readPos < m_SendQueueSize)
+		{
+			SendRecord record;
+			memcpy(&record, &m_SendQueue[readPos], sizeof(SendRecord));
+			auto pBody = &m_SendQueue[readPos + (int)sizeof(SendRecord)];
+			readPos += (int)sizeof(SendRecord) + record.BodySize;
+
+			if (record.PacketId == 0)
+			{
+				m_pRefNetwork->ForcingClose(record.SessionIndex);
+				continue;
+			}
+
+			m_pRefNetwork->SetReplySequence(record.SessionIndex, record.RequestSeq, record.PacketId);
+			m_pRefNetwork->SendData(record.SessionIndex, record.PacketId, record.BodySize, pBody);
+		}
+
+		if (m_SendQueueSize > 0) {
+			m_pRefNetwork->SetReplySequence(-1, -1, 0);
+		}
+		m_SendQueueSize = 0;
+	}
+
+
+	LogicShardPool::LogicShardPool() {}
+
+	LogicShardPool::~LogicShardPool()
+	{
+		Release();
+	}
+
+	void LogicShardPool::Init(const int shardCount, TaskScheduler* pScheduler, PacketProcess* pPacketProc, TcpNet* pNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, ServerMetrics* pMetrics, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+		m_pRefScheduler = pScheduler;
+		m_pRefPacketProc = pPacketProc;
+		m_pRefUserMgr = pUserMgr;
+
+		if (shardCount <= 0) {
+			return;
+		}
+
+		m_SessionFlushSeq.resize(pNetwork->ClientSessionPoolSize(), 0);
+
+		for (int i = 0; i < shardCount; ++i)
+		{
+			auto pShard = std::make_unique<Shard>();
+			pShard->Network.Init(pNetwork);
+			pShard->pPacketProc = std::make_unique<PacketProcess>();
+			pShard->pPacketProc->InitShard(&pShard->Network, pUserMgr, pLobbyMgr, pLogger);
+			pShard->pPacketProc->SetMetrics(pMetrics);
+			m_ShardList.push_back(std::move(pShard));
+		}
+
+		// 로비와 그 룸이 보내는 패킷은 로비를 맡은 샤드의 네트워크로 간다.
+		for (int i = 0; i < pLobbyMgr->GetLobbyCount(); ++i)
+		{
+			auto pLobby = pLobbyMgr->GetLobby((short)i);
+			auto& shard = *m_ShardList[i % shardCount];
+			pLobby->SetNetwork(&shard.Network, pLogger);
+			shard.LobbyList.push_back(pLobby);
+		}
+
+		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | LogicShardCount(%d), LobbyCount(%d), TaskWorkerCount(%d)", __FUNCTION__, shardCount, pLobbyMgr->GetLobbyCount(), pScheduler->WorkerCount());
+	}
+
+	void LogicShardPool::Release()
+	{
+		m_ShardList.clear();
+	}
+
+	void LogicShardPool::Process(const PacketInfo& packetInfo)
+	{
+		if (m_ShardList.empty())
+		{
+			m_pRefNetwork->SetReplySequence(packetInfo.SessionIndex, packetInfo.RequestSeq, NCommon::GetPacketResponseId(packetInfo.PacketId));
+			m_pRefPacketProc->Process(packetInfo);
+			return;
+		}
+
+		auto shardIndex = FindShardIndex(packetInfo);
+		if (shardIndex >= 0)
+		{
+			m_ShardList[shardIndex]->PacketList.push_back(packetInfo);
+			m_SessionFlushSeq[packetInfo.SessionIndex] = m_FlushSeq;
+			m_HasShardPacket = true;
+			return;
+		}
+
+		// 같은 세션이 앞서 보낸 요청이 샤드에 남아 있으면 응답 순서를 지키도록 먼저 처리한다.
+		if (m_SessionFlushSeq[packetInfo.SessionIndex] == m_FlushSeq) {
+			Flush();
+		}
+
+		m_pRefNetwork->SetReplySequence(packetInfo.SessionIndex, packetInfo.RequestSeq, NCommon::GetPacketResponseId(packetInfo.PacketId));
+		m_pRefPacketProc->Process(packetInfo);
+	}
+
+	/*
+	로비 안에서 끝나는 패킷이면 그 로비를 맡은 샤드. 로비에 없는 유저가 보냈으면 에러 응답을 로직 스레드에서 보내도록 -1.
+	유저의 로비는 로직 스레드에서 처리하는 로비 입장/퇴장 때만 바뀌므로 여기서 읽어도 된다.
+	*/
+	int LogicShardPool::FindShardIndex(const PacketInfo& packetInfo)
+	{
+		if (m_pRefPacketProc->IsLobbyPacket(packetInfo.PacketId) == false) {
+			return -1;
+		}
+
+		auto pUser = std::get<1>(m_pRefUserMgr->GetUser(packetInfo.SessionIndex));
+		if (pUser == nullptr || pUser->GetLobbyIndex() < 0) {
+			return -1;
+		}
+
+		return pUser->GetLobbyIndex() % (int)m_ShardList.size();
+	}
+
+	void LogicShardPool::Flush()
+	{
+		if (m_HasShardPacket == false) {
+			return;
+		}
+
+		RunShards(false, 0);
+	}
+
+	void LogicShardPool::StateCheck(const int64_t curMilliSec)
+	{
+		if (m_ShardList.empty())
+		{
+			m_pRefPacketProc->StateCheck(curMilliSec);
+			return;
+		}
+
+		RunShards(true, curMilliSec);
+
+		// 로그인 검사는 여러 로비에 걸친 접속 관리라 로직 스레드에서 한다.
+		m_pRefPacketProc->LoginCheck();
+	}
+
+	void LogicShardPool::RunShards(const bool isStateCheck, const int64_t curMilliSec)
+	{
+		TaskGroup group;
+		for (int i = 0; i < (int)m_ShardList.size(); ++i)
+		{
+			m_pRefScheduler->SubmitTo(i, group, [this, i, isStateCheck, curMilliSec]() { ProcessShard(i, isStateCheck, curMilliSec); });
+		}
+		m_pRefScheduler->Wait(group);
+
+		// 샤드 순서대로 넘기므로 한 세션이 받는 패킷은 요청 순서를 지킨다(한 유저는 한 샤드에만 있다).
+		for (auto& pShard : m_ShardList)
+		{
+			pShard->Network.Drain();
+			pShard->PacketList.clear();
+		}
+
+		m_HasShardPacket = false;
+		++m_FlushSeq;
+	}
+
+	void LogicShardPool::ProcessShard(const int shardIndex, const bool isStateCheck, const int64_t curMilliSec)
+	{
+		auto& shard = *m_ShardList[shardIndex];
+
+		shard.Network.SetBuffering(true);
+		for (auto& packetInfo : shard.PacketList)
+		{
+			shard.Network.SetRequest(packetInfo);
+			shard.pPacketProc->Process(packetInfo);
+		}
+
+		if (isStateCheck)
+		{
+			// 요청이 아니라 틱에서 보내는 알림이므로 순번을 붙이지 않는다.
+			shard.Network.SetRequest(PacketInfo());
+			for (auto pLobby : shard.LobbyList)
+			{
+				pLobby->UpdateTimer(curMilliSec);
+				pLobby->UpdateRoomTick(curMilliSec);
+				pLobby->ProcessQuickMatch();
+				pLobby->SendRoomChangedInfo();
+				pLobby->SendChat();
+			}
+		}
+		shard.Network.SetBuffering(false);
+	}
+}
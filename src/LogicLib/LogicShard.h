@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "../ServerNetLib/ITcpNetwork.h"
+
+namespace NLogicLib
+{
+	class PacketProcess;
+	class UserManager;
+	class LobbyManager;
+	class Lobby;
+	class ServerMetrics;
+	class TaskScheduler;
+
+	using TcpNet = NServerNetLib::ITcpNetwork;
+	using ILog = NServerNetLib::ILog;
+
+	// 로직 샤드가 쓰는 네트워크. 샤드 스레드가 패킷을 처리하는 동안에는 보낼 패킷을 모아 두었다가 Drain 에서 진짜 네트워크로 넘기고,
+	// 그 밖(로직 스레드)에서는 바로 넘긴다. 네트워크는 로직 스레드에서만 건드린다.
+	class ShardNetwork : public TcpNet
+	{
+		using NET_ERROR_CODE = NServerNetLib::NET_ERROR_CODE;
+		using RecvPacketInfo = NServerNetLib::RecvPacketInfo;
+
+	public:
+		void Init(TcpNet* pNetwork) { m_pRefNetwork = pNetwork; }
+
+		// 샤드 스레드에서 처리를 시작할 때 켜고 끝나면 끈다.
+		void SetBuffering(const bool isBuffering) { m_IsBuffering = isBuffering; }
+
+		// 지금 처리하는 요청. 이 세션으로 보내는 그 요청의 응답 패킷에 요청 순번을 붙인다.
+		void SetRequest(const RecvPacketInfo& packetInfo);
+
+		void Drain();
+
+		NET_ERROR_CODE SendData(const int sessionIndex, const short packetId, const short size, const char* pMsg) override;
+		char* ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize) override;
+		NET_ERROR_CODE CommitSend(const int sessionIndex, const short bodySize) override;
+
+		int ClientSessionPoolSize() override { return m_pRefNetwork->ClientSessionPoolSize(); }
+		void ForcingClose(const int sessionIndex) override;
+		NServerNetLib::NetStats* GetStats() override { return m_pRefNetwork->GetStats(); }
+
+	private:
+		// 모아 둔 패킷 하나. 바로 뒤에 BodySize 바이트의 Body 가 있다. PacketId 가 0 이면 접속 끊기.
+		struct SendRecord
+		{
+			int SessionIndex;
+			int RequestSeq;
+			short PacketId;
+			short BodySize;
+		};
+
+		TcpNet* m_pRefNetwork = nullptr;
+		bool m_IsBuffering = false;
+
+		int m_RequestSessionIndex = -1;
+		int m_RequestSeq = -1;
+		short m_ReplyPacketId = 0;
+
+		std::vector<char> m_SendQueue;
+		int m_SendQueueSize = 0;
+		short m_ReservedBodySize = -1;
+	};
+
+	// 로비 단위로 나눈 로직 샤드들. 로비와 그 룸은 한 샤드(lobbyIndex % 샤드 수)만 건드린다.
+	// 로그인, 로비 목록, 로비 입장/퇴장, 접속 끊김처럼 여러 로비에 걸친 패킷은 로직 스레드가 바로 처리하고 유저를 샤드 사이로 옮긴다.
+	// 샤드에 넣은 패킷은 Flush 에서 모든 샤드가 동시에 처리하고, 로직 스레드는 끝날 때까지 기다린다.
+	// 샤드는 TaskScheduler 의 작업 스레드(shardIndex % 작업 스레드 수)에 고정해서 돌리므로 로비 데이터는 늘 같은 스레드의 캐시에 있다.
+	class LogicShardPool
+	{
+		using PacketInfo = NServerNetLib::RecvPacketInfo;
+		using ServerConfig = NServerNetLib::ServerConfig;
+
+	public:
+		LogicShardPool();
+		~LogicShardPool();
+
+		// shardCount 가 0 이면 모든 패킷을 pPacketProc 로 바로 처리한다.
+		void Init(const int shardCount, TaskScheduler* pScheduler, PacketProcess* pPacketProc, TcpNet* pNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, ServerMetrics* pMetrics, ILog* pLogger);
+		void Release();
+
+		void Process(const PacketInfo& packetInfo);
+
+		// 샤드에 쌓인 패킷을 모두 처리하고 보낼 패킷을 네트워크로 넘긴다.
+		void Flush();
+
+		// 루프 끝에 한 번 부른다. 샤드에 쌓인 패킷과 함께 로비별 빠른 입장/룸 변경 알림/로비 채팅도 각 샤드에서 처리한다.
+		void StateCheck(const int64_t curMilliSec);
+
+		int ShardCount() { return (int)m_ShardList.size(); }
+
+	private:
+		int FindShardIndex(const PacketInfo& packetInfo);
+		void RunShards(const bool isStateCheck, const int64_t curMilliSec);
+		void ProcessShard(const int shardIndex, const bool isStateCheck, const int64_t curMilliSec);
+
+	private:
+		struct Shard
+		{
+			std::unique_ptr<PacketProcess> pPacketProc;
+			ShardNetwork Network;
+			std::vector<PacketInfo> PacketList;
+			std::vector<Lobby*> LobbyList;
+		};
+
+		ILog* m_pRefLogger = nullptr;
+		TcpNet* m_pRefNetwork = nullptr;
+		TaskScheduler* m_pRefScheduler = nullptr;
+		PacketProcess* m_pRefPacketProc = nullptr;
+		UserManager* m_pRefUserMgr = nullptr;
+
+		std::vector<std::unique_ptr<Shard>> m_ShardList;
+		bool m_HasShardPacket = false;
+
+		// 세션별로 샤드에 패킷을 넣은 마지막 Flush 번호. 같은 번호면 그 세션의 앞선 요청이 아직 처리되지 않았다.
+		std::vector<int> m_SessionFlushSeq;
+		int m_FlushSeq = 1;
+	};
+}
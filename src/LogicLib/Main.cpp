@@ -1,5 +1,6 @@
-#include <thread>
+﻿#include <thread>
 #include <chrono>
+#include <algorithm>
 
 #include "../ServerNetLib/ServerNetErrorCode.h"
 #include "../ServerNetLib/Define.h"
@@ -7,7 +8,12 @@
 #include "ConsoleLogger.h"
 #include "LobbyManager.h"
 #include "PacketProcess.h"
+#include "LogicShard.h"
+#include "TaskScheduler.h"
 #include "UserManager.h"
+#include "Lobby.h"
+#include "ServerMetrics.h"
+#include "AdminServer.h"
 #include "Main.h"
 
 #include "IniReader.h"
@@ -36,6 +42,22 @@ namespace NLogicLib
 
 		m_pLogger->Write(NServerNetLib::LOG_TYPE::L_INFO, "%s | LoadConfigSuccess.", __FUNCTION__);
 
+		return CreateModules();
+	}
+
+	/*
+	설정 파일 없이 서버를 띄운다. 벤치마크처럼 같은 프로세스 안에서 서버를 돌릴 때 사용한다.
+	*/
+	ERROR_CODE Main::Initialize(const NServerNetLib::ServerConfig& config, std::unique_ptr<NServerNetLib::ILog> pLogger)
+	{
+		m_pLogger = std::move(pLogger);
+		m_pServerConfig = std::make_unique<NServerNetLib::ServerConfig>(config);
+
+		return CreateModules();
+	}
+
+	ERROR_CODE Main::CreateModules()
+	{
 		m_pNetwork = std::make_unique<NServerNetLib::TcpNetwork>();
 		auto result = m_pNetwork->Init(m_pServerConfig.get(), m_pLogger.get());
 		if (result != NET_ERROR_CODE::NONE)
@@ -49,16 +71,32 @@ namespace NLogicLib
 		m_pUserMgr->Init(m_pServerConfig->MaxClientCount);
 
 		m_pLobbyMgr = std::make_unique<LobbyManager>();
-		m_pLobbyMgr->Init({ m_pServerConfig->MaxLobbyCount, 
-							m_pServerConfig->MaxLobbyUserCount,
-							m_pServerConfig->MaxRoomCountByLobby, 
-							m_pServerConfig->MaxRoomUserCount },
-						m_pNetwork.get(), m_pLogger.get());
+		m_pLobbyMgr->Init(MakeLobbyManagerConfig(*m_pServerConfig), m_pNetwork.get(), m_pLogger.get());
 
 		m_pPacketProc = std::make_unique<PacketProcess>();
 		m_pPacketProc->Init(m_pNetwork.get(), m_pUserMgr.get(), m_pLobbyMgr.get(), m_pServerConfig.get(), m_pLogger.get());
 
-		m_IsRun = true;
+		m_pMetrics = std::make_unique<ServerMetrics>();
+		m_pMetrics->Init(m_pLobbyMgr->GetLobbyCount());
+		m_pPacketProc->SetMetrics(m_pMetrics.get());
+		PublishMetrics();
+
+		// 로직 샤드도 작업 스레드에서 돌리므로 샤드 수보다 적으면 샤드 수만큼 띄운다.
+		auto taskWorkerCount = std::max(m_pServerConfig->TaskWorkerCount, m_pServerConfig->LogicShardCount);
+		m_pTaskScheduler = std::make_unique<TaskScheduler>();
+		m_pTaskScheduler->Init(taskWorkerCount, m_pLogger.get());
+		m_pPacketProc->SetScheduler(m_pTaskScheduler.get());
+
+		m_pLogicShardPool = std::make_unique<LogicShardPool>();
+		m_pLogicShardPool->Init(m_pServerConfig->LogicShardCount, m_pTaskScheduler.get(), m_pPacketProc.get(), m_pNetwork.get(), m_pUserMgr.get(), m_pLobbyMgr.get(), m_pMetrics.get(), m_pLogger.get());
+
+		if (m_pServerConfig->AdminSocketPath[0] != '\0')
+		{
+			m_pAdminServer = std::make_unique<AdminServer>();
+			m_pAdminServer->Start(m_pServerConfig->AdminSocketPath, m_pMetrics.get(), m_pNetwork->GetStats(), m_pLogger.get());
+		}
+
+		m_IsRun.store(true);
 
 		m_pLogger->Write(LOG_TYPE::L_INFO, "%s | Init Success. Server Run", __FUNCTION__);
 		return ERROR_CODE::NONE;
@@ -66,6 +104,18 @@ namespace NLogicLib
 
 	void Main::Release() 
 	{
+		if (m_pAdminServer) {
+			m_pAdminServer->Stop();
+		}
+
+		if (m_pLogicShardPool) {
+			m_pLogicShardPool->Release();
+		}
+
+		if (m_pTaskScheduler) {
+			m_pTaskScheduler->Release();
+		}
+
 		if (m_pNetwork) {
 			m_pNetwork->Release();
 		}
@@ -73,12 +123,17 @@ namespace NLogicLib
 
 	void Main::Stop()
 	{
-		m_IsRun = false;
+		m_IsRun.store(false);
+	}
+
+	NServerNetLib::NetStats* Main::GetNetStats()
+	{
+		return m_pNetwork->GetStats();
 	}
 
 	void Main::Run()
 	{
-		while (m_IsRun)
+		while (m_IsRun.load())
 		{
 			m_pNetwork->Run();
 
@@ -91,14 +146,60 @@ namespace NLogicLib
 				}
 				else
 				{
-					m_pPacketProc->Process(packetInfo);
+					// 로비 안에서 끝나는 패킷은 로직 샤드에 쌓아 두었다가 루프 끝의 StateCheck 에서 동시에 처리한다.
+					m_pLogicShardPool->Process(packetInfo);
 				}
 			}
 
-			m_pPacketProc->StateCheck();
+			// 샤드에 남은 패킷과 로비별 주기 처리를 샤드에서 처리한 뒤 로그인 검사를 한다.
+			auto curMilliSec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			m_pLogicShardPool->StateCheck(curMilliSec);
+
+			m_pNetwork->FlushSend();
+
+			PublishMetrics();
 		}
 	}
 
+	/*
+	관리용 소켓에서 읽어 갈 상태 값을 갱신한다. 매 루프마다 할 필요는 없으므로 1초에 한 번만.
+	*/
+	void Main::PublishMetrics()
+	{
+		auto curTime = std::chrono::steady_clock::now();
+		if (m_pMetrics->PublishTimeSec.load(std::memory_order_relaxed) != 0 &&
+			curTime - m_LatestPublishTime < std::chrono::seconds(1))
+		{
+			return;
+		}
+		m_LatestPublishTime = curTime;
+
+		m_pMetrics->UserCount.store(m_pUserMgr->GetUserCount(), std::memory_order_relaxed);
+		m_pMetrics->MaxUserCount.store(m_pUserMgr->MaxUserCount(), std::memory_order_relaxed);
+
+		for (int i = 0; i < m_pMetrics->LobbyCount(); ++i)
+		{
+			auto pLobby = m_pLobbyMgr->GetLobby((short)i);
+			auto& lobbyMetric = m_pMetrics->GetLobbyMetric(i);
+			lobbyMetric.UserCount.store(pLobby->GetUserCount(), std::memory_order_relaxed);
+			lobbyMetric.MaxUserCount.store(pLobby->MaxUserCount(), std::memory_order_relaxed);
+			lobbyMetric.UsedRoomCount.store(pLobby->GetUsedRoomCount(), std::memory_order_relaxed);
+			lobbyMetric.MaxRoomCount.store(pLobby->MaxRoomCount(), std::memory_order_relaxed);
+
+			// 로비 샤드가 쉬는 동안이라 로비 값을 그대로 읽어도 된다.
+			auto& tickStats = pLobby->GetRoomTickStats();
+			lobbyMetric.ActiveRoomCount.store(pLobby->GetActiveRoomCount(), std::memory_order_relaxed);
+			lobbyMetric.RoomTickCount.store(tickStats.TickCount, std::memory_order_relaxed);
+			lobbyMetric.RoomTickOverrunCount.store(tickStats.OverrunCount, std::memory_order_relaxed);
+			lobbyMetric.RoomTickDroppedCount.store(tickStats.DroppedTickCount, std::memory_order_relaxed);
+			lobbyMetric.RoomTickDeferredCount.store(tickStats.DeferredRoomCount, std::memory_order_relaxed);
+			lobbyMetric.RoomTickMaxMicroSec.store(tickStats.MaxTickMicroSec, std::memory_order_relaxed);
+		}
+
+		auto timeSec = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		m_pMetrics->PublishTimeSec.store(timeSec, std::memory_order_relaxed);
+	}
+
 	ERROR_CODE Main::LoadConfig()
 	{
 		m_pServerConfig = std::make_unique<NServerNetLib::ServerConfig>();
@@ -107,30 +208,64 @@ namespace NLogicLib
 #ifdef _WIN32
 		filePath = "../../resources/ServerConfig.ini";
 #endif
-		INIReader reader(filePath);
-
-		if (reader.ParseError() < 0) {
+		if (ReadConfig(filePath.c_str(), *m_pServerConfig) == false) {
 			m_pLogger->Write(NServerNetLib::LOG_TYPE::L_INFO, "%s | Can't load ini." , __FUNCTION__);
 			return ERROR_CODE::MAIN_INIT_NETWORK_INIT_FAIL;
 		}
-
-		m_pServerConfig->Port = (unsigned short)reader.GetInteger("Config", "Port", 0);
-		m_pServerConfig->BackLogCount = reader.GetInteger("Config", "BackLogCount", 0);
-		m_pServerConfig->MaxClientCount = reader.GetInteger("Config", "MaxClientCount", 0);
-		m_pServerConfig->MaxClientSockOptRecvBufferSize = (short)reader.GetInteger("Config", "MaxClientSockOptRecvBufferSize", 0);
-		m_pServerConfig->MaxClientSockOptSendBufferSize = (short)reader.GetInteger("Config", "MaxClientSockOptSendBufferSize", 0);
-		m_pServerConfig->MaxClientRecvBufferSize = (short)reader.GetInteger("Config", "MaxClientRecvBufferSize", 0);
-		m_pServerConfig->MaxClientSendBufferSize = (short)reader.GetInteger("Config", "MaxClientSendBufferSize", 0);
-		m_pServerConfig->IsLoginCheck = reader.GetInteger("Config", "IsLoginCheck", 0);
-		m_pServerConfig->ExtraClientCount = reader.GetInteger("Config", "ExtraClientCount", 0);
-		m_pServerConfig->MaxLobbyCount = reader.GetInteger("Config", "MaxLobbyCount", 0);
-		m_pServerConfig->MaxLobbyUserCount = reader.GetInteger("Config", "MaxLobbyUserCount", 0);
-		m_pServerConfig->MaxRoomCountByLobby = reader.GetInteger("Config", "MaxRoomCountByLobby", 0);
-		m_pServerConfig->MaxRoomUserCount = reader.GetInteger("Config", "MaxRoomUserCount", 0);
 		
 		m_pLogger->Write(NServerNetLib::LOG_TYPE::L_INFO, "%s | Port(%d), Backlog(%d)", __FUNCTION__, m_pServerConfig->Port, m_pServerConfig->BackLogCount);
 		m_pLogger->Write(NServerNetLib::LOG_TYPE::L_INFO, "%s | IsLoginCheck(%d)", __FUNCTION__, m_pServerConfig->IsLoginCheck);
+		m_pLogger->Write(NServerNetLib::LOG_TYPE::L_INFO, "%s | SendFlushMode(%d)", __FUNCTION__, (int)m_pServerConfig->SendFlushMode);
 		return ERROR_CODE::NONE;
 	}
+
+	bool Main::ReadConfig(const char* pszFilePath, NServerNetLib::ServerConfig& config)
+	{
+		INIReader reader(pszFilePath);
+		if (reader.ParseError() < 0) {
+			return false;
+		}
+
+		config.Port = (unsigned short)reader.GetInteger("Config", "Port", 0);
+		config.BackLogCount = reader.GetInteger("Config", "BackLogCount", 0);
+		config.MaxClientCount = reader.GetInteger("Config", "MaxClientCount", 0);
+		config.MaxClientSockOptRecvBufferSize = (short)reader.GetInteger("Config", "MaxClientSockOptRecvBufferSize", 0);
+		config.MaxClientSockOptSendBufferSize = (short)reader.GetInteger("Config", "MaxClientSockOptSendBufferSize", 0);
+		config.MaxClientRecvBufferSize = (short)reader.GetInteger("Config", "MaxClientRecvBufferSize", 0);
+		config.MaxClientSendBufferSize = (short)reader.GetInteger("Config", "MaxClientSendBufferSize", 0);
+		config.IsLoginCheck = reader.GetInteger("Config", "IsLoginCheck", 0);
+		config.ExtraClientCount = reader.GetInteger("Config", "ExtraClientCount", 0);
+		config.MaxLobbyCount = reader.GetInteger("Config", "MaxLobbyCount", 0);
+		config.MaxLobbyUserCount = reader.GetInteger("Config", "MaxLobbyUserCount", 0);
+		config.MaxRoomCountByLobby = reader.GetInteger("Config", "MaxRoomCountByLobby", 0);
+		config.MaxRoomUserCount = reader.GetInteger("Config", "MaxRoomUserCount", 0);
+		config.LobbyChatPerSec = reader.GetInteger("Config", "LobbyChatPerSec", 0);
+		config.LobbyChatBurstCount = reader.GetInteger("Config", "LobbyChatBurstCount", 0);
+		config.SendFlushMode = (NServerNetLib::SEND_FLUSH_MODE)reader.GetInteger("Config", "SendFlushMode", 0);
+		config.LogicShardCount = reader.GetInteger("Config", "LogicShardCount", 0);
+		config.TaskWorkerCount = reader.GetInteger("Config", "TaskWorkerCount", 0);
+		config.RoomTickPerSec = reader.GetInteger("Config", "RoomTickPerSec", 20);
+		config.MaxRoomUpdatePerTick = reader.GetInteger("Config", "MaxRoomUpdatePerTick", 0);
+		config.CompressMinBodySize = reader.GetInteger("Config", "CompressMinBodySize", 0);
+
+		auto adminSocketPath = reader.GetString("Config", "AdminSocketPath", "");
+		snprintf(config.AdminSocketPath, MAX_PATH, "%s", adminSocketPath.c_str());
+
+		auto captureFilePath = reader.GetString("Config", "CaptureFilePath", "");
+		snprintf(config.CaptureFilePath, MAX_PATH, "%s", captureFilePath.c_str());
+		return true;
+	}
+
+	LobbyManagerConfig Main::MakeLobbyManagerConfig(const NServerNetLib::ServerConfig& config)
+	{
+		return { config.MaxLobbyCount,
+				config.MaxLobbyUserCount,
+				config.MaxRoomCountByLobby,
+				config.MaxRoomUserCount,
+				config.LobbyChatPerSec,
+				config.LobbyChatBurstCount,
+				config.RoomTickPerSec,
+				config.MaxRoomUpdatePerTick };
+	}
 		
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
-#ifndef __LOGIC_MAIN__
+﻿#ifndef __LOGIC_MAIN__
 #define __LOGIC_MAIN__
 
 #include <memory>
+#include <chrono>
+#include <atomic>
 
 #include "../Common/Packet.h"
 #include "../Common/ErrorCode.h"
@@ -13,13 +15,19 @@ namespace NServerNetLib
 	struct ServerConfig;
 	class ILog;
 	class ITcpNetwork;
+	struct NetStats;
 }
 
 namespace NLogicLib
 {
 	class UserManager;
 	class LobbyManager;
+	struct LobbyManagerConfig;
 	class PacketProcess;
+	class LogicShardPool;
+	class TaskScheduler;
+	class ServerMetrics;
+	class AdminServer;
 
 	class Main
 	{
@@ -28,15 +36,24 @@ namespace NLogicLib
 		~Main();
 
 		ERROR_CODE Initialize();
+		ERROR_CODE Initialize(const NServerNetLib::ServerConfig& config, std::unique_ptr<NServerNetLib::ILog> pLogger);
 		void Run();
 		void Stop();
 
+		NServerNetLib::NetStats* GetNetStats();
+
+		// 설정 파일을 읽는다. PacketReplay 도 서버와 같은 설정으로 로직을 만들도록 같이 쓴다.
+		static bool ReadConfig(const char* pszFilePath, NServerNetLib::ServerConfig& config);
+		static LobbyManagerConfig MakeLobbyManagerConfig(const NServerNetLib::ServerConfig& config);
+
 	private:
 		ERROR_CODE LoadConfig();
+		ERROR_CODE CreateModules();
 		void Release();
+		void PublishMetrics();
 
 	private:
-		bool m_IsRun = false;
+		std::atomic<bool> m_IsRun{ false }; // Stop 은 다른 스레드에서 부를 수 있다
 
 		std::unique_ptr<NServerNetLib::ServerConfig> m_pServerConfig;
 		std::unique_ptr<NServerNetLib::ILog> m_pLogger;
@@ -44,6 +61,12 @@ namespace NLogicLib
 		std::unique_ptr<PacketProcess> m_pPacketProc;
 		std::unique_ptr<UserManager> m_pUserMgr;
 		std::unique_ptr<LobbyManager> m_pLobbyMgr;
+		std::unique_ptr<LogicShardPool> m_pLogicShardPool;
+		std::unique_ptr<TaskScheduler> m_pTaskScheduler;
+
+		std::unique_ptr<ServerMetrics> m_pMetrics;
+		std::unique_ptr<AdminServer> m_pAdminServer;
+		std::chrono::steady_clock::time_point m_LatestPublishTime;
 	};
 }
 
@@ -1,3 +1,5 @@
+﻿#include <chrono>
+
 #include "../ServerNetLib/ILog.h"
 #include "../ServerNetLib/TcpNetwork.h"
 #include "ConnectedUserManager.h"
@@ -6,6 +8,7 @@
 #include "Room.h"
 #include "Lobby.h"
 #include "LobbyManager.h"
+#include "ServerMetrics.h"
 #include "PacketProcess.h"
 
 using LOG_TYPE = NServerNetLib::LOG_TYPE;
@@ -26,6 +29,21 @@ namespace NLogicLib
 		m_pConnectedUserManager = std::make_unique<ConnectedUserManager>();
 		m_pConnectedUserManager->Init(pNetwork->ClientSessionPoolSize(), pNetwork, pConfig, pLogger);
 
+		BindPacketFunction();
+	}
+
+	void PacketProcess::InitShard(TcpNet* pNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+		m_pRefNetwork = pNetwork;
+		m_pRefUserMgr = pUserMgr;
+		m_pRefLobbyMgr = pLobbyMgr;
+
+		BindPacketFunction();
+	}
+
+	void PacketProcess::BindPacketFunction()
+	{
 		using netLib = NServerNetLib::PACKET_ID;
 		using common = NCommon::PACKET_ID;
 		
@@ -36,6 +54,10 @@ namespace NLogicLib
 
 		#define PACKET_FUNCTION_BIND(funcName) std::bind(&PacketProcess::funcName, this, std::placeholders::_1)
 
+		// 코루틴 핸들러는 첫 co_await 까지만 여기서 실행하고 나머지는 로비의 타이머나 다른 유저의 요청이 이어서 실행한다.
+		// 에러 응답은 핸들러가 직접 보낸다.
+		#define PACKET_COROUTINE_BIND(funcName) [this](PacketInfo packetInfo) { funcName(packetInfo); return ERROR_CODE::NONE; }
+
 		PacketFuncArray[(int)netLib::NTF_SYS_CONNECT_SESSION] = PACKET_FUNCTION_BIND(NtfSysConnctSession);
 		PacketFuncArray[(int)netLib::NTF_SYS_CLOSE_SESSION] = PACKET_FUNCTION_BIND(NtfSysCloseSession);
 		
@@ -43,30 +65,110 @@ namespace NLogicLib
 		PacketFuncArray[(int)common::LOBBY_LIST_REQ] = PACKET_FUNCTION_BIND(LobbyList);
 		PacketFuncArray[(int)common::LOBBY_ENTER_REQ] = PACKET_FUNCTION_BIND(LobbyEnter);
 		PacketFuncArray[(int)common::LOBBY_LEAVE_REQ] = PACKET_FUNCTION_BIND(LobbyLeave);
+		PacketFuncArray[(int)common::ROOM_LIST_REQ] = PACKET_FUNCTION_BIND(RoomList);
+		PacketFuncArray[(int)common::LOBBY_CHAT_REQ] = PACKET_FUNCTION_BIND(LobbyChat);
 
 		PacketFuncArray[(int)common::ROOM_ENTER_REQ] = PACKET_FUNCTION_BIND(RoomEnter);
 		PacketFuncArray[(int)common::ROOM_LEAVE_REQ] = PACKET_FUNCTION_BIND(RoomLeave);
 		PacketFuncArray[(int)common::ROOM_CHAT_REQ] = PACKET_FUNCTION_BIND(RoomChat);
-		PacketFuncArray[(int)common::ROOM_MASTER_GAME_START_REQ] = PACKET_FUNCTION_BIND(RoomMasterGameStart);
+		PacketFuncArray[(int)common::ROOM_MASTER_GAME_START_REQ] = PACKET_COROUTINE_BIND(RoomMasterGameStart);
 		PacketFuncArray[(int)common::ROOM_GAME_START_REQ] = PACKET_FUNCTION_BIND(RoomGameStart);
+		PacketFuncArray[(int)common::ROOM_GAME_SELECT_REQ] = PACKET_FUNCTION_BIND(RoomGameSelect);
+		PacketFuncArray[(int)common::ROOM_QUICK_MATCH_REQ] = PACKET_FUNCTION_BIND(RoomQuickMatch);
 
 		PacketFuncArray[(int)common::DEV_ECHO_REQ] = PACKET_FUNCTION_BIND(PacketProcess::DevEcho);
+
+		// 로그인, 로비 목록, 로비 입장/퇴장은 여러 로비에 걸치므로 넣지 않는다.
+		IsLobbyPacketArray[(int)common::LOBBY_CHAT_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_LIST_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_ENTER_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_LEAVE_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_CHAT_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_MASTER_GAME_START_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_GAME_START_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_GAME_SELECT_REQ] = true;
+		IsLobbyPacketArray[(int)common::ROOM_QUICK_MATCH_REQ] = true;
+	}
+
+	bool PacketProcess::IsLobbyPacket(const short packetId)
+	{
+		if (packetId < 0 || packetId >= (short)NCommon::PACKET_ID::MAX) {
+			return false;
+		}
+		return IsLobbyPacketArray[packetId];
 	}
 	
 	void PacketProcess::Process(PacketInfo packetInfo)
 	{
 		auto packetId = packetInfo.PacketId;
+		if (packetId < 0 || packetId >= (short)NCommon::PACKET_ID::MAX)
+		{
+			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Invalid packet id(%d).", __FUNCTION__, packetId);
+			return;
+		}
+
 		if (PacketFuncArray[packetId] == nullptr)
 		{
 			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Connected packet function is null.", __FUNCTION__, packetInfo.PacketId);
 			return;
 		}
 
+		// 핸들러는 Body 가 Packet.idl 정의에 맞는다고 보고 View 로 읽는다. 맞지 않으면 응답 패킷에 에러만 담아 보낸다.
+		if (NCommon::IsValidPacketBody(packetId, packetInfo.pRefData, packetInfo.PacketBodySize) == false)
+		{
+			m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Invalid packet body. PacketId(%d), BodySize(%d)", __FUNCTION__, packetId, packetInfo.PacketBodySize);
+
+			auto resPacketId = NCommon::GetPacketResponseId(packetId);
+			if (resPacketId != 0)
+			{
+				NCommon::PktBase resPkt;
+				resPkt.SetError(ERROR_CODE::PACKET_INVALID_BODY_SIZE);
+				m_pRefNetwork->SendData(packetInfo.SessionIndex, resPacketId, sizeof(resPkt), (char*)&resPkt);
+			}
+			return;
+		}
+
 		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | Process Packet : %d ", __FUNCTION__, packetInfo.PacketId);
+
+		if (m_pRefMetrics == nullptr)
+		{
+			PacketFuncArray[packetId](packetInfo);
+			return;
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
 		PacketFuncArray[packetId](packetInfo);
+		auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+		m_pRefMetrics->RecordPacket(packetId, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+	void PacketProcess::SetScheduler(TaskScheduler* pScheduler)
+	{
+		m_pConnectedUserManager->SetScheduler(pScheduler);
+	}
+
+	void PacketProcess::StateCheck(const int64_t curMilliSec)
+	{
+		LoginCheck();
+
+		// 시간이 된 룸 타이머를 부르고, 기다리던 코루틴을 이어서 실행한다.
+		m_pRefLobbyMgr->UpdateTimer(curMilliSec);
+
+		// 게임 중인 룸만 정해진 간격으로 Update 한다.
+		m_pRefLobbyMgr->UpdateRoomTick(curMilliSec);
+
+		// 이번 루프에서 쌓인 빠른 입장 요청을 한꺼번에 배정한다.
+		m_pRefLobbyMgr->ProcessQuickMatch();
+
+		// 이번 루프에서 바뀐 룸 정보를 로비별로 한 번에 알린다.
+		m_pRefLobbyMgr->SendRoomChangedInfo();
+
+		// 로비 채팅도 이번 루프에서 모은 것을 로비별로 한 번에 보낸다.
+		m_pRefLobbyMgr->SendLobbyChat();
 	}
 
-	void PacketProcess::StateCheck()
+	void PacketProcess::LoginCheck()
 	{
 		m_pConnectedUserManager->LoginCheck();
 	}
@@ -106,15 +208,20 @@ namespace NLogicLib
 
 	ERROR_CODE PacketProcess::DevEcho(PacketInfo packetInfo)
 	{		
-		auto reqPkt = (NCommon::PktDevEchoReq*)packetInfo.pRefData;
+		// DataSize 는 Process 에서 받은 Body 안에 있는지 검사했다.
+		NCommon::PktDevEchoReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
 		
-		NCommon::PktDevEchoRes resPkt;
-		resPkt.ErrorCode = (short)ERROR_CODE::NONE;
-		resPkt.DataSize = reqPkt->DataSize;
-		CopyMemory(resPkt.Datas, reqPkt->Datas, reqPkt->DataSize);
-		
-		auto sendSize = sizeof(NCommon::PktDevEchoRes) - (NCommon::DEV_ECHO_DATA_MAX_SIZE - reqPkt->DataSize);
-		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)NCommon::PACKET_ID::DEV_ECHO_RES, (short)sendSize, (char*)&resPkt);
+		// 받은 데이터를 송신 버퍼에 바로 쓴다.
+		using Writer = NCommon::PktDevEchoResWriter;
+		auto maxSize = Writer::Layout::MinSize + reqPkt.DataSize();
+		auto pBody = m_pRefNetwork->ReserveSend(packetInfo.SessionIndex, (short)NCommon::PACKET_ID::DEV_ECHO_RES, (short)maxSize);
+		if (pBody == nullptr) {
+			return ERROR_CODE::NONE;
+		}
+
+		auto sendSize = Writer::Encode(pBody, maxSize, (short)ERROR_CODE::NONE, reqPkt.DataSize(), reqPkt.Datas());
+		m_pRefNetwork->CommitSend(packetInfo.SessionIndex, (short)sendSize);
 
 		return ERROR_CODE::NONE;
 	}
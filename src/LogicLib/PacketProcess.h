@@ -1,12 +1,13 @@
-#pragma once
+﻿#pragma once
 
 #include <memory>
 #include <map>
 #include <functional>
 
-#include "../Common/Packet.h"
+#include "../Common/PacketSchema.h"
 #include "../Common/ErrorCode.h"
 #include "../ServerNetLib/Define.h"
+#include "Coroutine.h"
 
 using ERROR_CODE = NCommon::ERROR_CODE;
 
@@ -21,6 +22,8 @@ namespace NLogicLib
 	class ConnectedUserManager;
 	class UserManager;
 	class LobbyManager;
+	class ServerMetrics;
+	class TaskScheduler;
 
 	using ServerConfig = NServerNetLib::ServerConfig;
 
@@ -32,6 +35,7 @@ namespace NLogicLib
 		using PacketInfo = NServerNetLib::RecvPacketInfo;		
 		using PacketFunc = std::function<ERROR_CODE(PacketInfo)>;
 		PacketFunc PacketFuncArray[(int)NCommon::PACKET_ID::MAX];
+		bool IsLobbyPacketArray[(int)NCommon::PACKET_ID::MAX] = { false, };
 
 		using TcpNet = NServerNetLib::ITcpNetwork;
 		using ILog = NServerNetLib::ILog;
@@ -41,8 +45,22 @@ namespace NLogicLib
 		~PacketProcess();
 
 		void Init(TcpNet* pNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, ServerConfig* pConfig, ILog* pLogger);
+
+		// 로직 샤드용. 로비 안에서 끝나는 패킷만 처리하므로 접속 관리는 하지 않는다.
+		void InitShard(TcpNet* pNetwork, UserManager* pUserMgr, LobbyManager* pLobbyMgr, ILog* pLogger);
+
+		void SetMetrics(ServerMetrics* pMetrics) { m_pRefMetrics = pMetrics; }
+
+		// 로그인 검사 같은 주기 검사를 작업 스레드에 나눠 맡긴다. 없으면 로직 스레드에서 한다.
+		void SetScheduler(TaskScheduler* pScheduler);
+
 		void Process(PacketInfo packetInfo);
-		void StateCheck();
+		// curMilliSec 은 이번 루프의 steady_clock 밀리초. 리플레이와 벤치는 기록된 시간이나 원하는 시간을 넘긴다.
+		void StateCheck(const int64_t curMilliSec);
+		void LoginCheck();
+
+		// 유저가 들어가 있는 로비와 그 룸만 건드리는 패킷인가. 로직 샤드는 이 패킷을 그 로비를 맡은 스레드에서 처리한다.
+		bool IsLobbyPacket(const short packetId);
 	
 	private:
 		ILog* m_pRefLogger;
@@ -50,10 +68,13 @@ namespace NLogicLib
 				
 		UserManager* m_pRefUserMgr;
 		LobbyManager* m_pRefLobbyMgr;
+		ServerMetrics* m_pRefMetrics = nullptr;
 
 		std::unique_ptr<ConnectedUserManager> m_pConnectedUserManager;
 						
 	private:
+		void BindPacketFunction();
+
 		ERROR_CODE NtfSysConnctSession(PacketInfo packetInfo);
 		ERROR_CODE NtfSysCloseSession(PacketInfo packetInfo);
 		
@@ -61,12 +82,16 @@ namespace NLogicLib
 		ERROR_CODE LobbyList(PacketInfo packetInfo);
 		ERROR_CODE LobbyEnter(PacketInfo packetInfo);
 		ERROR_CODE LobbyLeave(PacketInfo packetInfo);
+		ERROR_CODE LobbyChat(PacketInfo packetInfo);
+		ERROR_CODE RoomList(PacketInfo packetInfo);
 
 		ERROR_CODE RoomEnter(PacketInfo packetInfo);
 		ERROR_CODE RoomLeave(PacketInfo packetInfo);
 		ERROR_CODE RoomChat(PacketInfo packetInfo);
-		ERROR_CODE RoomMasterGameStart(PacketInfo packetInfo);
+		CoTask RoomMasterGameStart(PacketInfo packetInfo);
 		ERROR_CODE RoomGameStart(PacketInfo packetInfo);
+		ERROR_CODE RoomGameSelect(PacketInfo packetInfo);
+		ERROR_CODE RoomQuickMatch(PacketInfo packetInfo);
 
 		ERROR_CODE DevEcho(PacketInfo packetInfo);
 
@@ -74,9 +99,16 @@ namespace NLogicLib
 		template <class PacketRes>
 		ERROR_CODE SetErrorPacket(ERROR_CODE result, PacketInfo& packetInfo, NCommon::PACKET_ID packet_id)
 		{
-			PacketRes resPkt;
-			resPkt.SetError(result);
-			m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)packet_id, sizeof(PacketRes), (char*)&resPkt);
+			// 에러 응답은 고정 부분만 0 으로 채워 송신 버퍼에 바로 쓴다.
+			using Layout = typename NCommon::PacketLayoutOf<PacketRes>::Type;
+			auto pBody = m_pRefNetwork->ReserveSend(packetInfo.SessionIndex, (short)packet_id, Layout::MinSize);
+			if (pBody == nullptr) {
+				return result;
+			}
+
+			memset(pBody, 0, Layout::MinSize);
+			NCommon::WritePacketField(pBody + Layout::ErrorCode_Offset, (short)result);
+			m_pRefNetwork->CommitSend(packetInfo.SessionIndex, Layout::MinSize);
 			return result;
 		}
 	};
@@ -15,7 +15,8 @@ namespace NLogicLib
 {
 	ERROR_CODE PacketProcess::LobbyEnter(PacketInfo packetInfo)
 	{
-		auto reqPkt = (NCommon::PktLobbyEnterReq*)packetInfo.pRefData;
+		PktLobbyEnterReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
 
 		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
 		
@@ -32,7 +33,7 @@ namespace NLogicLib
 		}
 
 		//κ ε üũ
-		auto pLobby = m_pRefLobbyMgr->GetLobby(reqPkt->LobbyId);
+		auto pLobby = m_pRefLobbyMgr->GetLobby(reqPkt.LobbyId());
 		if (pLobby == nullptr) {
 			return SetErrorPacket<PktLobbyEnterRes>(ERROR_CODE::LOBBY_ENTER_INVALID_LOBBY_INDEX, packetInfo, PACKET_ID::LOBBY_ENTER_RES);
 		}
@@ -78,4 +79,64 @@ namespace NLogicLib
 		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_LEAVE_RES, sizeof(NCommon::PktLobbyLeaveRes), (char*)&resPkt);
 		return ERROR_CODE::NONE;
 	}	
+
+	ERROR_CODE PacketProcess::LobbyChat(PacketInfo packetInfo)
+	{
+		PktLobbyChatReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
+
+		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		auto errorCode = std::get<0>(pUserRet);
+
+		if (errorCode != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktLobbyChatRes>(errorCode, packetInfo, PACKET_ID::LOBBY_CHAT_RES);
+		}
+
+		auto pUser = std::get<1>(pUserRet);
+		if (pUser->IsCurDomainInLobby() == false) {
+			return SetErrorPacket<PktLobbyChatRes>(ERROR_CODE::LOBBY_CHAT_INVALID_DOMAIN, packetInfo, PACKET_ID::LOBBY_CHAT_RES);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return SetErrorPacket<PktLobbyChatRes>(ERROR_CODE::LOBBY_CHAT_INVALID_LOBBY_INDEX, packetInfo, PACKET_ID::LOBBY_CHAT_RES);
+		}
+
+		auto msgLength = TrimUtf8Length(reqPkt.Msg(), reqPkt.MsgLength());
+		auto chatRet = pLobby->Chat(pUser, reqPkt.Msg(), msgLength);
+		if (chatRet != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktLobbyChatRes>(chatRet, packetInfo, PACKET_ID::LOBBY_CHAT_RES);
+		}
+
+		NCommon::PktLobbyChatRes resPkt;
+		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOBBY_CHAT_RES, sizeof(resPkt), (char*)&resPkt);
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::RoomList(PacketInfo packetInfo)
+	{
+		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		auto errorCode = std::get<0>(pUserRet);
+
+		if (errorCode != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomListRes>(errorCode, packetInfo, PACKET_ID::ROOM_LIST_RES);
+		}
+
+		auto pUser = std::get<1>(pUserRet);
+		if (pUser->IsCurDomainInLobby() == false) {
+			return SetErrorPacket<PktRoomListRes>(ERROR_CODE::ROOM_LIST_INVALID_DOMAIN, packetInfo, PACKET_ID::ROOM_LIST_RES);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return SetErrorPacket<PktRoomListRes>(ERROR_CODE::ROOM_LIST_INVALID_LOBBY_INDEX, packetInfo, PACKET_ID::ROOM_LIST_RES);
+		}
+
+		// Body  ڶ  ʵ尡 0 ̹Ƿ ó   ش.
+		PktRoomListReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
+
+		pLobby->SendRoomList(packetInfo.SessionIndex, reqPkt.StartRoomIndex(), reqPkt.IsOnlyHasSeat(), reqPkt.IsOnlyWaiting());
+		return ERROR_CODE::NONE;
+	}
 }
\ No newline at end of file
@@ -13,21 +13,30 @@ namespace NLogicLib
 {
 	ERROR_CODE PacketProcess::Login(PacketInfo packetInfo)
 	{
-		//TODO:  Ͱ PktLogInReq ũ⸸ŭ ؾ Ѵ.
-		// н  pass ش.
-		
-		auto reqPkt = (NCommon::PktLogInReq*)packetInfo.pRefData;
+		// Body ũ Process  ˻ߴ. н  pass ش.
+		PktLogInReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
 
 		// ID ߺ̰ų ִ  Ѿٸ  ó.
-		auto addRet = m_pRefUserMgr->AddUser(packetInfo.SessionIndex, reqPkt->szID);
+		auto addRet = m_pRefUserMgr->AddUser(packetInfo.SessionIndex, reqPkt.szID());
 		if (addRet != ERROR_CODE::NONE) {
 			return SetErrorPacket<PktLogInRes>(addRet, packetInfo, PACKET_ID::LOGIN_IN_RES);
 		}
 
 		m_pConnectedUserManager->SetLogin(packetInfo.SessionIndex);
 
+		// Ŭ̾Ʈ   ִٰ      ͸ ش.   ȴ.
+		unsigned char flags = 0;
+		if ((reqPkt.Flags() & LOGIN_FLAG_COMPRESS) && m_pRefNetwork->EnableCompress(packetInfo.SessionIndex)) {
+			flags |= LOGIN_FLAG_COMPRESS;
+		}
+		if ((reqPkt.Flags() & LOGIN_FLAG_SEQUENCE) && m_pRefNetwork->EnableSequence(packetInfo.SessionIndex)) {
+			flags |= LOGIN_FLAG_SEQUENCE;
+		}
+
 		PktLogInRes resPkt;
 		resPkt.ErrorCode = (short)addRet;
+		resPkt.Flags = flags;
 		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::LOGIN_IN_RES, sizeof(NCommon::PktLogInRes), (char*)&resPkt);
 		return ERROR_CODE::NONE;
 	}
@@ -48,7 +57,16 @@ namespace NLogicLib
 			return SetErrorPacket<PktLobbyListRes>(ERROR_CODE::LOBBY_LIST_INVALID_DOMAIN, packetInfo, PACKET_ID::LOBBY_LIST_RES);
 		}
 		
-		m_pRefLobbyMgr->SendLobbyListInfo(packetInfo.SessionIndex);
+		//  Ŭ̾Ʈ Body   Version      д´.
+		PktLobbyListReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
+		if (reqPkt.IsEmpty())
+		{
+			m_pRefLobbyMgr->SendLegacyLobbyListInfo(packetInfo.SessionIndex);
+			return ERROR_CODE::NONE;
+		}
+
+		m_pRefLobbyMgr->SendLobbyListInfo(packetInfo.SessionIndex, reqPkt.Version());
 		return ERROR_CODE::NONE;
 	}
 }
\ No newline at end of file
@@ -13,9 +13,16 @@ using namespace NCommon;
 
 namespace NLogicLib
 {
+	//    û  ٸ   û ٸ ð
+	const int GAME_START_WAIT_MILLISEC = 10000;
+
+	//   忡   ִ ð
+	const int GAME_SELECT_WAIT_MILLISEC = 10000;
+
 	ERROR_CODE PacketProcess::RoomEnter(PacketInfo packetInfo)
 	{
-		auto reqPkt = (NCommon::PktRoomEnterReq*)packetInfo.pRefData;
+		PktRoomEnterReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
 
 		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
 		auto errorCode = std::get<0>(pUserRet);
@@ -37,7 +44,7 @@ namespace NLogicLib
 		Room* pRoom = nullptr;
 		
 		//     
-		if (reqPkt->IsCreate)
+		if (reqPkt.IsCreate())
 		{
 			pRoom = pLobby->GetAvailableRoom();
 			if (pRoom == nullptr) {
@@ -45,15 +52,23 @@ namespace NLogicLib
 			}
 			else
 			{
-				auto ret = pRoom->CreateRoom(reqPkt->RoomTitle);
+				auto ret = pRoom->CreateRoom(reqPkt.RoomTitle(), reqPkt.RoomTitleLength());
 				if (ret != ERROR_CODE::NONE) {
 					return SetErrorPacket<PktRoomEnterRes>(ret, packetInfo, PACKET_ID::ROOM_ENTER_RES);
 				}
 			}
 		}
+		//  ȣ   ڸ ְ    뿡 ٷ ־ ش
+		else if (reqPkt.RoomIndex() < 0)
+		{
+			pRoom = pLobby->GetJoinableRoom();
+			if (pRoom == nullptr) {
+				return SetErrorPacket<PktRoomEnterRes>(ERROR_CODE::ROOM_ENTER_NO_JOINABLE_ROOM, packetInfo, PACKET_ID::ROOM_ENTER_RES);
+			}
+		}
 		else
 		{
-		    pRoom = pLobby->GetRoom(reqPkt->RoomIndex);
+		    pRoom = pLobby->GetRoom(reqPkt.RoomIndex());
 			if (pRoom == nullptr) {
 				return SetErrorPacket<PktRoomEnterRes>(ERROR_CODE::ROOM_ENTER_INVALID_ROOM_INDEX, packetInfo, PACKET_ID::ROOM_ENTER_RES);
 			}
@@ -64,8 +79,9 @@ namespace NLogicLib
 			return SetErrorPacket<PktRoomEnterRes>(enterRet, packetInfo, PACKET_ID::ROOM_ENTER_RES);
 		}
 		
-		//   뿡 Դٰ Ѵ.
-		pUser->EnterRoom(lobbyIndex, pRoom->GetIndex());		
+		//   뿡 Դٰ Ѵ.    ̾ٸ Ѵ.
+		pUser->EnterRoom(lobbyIndex, pRoom->GetIndex());
+		pLobby->CancelQuickMatch(pUser);		
 		
 		// 뿡   Դٰ ˸
 		pRoom->NotifyEnterUserInfo(pUser->GetIndex(), pUser->GetID().c_str());
@@ -120,7 +136,8 @@ namespace NLogicLib
 
 	ERROR_CODE PacketProcess::RoomChat(PacketInfo packetInfo)
 	{
-		auto reqPkt = (NCommon::PktRoomChatReq*)packetInfo.pRefData;
+		PktRoomChatReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
 
 		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
 		auto errorCode = std::get<0>(pUserRet);
@@ -146,58 +163,69 @@ namespace NLogicLib
 			return SetErrorPacket<PktRoomChatRes>(ERROR_CODE::ROOM_ENTER_INVALID_ROOM_INDEX, packetInfo, PACKET_ID::ROOM_CHAT_RES);
 		}
 
-		pRoom->NotifyChat(pUser->GetSessionIndex(), pUser->GetID().c_str(), reqPkt->Msg);
+		auto msgLength = TrimUtf8Length(reqPkt.Msg(), reqPkt.MsgLength());
+		pRoom->NotifyChat(pUser->GetIndex(), pUser->GetID().c_str(), reqPkt.Msg(), msgLength);
 				
 		NCommon::PktRoomChatRes resPkt;
 		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_CHAT_RES, sizeof(resPkt), (char*)&resPkt);
 		return ERROR_CODE::NONE;
 	}
 
-	//TODO      ߽ϴ.
-	ERROR_CODE PacketProcess::RoomMasterGameStart(PacketInfo packetInfo)
+	/*
+	   û. ٸ   ROOM_GAME_START_REQ    ڷƾ ٸ   ϰ,    带 .
+	ù co_await ڿ packetInfo.pRefData  pUser   ʴ´.  κ  Ƿ ״ .
+	*/
+	CoTask PacketProcess::RoomMasterGameStart(PacketInfo packetInfo)
 	{
 		PACKET_ID packet_id = PACKET_ID::ROOM_MASTER_GAME_START_RES;
 		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
 		auto errorCode = std::get<0>(pUserRet);
 
 		if (errorCode != ERROR_CODE::NONE) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(errorCode, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(errorCode, packetInfo, packet_id);
+			co_return;
 		}
 
 		auto pUser = std::get<1>(pUserRet);
 
 		if (pUser->IsCurDomainInRoom() == false) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_DOMAIN, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_DOMAIN, packetInfo, packet_id);
+			co_return;
 		}
 
 		auto lobbyIndex = pUser->GetLobbyIndex();
 		auto pLobby = m_pRefLobbyMgr->GetLobby(lobbyIndex);
 		if (pLobby == nullptr) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_LOBBY_INDEX, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_LOBBY_INDEX, packetInfo, packet_id);
+			co_return;
 		}
 
 		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
 		if (pRoom == nullptr) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_ROOM_INDEX, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_ROOM_INDEX, packetInfo, packet_id);
+			co_return;
 		}
 
 		//  ´ Ȯ
 		if (pRoom->IsMaster(pUser->GetIndex()) == false) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_MASTER, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_MASTER, packetInfo, packet_id);
+			co_return;
 		}
 
-		//  ο 2ΰ?
-		if (pRoom->GetUserCount() != 2) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_USER_COUNT, packetInfo, packet_id);
+		//  ο 2 ̻ΰ?
+		if (pRoom->GetUserCount() < 2) {
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_USER_COUNT, packetInfo, packet_id);
+			co_return;
 		}
 
 		//  °  ϴ ?
 		if (pRoom->GetGameObj()->GetState() != GameState::NONE) {
-			return SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_GAME_STATE, packetInfo, packet_id);
+			SetErrorPacket<PktRoomMaterGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_GAME_STATE, packetInfo, packet_id);
+			co_return;
 		}
 
-		//    
-		pRoom->GetGameObj()->SetState(GameState::STARTING);
+		//    .   û  .
+		pRoom->StartGameReady(pUser->GetIndex());
 				
 		//  ٸ     û  ˸
 		pRoom->SendToAllUser((short)PACKET_ID::ROOM_MASTER_GAME_START_NTF, 
@@ -208,7 +236,40 @@ namespace NLogicLib
 		// ûڿ 亯 .
 		NCommon::PktRoomMaterGameStartRes resPkt;
 		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_MASTER_GAME_START_RES, sizeof(resPkt), (char*)&resPkt);
-		return ERROR_CODE::NONE;
+
+		// ٸ    ûϸ RoomGameStart  .
+		auto waitResult = co_await pRoom->WaitGameReady(GAME_START_WAIT_MILLISEC);
+
+		//   ҵƴ.  Դ Room  ˷ȴ.
+		if (waitResult == WAIT_RESULT::CANCELED) {
+			co_return;
+		}
+
+		if (waitResult == WAIT_RESULT::TIMEOUT)
+		{
+			pRoom->CancelGameStart(ERROR_CODE::ROOM_GAME_START_TIMEOUT);
+			co_return;
+		}
+
+		//  ¸ ING  ٲ κ ˸   ˸.
+		pRoom->BeginGame();
+
+		//     带 .   RoomGameSelect  , ð     .
+		while (true)
+		{
+			pRoom->StartRound(GAME_SELECT_WAIT_MILLISEC);
+
+			waitResult = co_await pRoom->WaitRoundSelect(GAME_SELECT_WAIT_MILLISEC);
+
+			//  ų  ߴܵƴ.
+			if (waitResult == WAIT_RESULT::CANCELED) {
+				co_return;
+			}
+
+			if (pRoom->ResolveRound()) {
+				co_return;
+			}
+		}
 	}
 
 	ERROR_CODE PacketProcess::RoomGameStart(PacketInfo packetInfo)
@@ -240,26 +301,115 @@ namespace NLogicLib
 			return SetErrorPacket<PktRoomGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_ROOM_INDEX, packetInfo, packet_id);
 		}
 
-		//  °  ϴ ?
+		//   ûؼ ٸ ?
 		if (pRoom->GetGameObj()->GetState() != GameState::STARTING) {
 			return SetErrorPacket<PktRoomGameStartRes>(ERROR_CODE::ROOM_MASTER_GAME_START_INVALID_GAME_STATE, packetInfo, packet_id);
 		}
 
-		//TODO: ̹   û ߴ°?
-
-		//TODO: 濡   û  Ʈ 
+		// 濡   û  Ʈ . ̹ û 
+		auto readyResult = pRoom->SetGameReady(pUser->GetIndex());
+		if (readyResult != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomGameStartRes>(readyResult, packetInfo, packet_id);
+		}
 
 		//  ٸ    û  ˸
+		NCommon::PktRoomGameStartNtf ntfPkt;
+		CopyPacketString(ntfPkt.UserID, sizeof(ntfPkt.UserID), pUser->GetID().c_str());
+		pRoom->SendToAllUser((short)PACKET_ID::ROOM_GAME_START_NTF, sizeof(ntfPkt), (char*)&ntfPkt, pUser->GetIndex());
 
 		// ûڿ 亯 .
 		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_GAME_START_RES, sizeof(resPkt), (char*)&resPkt);
 		
-		
-		//   Ѱ?
-		// ̸    GameState::ING
-		//   Ŷ 
-		//    κ ˸
-		//    ð 
+		//  û RoomMasterGameStart ڷƾ   Ѵ. 亯 ڿ    ˸ 亯 ڿ .
+		if (pRoom->IsAllReady()) {
+			pRoom->SignalGameReady();
+		}
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::RoomGameSelect(PacketInfo packetInfo)
+	{
+		PACKET_ID packet_id = PACKET_ID::ROOM_GAME_SELECT_RES;
+
+		PktRoomGameSelectReqView reqPkt;
+		reqPkt.Parse(packetInfo.pRefData, packetInfo.PacketBodySize);
+
+		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		auto errorCode = std::get<0>(pUserRet);
+
+		if (errorCode != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomGameSelectRes>(errorCode, packetInfo, packet_id);
+		}
+
+		auto pUser = std::get<1>(pUserRet);
+
+		if (pUser->IsCurDomainInRoom() == false) {
+			return SetErrorPacket<PktRoomGameSelectRes>(ERROR_CODE::ROOM_GAME_SELECT_INVALID_DOMAIN, packetInfo, packet_id);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return SetErrorPacket<PktRoomGameSelectRes>(ERROR_CODE::ROOM_GAME_SELECT_INVALID_LOBBY_INDEX, packetInfo, packet_id);
+		}
+
+		auto pRoom = pLobby->GetRoom(pUser->GetRoomIndex());
+		if (pRoom == nullptr) {
+			return SetErrorPacket<PktRoomGameSelectRes>(ERROR_CODE::ROOM_GAME_SELECT_INVALID_ROOM_INDEX, packetInfo, packet_id);
+		}
+
+		if (pRoom->GetGameObj()->GetState() != GameState::ING) {
+			return SetErrorPacket<PktRoomGameSelectRes>(ERROR_CODE::ROOM_GAME_SELECT_INVALID_GAME_STATE, packetInfo, packet_id);
+		}
+
+		// ̹ 忡  ִ      ִ
+		auto selectResult = pRoom->SelectGame(pUser->GetIndex(), reqPkt.Select());
+		if (selectResult != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomGameSelectRes>(selectResult, packetInfo, packet_id);
+		}
+
+		//  ٸ   ˸
+		NCommon::PktRoomGameSelectNtf ntfPkt;
+		CopyPacketString(ntfPkt.UserID, sizeof(ntfPkt.UserID), pUser->GetID().c_str());
+		pRoom->SendToAllUser((short)PACKET_ID::ROOM_GAME_SELECT_NTF, sizeof(ntfPkt), (char*)&ntfPkt, pUser->GetIndex());
+
+		// ûڿ 亯 .
+		NCommon::PktRoomGameSelectRes resPkt;
+		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_GAME_SELECT_RES, sizeof(resPkt), (char*)&resPkt);
+
+		//     ð ٸ ʰ 带 .
+		if (pRoom->GetGameObj()->IsAllSelected()) {
+			pRoom->SignalRoundSelect();
+		}
+		return ERROR_CODE::NONE;
+	}
+
+	ERROR_CODE PacketProcess::RoomQuickMatch(PacketInfo packetInfo)
+	{
+		auto pUserRet = m_pRefUserMgr->GetUser(packetInfo.SessionIndex);
+		auto errorCode = std::get<0>(pUserRet);
+
+		if (errorCode != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomQuickMatchRes>(errorCode, packetInfo, PACKET_ID::ROOM_QUICK_MATCH_RES);
+		}
+
+		auto pUser = std::get<1>(pUserRet);
+		if (pUser->IsCurDomainInLobby() == false) {
+			return SetErrorPacket<PktRoomQuickMatchRes>(ERROR_CODE::ROOM_QUICK_MATCH_INVALID_DOMAIN, packetInfo, PACKET_ID::ROOM_QUICK_MATCH_RES);
+		}
+
+		auto pLobby = m_pRefLobbyMgr->GetLobby(pUser->GetLobbyIndex());
+		if (pLobby == nullptr) {
+			return SetErrorPacket<PktRoomQuickMatchRes>(ERROR_CODE::ROOM_QUICK_MATCH_INVALID_LOBBY_INDEX, packetInfo, PACKET_ID::ROOM_QUICK_MATCH_RES);
+		}
+
+		// ⿭ ֱ⸸ ϰ   StateCheck  Ƽ Ѵ.
+		auto matchRet = pLobby->RequestQuickMatch(pUser);
+		if (matchRet != ERROR_CODE::NONE) {
+			return SetErrorPacket<PktRoomQuickMatchRes>(matchRet, packetInfo, PACKET_ID::ROOM_QUICK_MATCH_RES);
+		}
+
+		NCommon::PktRoomQuickMatchRes resPkt;
+		m_pRefNetwork->SendData(packetInfo.SessionIndex, (short)PACKET_ID::ROOM_QUICK_MATCH_RES, sizeof(resPkt), (char*)&resPkt);
 		return ERROR_CODE::NONE;
 	}
 }
\ No newline at end of file
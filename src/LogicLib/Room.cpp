@@ -1,12 +1,16 @@
 #include <algorithm>
+#include <chrono>
+#include <string.h>
 
 #include "../ServerNetLib/ILog.h"
 #include "../ServerNetLib/TcpNetwork.h"
 #include "../Common/Packet.h"
+#include "../Common/PacketSchema.h"
 #include "../Common/ErrorCode.h"
 
 #include "User.h"
 #include "Game.h"
+#include "Lobby.h"
 #include "Room.h"
 
 using PACKET_ID = NCommon::PACKET_ID;
@@ -22,35 +26,23 @@ void strncpy_s(char *dest, size_t size, const char *source, size_t n)
 		dest[i] = source[i];
 	}
 }
-
-void wcsncpy_s(wchar_t *dest, size_t size, const wchar_t *source, size_t n)
-{
-	size_t i;
-	assert(size >= n);//size n ũų ƾ 
-	for (i = 0; i < n; i++)//i n  ݺ 
-	{
-		dest[i] = source[i];
-	}
-}
 #endif
 
 namespace NLogicLib
 {
 	Room::Room() {}
 
-	Room::~Room()
-	{
-		if (m_pGame != nullptr) {
-			delete m_pGame;
-		}
-	}
+	Room::~Room() {}
 	
-	void Room::Init(const short index, const short maxUserCount)
+	void Room::Init(const short index, const short maxUserCount, Lobby* pLobby)
 	{
 		m_Index = index;
 		m_MaxUserCount = maxUserCount;
+		m_pRefLobby = pLobby;
 
-		m_pGame = new Game;
+		m_UserList.reserve(maxUserCount);
+		m_ReadyUserIndexList.reserve(maxUserCount);
+		m_Game.Init(maxUserCount);
 	}
 
 	void Room::SetNetwork(TcpNet* pNetwork, ILog* pLogger)
@@ -62,20 +54,27 @@ namespace NLogicLib
 	void Room::Clear()
 	{
 		m_IsUsed = false;
-		m_Title = L"";
+		m_TitleLength = 0;
 		m_UserList.clear();
+		m_ReadyUserIndexList.clear();
+		m_Game.Clear();
+
+		//  ̳ 带 ٸ ڷƾ CANCELED  .
+		m_GameEvent.Cancel();
 	}
 	
 
-	ERROR_CODE Room::CreateRoom(const wchar_t* pRoomTitle)
+	ERROR_CODE Room::CreateRoom(const char* pRoomTitle, const short titleLength)
 	{
 		if (m_IsUsed) {
 			return ERROR_CODE::ROOM_ENTER_CREATE_FAIL;
 		}
 
 		m_IsUsed = true;
-		m_Title = pRoomTitle;
+		m_TitleLength = NCommon::TrimUtf8Length(pRoomTitle, titleLength < NCommon::MAX_ROOM_TITLE_SIZE ? titleLength : (short)NCommon::MAX_ROOM_TITLE_SIZE);
+		memcpy(m_Title, pRoomTitle, m_TitleLength);
 
+		NotifyChangedToLobby();
 		return ERROR_CODE::NONE;
 	}
 
@@ -90,6 +89,8 @@ namespace NLogicLib
 		}
 
 		m_UserList.push_back(pUser);
+
+		NotifyChangedToLobby();
 		return ERROR_CODE::NONE;
 	}
 
@@ -110,7 +111,20 @@ namespace NLogicLib
 		{
 			Clear();
 		}
+		else if (m_Game.GetState() == GameState::STARTING)
+		{
+			CancelGameStart(ERROR_CODE::ROOM_GAME_START_CANCELED);
+		}
+		else if (m_Game.GetState() == GameState::ING)
+		{
+			//   ̹ 忡 .     ð ٸ ʰ  .
+			m_Game.LeavePlayer(userIndex);
+			if (m_Game.GetAlivePlayerCount() <= 1 || m_Game.IsAllSelected()) {
+				SignalRoundSelect();
+			}
+		}
 
+		NotifyChangedToLobby();
 		return ERROR_CODE::NONE;
 	}
 
@@ -146,22 +160,50 @@ namespace NLogicLib
 		SendToAllUser((short)PACKET_ID::ROOM_LEAVE_USER_NTF, sizeof(pkt), (char*)&pkt);
 	}
 
-	void Room::NotifyChat(const int sessionIndex, const char* pszUserID, const wchar_t* pszMsg)
+	void Room::NotifyQuickMatch(const int sessionIndex)
+	{
+		using Layout = NCommon::PktRoomQuickMatchNtfLayout;
+		auto pBody = m_pRefNetwork->ReserveSend(sessionIndex, (short)PACKET_ID::ROOM_QUICK_MATCH_NTF, Layout::MaxSize);
+		if (pBody == nullptr) {
+			return;
+		}
+
+		short userCount = 0;
+		for (auto pUser : m_UserList)
+		{
+			if (userCount >= NCommon::MAX_ROOM_USER_COUNT) {
+				break;
+			}
+
+			NCommon::CopyPacketString(pBody + Layout::UserIDList_Offset + userCount * Layout::UserIDList_ElemSize, Layout::UserIDList_ElemSize, pUser->GetID().c_str());
+			++userCount;
+		}
+
+		NCommon::WritePacketField(pBody + Layout::RoomIndex_Offset, (short)m_Index);
+		NCommon::WritePacketField(pBody + Layout::UserCount_Offset, userCount);
+
+		m_pRefNetwork->CommitSend(sessionIndex, (short)(Layout::UserIDList_Offset + userCount * Layout::UserIDList_ElemSize));
+	}
+
+	void Room::NotifyChat(const int userIndex, const char* pszUserID, const char* pMsg, const short msgLength)
 	{
 		NCommon::PktRoomChatNtf pkt;
 		strncpy_s(pkt.UserID, _countof(pkt.UserID), pszUserID, NCommon::MAX_USER_ID_SIZE);
-		wcsncpy_s(pkt.Msg, NCommon::MAX_ROOM_CHAT_MSG_SIZE + 1, pszMsg, NCommon::MAX_ROOM_CHAT_MSG_SIZE);
+		pkt.MsgLength = msgLength;
+		memcpy(pkt.Msg, pMsg, msgLength);
 
-		SendToAllUser((short)PACKET_ID::ROOM_CHAT_NTF, sizeof(pkt), (char*)&pkt, sessionIndex);
+		auto sendSize = sizeof(pkt) - NCommon::MAX_ROOM_CHAT_MSG_SIZE + msgLength;
+		SendToAllUser((short)PACKET_ID::ROOM_CHAT_NTF, (short)sendSize, (char*)&pkt, userIndex);
 	}
 
-	void Room::Update()
+	void Room::Update(const int64_t curMilliSec)
 	{
-		if (m_pGame->GetState() == GameState::ING)
+		if (m_Game.GetState() == GameState::ING)
 		{
-			if (m_pGame->CheckSelectTime())
+			if (m_Game.CheckSelectTime(curMilliSec))
 			{
-				// ϴ   
+				// Ÿ̸Ӱ .  ð  µ ״θ  帧  ̹Ƿ  .
+				AbortGame(ERROR_CODE::ROOM_GAME_ABORTED);
 			}
 		}
 	}
@@ -173,6 +215,150 @@ namespace NLogicLib
 
 	Game* Room::GetGameObj()
 	{
-		return m_pGame;
+		return &m_Game;
+	}
+
+	void Room::SetGameState(const GameState state)
+	{
+		m_Game.SetState(state);
+		NotifyChangedToLobby();
+	}
+
+	void Room::StartGameReady(const short masterUserIndex)
+	{
+		m_ReadyUserIndexList.clear();
+		m_ReadyUserIndexList.push_back(masterUserIndex);
+		SetGameState(GameState::STARTING);
+	}
+
+	ERROR_CODE Room::SetGameReady(const short userIndex)
+	{
+		if (std::find(std::begin(m_ReadyUserIndexList), std::end(m_ReadyUserIndexList), userIndex) != std::end(m_ReadyUserIndexList)) {
+			return ERROR_CODE::ROOM_GAME_START_ALREADY_READY;
+		}
+
+		m_ReadyUserIndexList.push_back(userIndex);
+		return ERROR_CODE::NONE;
+	}
+
+	CoEvent::Awaiter Room::WaitGameReady(const int timeoutMilliSec)
+	{
+		auto pTimer = m_pRefLobby != nullptr ? m_pRefLobby->GetTimerService() : nullptr;
+		return m_GameEvent.Wait(pTimer, timeoutMilliSec);
+	}
+
+	void Room::BeginGame()
+	{
+		m_ReadyUserIndexList.clear();
+
+		m_Game.Clear();
+		for (auto pUser : m_UserList) {
+			m_Game.AddPlayer(pUser->GetIndex());
+		}
+		SetGameState(GameState::ING);
+
+		NCommon::PktRoomGameBeginNtf pkt;
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_BEGIN_NTF, sizeof(pkt), (char*)&pkt);
+	}
+
+	void Room::CancelGameStart(const ERROR_CODE reason)
+	{
+		m_ReadyUserIndexList.clear();
+		SetGameState(GameState::NONE);
+
+		NCommon::PktRoomGameBeginNtf pkt;
+		pkt.SetError(reason);
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_BEGIN_NTF, sizeof(pkt), (char*)&pkt);
+
+		m_GameEvent.Cancel();
+	}
+
+	void Room::StartRound(const int selectMilliSec)
+	{
+		//  ð ô  ƽ  ð ϹǷ  ð κ ð .
+		auto curMilliSec = m_pRefLobby != nullptr ? m_pRefLobby->GetCurMilliSec() : std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		m_Game.StartRound(curMilliSec, selectMilliSec);
+
+		NCommon::PktRoomGameRoundStartNtf pkt;
+		pkt.RoundNo = m_Game.GetRoundNo();
+		pkt.SelectMilliSec = selectMilliSec;
+		pkt.PlayerCount = m_Game.GetAlivePlayerCount();
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_ROUND_START_NTF, sizeof(pkt), (char*)&pkt);
+	}
+
+	ERROR_CODE Room::SelectGame(const short userIndex, const char select)
+	{
+		return m_Game.Select(userIndex, select);
+	}
+
+	void Room::SignalRoundSelect()
+	{
+		// 带 ٸ ڷƾ    ȣ  带 ٷ  ʵ Ѵ.
+		if (m_GameEvent.IsWaiting()) {
+			m_GameEvent.Set();
+		}
+	}
+
+	CoEvent::Awaiter Room::WaitRoundSelect(const int timeoutMilliSec)
+	{
+		auto pTimer = m_pRefLobby != nullptr ? m_pRefLobby->GetTimerService() : nullptr;
+		return m_GameEvent.Wait(pTimer, timeoutMilliSec);
+	}
+
+	bool Room::ResolveRound()
+	{
+		auto isGameEnd = m_Game.ResolveRound();
+
+		//   뿡  ִ  ƴ϶    ̴.   ID   д.
+		NCommon::PktRoomGameResultNtf pkt;
+		pkt.RoundNo = m_Game.GetRoundNo();
+		pkt.IsGameEnd = isGameEnd;
+
+		auto playerCount = m_Game.GetPlayerCount();
+		for (short i = 0; i < playerCount && i < NCommon::MAX_ROOM_USER_COUNT; ++i)
+		{
+			auto& player = m_Game.GetPlayer(i);
+			auto& info = pkt.PlayerList[pkt.PlayerCount++];
+
+			auto iter = std::find_if(std::begin(m_UserList), std::end(m_UserList), [&player](auto pUser) { return pUser->GetIndex() == player.UserIndex; });
+			if (iter != std::end(m_UserList)) {
+				NCommon::CopyPacketString(info.UserID, sizeof(info.UserID), (*iter)->GetID().c_str());
+			}
+			info.Select = (char)player.Select;
+			info.Result = (char)player.Result;
+		}
+
+		auto sendSize = sizeof(pkt) - sizeof(NCommon::GameResultInfo) * (NCommon::MAX_ROOM_USER_COUNT - pkt.PlayerCount);
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_RESULT_NTF, (short)sendSize, (char*)&pkt);
+
+		if (isGameEnd)
+		{
+			m_Game.Clear();
+			SetGameState(GameState::NONE);
+		}
+		return isGameEnd;
+	}
+
+	void Room::AbortGame(const ERROR_CODE reason)
+	{
+		NCommon::PktRoomGameResultNtf pkt;
+		pkt.SetError(reason);
+		pkt.RoundNo = m_Game.GetRoundNo();
+		pkt.IsGameEnd = true;
+
+		auto sendSize = sizeof(pkt) - sizeof(NCommon::GameResultInfo) * NCommon::MAX_ROOM_USER_COUNT;
+		SendToAllUser((short)PACKET_ID::ROOM_GAME_RESULT_NTF, (short)sendSize, (char*)&pkt);
+
+		m_Game.Clear();
+		SetGameState(GameState::NONE);
+
+		m_GameEvent.Cancel();
+	}
+
+	void Room::NotifyChangedToLobby()
+	{
+		if (m_pRefLobby != nullptr) {
+			m_pRefLobby->OnRoomChanged(this);
+		}
 	}
 }
\ No newline at end of file
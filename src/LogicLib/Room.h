@@ -1,10 +1,13 @@
-#pragma once
+﻿#pragma once
 
 #include <vector>
 #include <string>
 #include <memory>
 
+#include "../Common/Packet.h"
 #include "User.h"
+#include "Game.h"
+#include "Coroutine.h"
 
 
 namespace NServerNetLib { class ITcpNetwork; }
@@ -18,7 +21,7 @@ namespace NLogicLib
 	using TcpNet = NServerNetLib::ITcpNetwork;
 	using ILog = NServerNetLib::ILog;
 
-	class Game;
+	class Lobby;
 
 	class Room
 	{
@@ -26,41 +29,78 @@ namespace NLogicLib
 		Room();
 		virtual ~Room();
 
-		void Init(const short index, const short maxUserCount);
+		void Init(const short index, const short maxUserCount, Lobby* pLobby = nullptr);
 		void SetNetwork(TcpNet* pNetwork, ILog* pLogger);
 		void Clear();
 		
-		ERROR_CODE CreateRoom(const wchar_t* pRoomTitle);
+		ERROR_CODE CreateRoom(const char* pRoomTitle, const short titleLength);
 		ERROR_CODE EnterUser(User* pUser);
 		ERROR_CODE LeaveUser(const short userIndex);
 
-		void Update();
+		// 게임 중일 때만 룸 틱(RoomTickScheduler)이 부른다. curMilliSec 은 이번 틱의 steady_clock 밀리초.
+		void Update(const int64_t curMilliSec);
 
 		void SendToAllUser(const short packetId, const short dataSize, char* pData, const int passUserindex = -1);
 		void NotifyEnterUserInfo(const int userIndex, const char* pszUserID);
 		void NotifyLeaveUserInfo(const char* pszUserID);
-		void NotifyChat(const int sessionIndex, const char* pszUserID, const wchar_t* pszMsg);
+		void NotifyQuickMatch(const int sessionIndex);
+		void NotifyChat(const int userIndex, const char* pszUserID, const char* pMsg, const short msgLength);
 
 		bool IsMaster(const short userIndex);
 		Game* GetGameObj();
+		void SetGameState(const GameState state);
+
+		// 게임 시작 준비. 방장이 요청하면 STARTING 이 되고, 다른 유저가 모두 ROOM_GAME_START_REQ 를 보내면 WaitGameReady 가 끝난다.
+		void StartGameReady(const short masterUserIndex);
+		ERROR_CODE SetGameReady(const short userIndex);
+		bool IsAllReady() { return m_ReadyUserIndexList.size() == m_UserList.size(); }
+		void SignalGameReady() { m_GameEvent.Set(); }
+		CoEvent::Awaiter WaitGameReady(const int timeoutMilliSec);
+		void BeginGame();
+		void CancelGameStart(const ERROR_CODE reason);
+
+		// 게임 라운드. StartRound 뒤 남은 유저가 모두 고르면 SignalRoundSelect 가, 시간이 지나면 타이머가 WaitRoundSelect 를 끝낸다.
+		void StartRound(const int selectMilliSec);
+		ERROR_CODE SelectGame(const short userIndex, const char select);
+		void SignalRoundSelect();
+		CoEvent::Awaiter WaitRoundSelect(const int timeoutMilliSec);
+
+		// 라운드 결과를 알린다. 게임이 끝났으면 대기 상태로 돌리고 true.
+		bool ResolveRound();
+		void AbortGame(const ERROR_CODE reason);
 
 		short GetIndex() { return m_Index; }
 		bool IsUsed() { return m_IsUsed; }
-		const wchar_t* GetTitle() { return m_Title.c_str(); }
+		const char* GetTitle() { return m_Title; }
+		short GetTitleLength() { return m_TitleLength; }
 		short MaxUserCount() { return m_MaxUserCount; }
 		short GetUserCount() { return (short)m_UserList.size(); }
 
+	private:
+		friend class RoomTickScheduler;
+
+		void NotifyChangedToLobby();
+
 	private:
 		ILog* m_pRefLogger;
 		TcpNet* m_pRefNetwork;
+		Lobby* m_pRefLobby = nullptr;
 
 		short m_Index = -1;
 		short m_MaxUserCount;
 		
 		bool m_IsUsed = false;
-		std::wstring m_Title;
+		char m_Title[NCommon::MAX_ROOM_TITLE_SIZE] = { 0, }; //UTF-8. 널 문자로 끝나지 않는다
+		short m_TitleLength = 0;
 		std::vector<User*> m_UserList;
+		std::vector<short> m_ReadyUserIndexList; //게임 시작을 요청한 유저 인덱스
+
+		Game m_Game;
+		CoEvent m_GameEvent; //게임 흐름 코루틴이 시작 준비와 라운드 선택을 기다린다
 
-		Game* m_pGame = nullptr;
+		// 게임 중인 룸끼리 잇는 목록. 로비의 RoomTickScheduler 가 관리한다.
+		Room* m_pPrevTickRoom = nullptr;
+		Room* m_pNextTickRoom = nullptr;
+		bool m_IsTickActive = false;
 	};
 }
\ No newline at end of file
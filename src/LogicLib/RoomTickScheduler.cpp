@@ -0,0 +1,112 @@
+﻿#include <chrono>
+
+#include "Room.h"
+#include "RoomTickScheduler.h"
+
+namespace NLogicLib
+{
+	void RoomTickScheduler::Init(const int tickPerSec, const int maxRoomUpdatePerTick, const int64_t curMilliSec)
+	{
+		m_TickMilliSec = tickPerSec > 0 ? (1000 / tickPerSec) : 50;
+		if (m_TickMilliSec < 1) {
+			m_TickMilliSec = 1;
+		}
+
+		m_MaxRoomUpdatePerTick = maxRoomUpdatePerTick;
+		m_NextTickMilliSec = curMilliSec + m_TickMilliSec;
+	}
+
+	void RoomTickScheduler::SetActive(Room* pRoom, const bool isActive)
+	{
+		if (pRoom->m_IsTickActive == isActive) {
+			return;
+		}
+		pRoom->m_IsTickActive = isActive;
+
+		if (isActive)
+		{
+			// 앞에 넣는다. 커서는 그대로이므로 이번 바퀴에는 들르지 않고 다음 바퀴부터 처리한다.
+			pRoom->m_pPrevTickRoom = nullptr;
+			pRoom->m_pNextTickRoom = m_pHead;
+			if (m_pHead != nullptr) {
+				m_pHead->m_pPrevTickRoom = pRoom;
+			}
+			m_pHead = pRoom;
+			++m_ActiveRoomCount;
+			return;
+		}
+
+		// Update 중에 자기나 다음 룸이 빠져도 커서가 목록 안을 가리키도록 옮긴다.
+		if (m_pCursor == pRoom) {
+			m_pCursor = pRoom->m_pNextTickRoom;
+		}
+
+		if (pRoom->m_pPrevTickRoom != nullptr) {
+			pRoom->m_pPrevTickRoom->m_pNextTickRoom = pRoom->m_pNextTickRoom;
+		}
+		else {
+			m_pHead = pRoom->m_pNextTickRoom;
+		}
+
+		if (pRoom->m_pNextTickRoom != nullptr) {
+			pRoom->m_pNextTickRoom->m_pPrevTickRoom = pRoom->m_pPrevTickRoom;
+		}
+
+		pRoom->m_pPrevTickRoom = nullptr;
+		pRoom->m_pNextTickRoom = nullptr;
+		--m_ActiveRoomCount;
+	}
+
+	void RoomTickScheduler::Update(const int64_t curMilliSec)
+	{
+		auto tickCount = 0;
+		while (curMilliSec >= m_NextTickMilliSec)
+		{
+			if (tickCount >= MAX_CATCH_UP_TICK)
+			{
+				auto droppedTickCount = (curMilliSec - m_NextTickMilliSec) / m_TickMilliSec + 1;
+				m_NextTickMilliSec += droppedTickCount * m_TickMilliSec;
+				m_Stats.DroppedTickCount += droppedTickCount;
+				break;
+			}
+
+			Tick(m_NextTickMilliSec);
+			m_NextTickMilliSec += m_TickMilliSec;
+			++tickCount;
+		}
+	}
+
+	void RoomTickScheduler::Tick(const int64_t tickMilliSec)
+	{
+		++m_Stats.TickCount;
+		if (m_ActiveRoomCount == 0) {
+			return;
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		auto updateCount = m_ActiveRoomCount;
+		if (m_MaxRoomUpdatePerTick > 0 && updateCount > m_MaxRoomUpdatePerTick)
+		{
+			m_Stats.DeferredRoomCount += updateCount - m_MaxRoomUpdatePerTick;
+			updateCount = m_MaxRoomUpdatePerTick;
+		}
+
+		// 지난 틱이 멈춘 곳부터 이어서 돈다. 끝에 닿으면 처음으로 돌아간다.
+		for (int i = 0; i < updateCount && m_pHead != nullptr; ++i)
+		{
+			auto pRoom = m_pCursor != nullptr ? m_pCursor : m_pHead;
+			m_pCursor = pRoom->m_pNextTickRoom;
+
+			pRoom->Update(tickMilliSec);
+		}
+
+		auto elapsedMicroSec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		if (elapsedMicroSec > m_TickMilliSec * 1000) {
+			++m_Stats.OverrunCount;
+		}
+		if (elapsedMicroSec > m_Stats.MaxTickMicroSec) {
+			m_Stats.MaxTickMicroSec = elapsedMicroSec;
+		}
+	}
+}
@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include <stdint.h>
+
+namespace NLogicLib
+{
+	class Room;
+
+	// 로비를 맡은 스레드만 쓰므로 그냥 정수다. 관리용 값은 Main::PublishMetrics 가 1초에 한 번 옮겨 담는다.
+	struct RoomTickStats
+	{
+		int64_t TickCount = 0;			// 돈 틱 수
+		int64_t OverrunCount = 0;		// 한 틱 처리가 틱 간격보다 오래 걸린 수
+		int64_t DroppedTickCount = 0;	// 너무 밀려서 따라잡지 않고 버린 틱 수
+		int64_t DeferredRoomCount = 0;	// 틱마다 처리 한도에 걸려 다음 틱으로 미룬 룸 수의 합
+		int64_t MaxTickMicroSec = 0;	// 가장 오래 걸린 한 틱
+	};
+
+	/*
+	게임 중인 룸(GameState::STARTING, ING)만 고정 간격으로 Room::Update 한다. 로비마다 하나씩 두고 로비를 맡은 스레드의 StateCheck 에서 돌린다.
+	활성 룸은 Room 안의 포인터로 잇는 목록에 들어 있어서 쉬는 룸은 훑지 않는다. 한 틱에 처리할 룸 수에 한도를 두고, 넘치면 다음 틱이 이어서 처리한다.
+	*/
+	class RoomTickScheduler
+	{
+	public:
+		// maxRoomUpdatePerTick 가 0 이면 한 틱에 활성 룸을 모두 처리한다.
+		void Init(const int tickPerSec, const int maxRoomUpdatePerTick, const int64_t curMilliSec);
+
+		// 룸의 게임 상태가 바뀔 때 Lobby::OnRoomChanged 에서 부른다. 이미 그 상태면 아무것도 하지 않는다.
+		void SetActive(Room* pRoom, const bool isActive);
+
+		// 지난 뒤로 시간이 된 틱을 돈다. 밀렸으면 MAX_CATCH_UP_TICK 까지만 따라잡고 나머지는 버린다.
+		void Update(const int64_t curMilliSec);
+
+		int ActiveRoomCount() { return m_ActiveRoomCount; }
+		RoomTickStats& GetStats() { return m_Stats; }
+
+	private:
+		// tickMilliSec 는 이 틱이 돌아야 했던 시간. 밀려서 따라잡을 때도 룸은 틱 간격대로 시간이 흐른 것으로 본다.
+		void Tick(const int64_t tickMilliSec);
+
+	private:
+		const int MAX_CATCH_UP_TICK = 4;
+
+		int64_t m_TickMilliSec = 50;
+		int m_MaxRoomUpdatePerTick = 0;
+		int64_t m_NextTickMilliSec = 0;
+
+		Room* m_pHead = nullptr;
+		Room* m_pCursor = nullptr;	//다음 틱에 처음 처리할 룸. nullptr 이면 처음부터
+		int m_ActiveRoomCount = 0;
+
+		RoomTickStats m_Stats;
+	};
+}
@@ -0,0 +1,87 @@
+﻿#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+#include "../Common/PacketID.h"
+
+namespace NLogicLib
+{
+	// 패킷 처리 시간 분포. i 번째 버킷은 2^i 마이크로초 이하, 마지막 버킷은 그 이상 전부.
+	const int PACKET_LATENCY_BUCKET_COUNT = 16;
+	const int MAX_PACKET_METRIC_COUNT = (int)NCommon::PACKET_ID::MAX;
+
+	struct PacketMetric
+	{
+		std::atomic<int64_t> Count{ 0 };
+		std::atomic<int64_t> TotalNanoSec{ 0 };
+		std::atomic<int64_t> Buckets[PACKET_LATENCY_BUCKET_COUNT] = {};
+	};
+
+	struct LobbyMetric
+	{
+		std::atomic<int> UserCount{ 0 };
+		std::atomic<int> MaxUserCount{ 0 };
+		std::atomic<int> UsedRoomCount{ 0 };
+		std::atomic<int> MaxRoomCount{ 0 };
+
+		// 룸 틱(RoomTickScheduler)
+		std::atomic<int> ActiveRoomCount{ 0 };
+		std::atomic<int64_t> RoomTickCount{ 0 };
+		std::atomic<int64_t> RoomTickOverrunCount{ 0 };
+		std::atomic<int64_t> RoomTickDroppedCount{ 0 };
+		std::atomic<int64_t> RoomTickDeferredCount{ 0 };
+		std::atomic<int64_t> RoomTickMaxMicroSec{ 0 };
+	};
+
+	// 로직 스레드가 갱신하고 관리용 스레드가 락 없이 읽어 가는 값들.
+	class ServerMetrics
+	{
+	public:
+		void Init(const int lobbyCount)
+		{
+			m_LobbyCount = lobbyCount;
+			m_pLobbyMetrics = std::make_unique<LobbyMetric[]>(lobbyCount);
+		}
+
+		void RecordPacket(const short packetId, const int64_t elapsedNanoSec)
+		{
+			if (packetId < 0 || packetId >= MAX_PACKET_METRIC_COUNT) {
+				return;
+			}
+
+			auto& metric = m_PacketMetrics[packetId];
+			metric.Count.fetch_add(1, std::memory_order_relaxed);
+			metric.TotalNanoSec.fetch_add(elapsedNanoSec, std::memory_order_relaxed);
+			metric.Buckets[LatencyBucket(elapsedNanoSec)].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static int LatencyBucket(const int64_t elapsedNanoSec)
+		{
+			auto microSec = elapsedNanoSec / 1000;
+
+			int bucket = 0;
+			while (bucket < (PACKET_LATENCY_BUCKET_COUNT - 1) && ((int64_t)1 << bucket) < microSec) {
+				++bucket;
+			}
+			return bucket;
+		}
+
+		PacketMetric& GetPacketMetric(const int packetId) { return m_PacketMetrics[packetId]; }
+
+		int LobbyCount() { return m_LobbyCount; }
+		LobbyMetric& GetLobbyMetric(const int lobbyIndex) { return m_pLobbyMetrics[lobbyIndex]; }
+
+	public:
+		std::atomic<int> UserCount{ 0 };
+		std::atomic<int> MaxUserCount{ 0 };
+		std::atomic<int64_t> PublishTimeSec{ 0 };
+
+	private:
+		PacketMetric m_PacketMetrics[MAX_PACKET_METRIC_COUNT];
+
+		int m_LobbyCount = 0;
+		std::unique_ptr<LobbyMetric[]> m_pLobbyMetrics;
+	};
+}
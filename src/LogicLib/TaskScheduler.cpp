@@ -0,0 +1,399 @@
+﻿#include "../ServerNetLib/ILog.h"
+#include "TaskScheduler.h"
+
+using LOG_TYPE = NServerNetLib::LOG_TYPE;
+
+namespace NLogicLib
+{
+	namespace
+	{
+		// 작업 스레드 덱 크기(2의 거듭제곱). ParallelFor 는 나눌 때마다 하나씩 넣으므로 범위 크기의 log2 만큼만 쌓인다.
+		const int TASK_DEQUE_CAPACITY_LOG = 10;
+
+		thread_local TaskScheduler* t_pCurrentScheduler = nullptr;
+		thread_local int t_CurrentWorkerIndex = -1;
+		thread_local unsigned int t_StealSeed = 0;
+	}
+
+	TaskScheduler::TaskScheduler() {}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		Release();
+	}
+
+	void TaskScheduler::Init(const int workerCount, ILog* pLogger)
+	{
+		m_pRefLogger = pLogger;
+
+		for (int i = 0; i < workerCount; ++i)
+		{
+			auto pWorker = std::make_unique<Worker>();
+			pWorker->Deque.Init(TASK_DEQUE_CAPACITY_LOG);
+			m_WorkerList.push_back(std::move(pWorker));
+		}
+
+		// 모든 덱을 만든 뒤에 띄워야 훔치러 갈 때 빈 자리가 없다.
+		for (int i = 0; i < workerCount; ++i)
+		{
+			m_WorkerList[i]->Thread = std::thread([this, i]() { WorkerThread(i); });
+		}
+
+		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | TaskWorkerCount(%d)", __FUNCTION__, workerCount);
+	}
+
+	void TaskScheduler::Release()
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_Lock);
+			m_IsStop = true;
+		}
+		m_WorkCond.notify_all();
+
+		for (auto& pWorker : m_WorkerList)
+		{
+			if (pWorker->Thread.joinable()) {
+				pWorker->Thread.join();
+			}
+		}
+
+		// 다른 스레드가 나간 뒤에 넣은 작업이 남았을 수 있다.
+		for (auto& pWorker : m_WorkerList)
+		{
+			while (auto pTask = pWorker->Deque.Pop()) {
+				delete pTask;
+			}
+			while (auto pTask = pWorker->PinnedQueue.Pop()) {
+				delete pTask;
+			}
+			DeletePool(pWorker->Pool);
+		}
+		m_WorkerList.clear();
+
+		while (auto pTask = m_InjectQueue.Pop()) {
+			delete pTask;
+		}
+		DeletePool(m_ExternalPool);
+	}
+
+	int TaskScheduler::CurrentWorkerIndex()
+	{
+		return t_pCurrentScheduler == this ? t_CurrentWorkerIndex : -1;
+	}
+
+	void TaskScheduler::Submit(TaskGroup& group, TaskFunc func)
+	{
+		group.m_RemainCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (m_WorkerList.empty())
+		{
+			m_Stats.InlineCount.fetch_add(1, std::memory_order_relaxed);
+			func();
+			FinishTask(&group);
+			return;
+		}
+
+		auto pTask = AllocTask(std::move(func), &group);
+		m_StealableCount.fetch_add(1, std::memory_order_seq_cst);
+
+		auto workerIndex = CurrentWorkerIndex();
+		if (workerIndex >= 0)
+		{
+			if (m_WorkerList[workerIndex]->Deque.Push(pTask) == false)
+			{
+				m_StealableCount.fetch_sub(1, std::memory_order_relaxed);
+				m_Stats.InlineCount.fetch_add(1, std::memory_order_relaxed);
+				Execute(pTask);
+				return;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> guard(m_InjectLock);
+			m_InjectQueue.Push(pTask);
+		}
+
+		WakeWorker(false);
+	}
+
+	void TaskScheduler::SubmitTo(const int workerIndex, TaskGroup& group, TaskFunc func)
+	{
+		group.m_RemainCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (m_WorkerList.empty())
+		{
+			m_Stats.InlineCount.fetch_add(1, std::memory_order_relaxed);
+			func();
+			FinishTask(&group);
+			return;
+		}
+
+		auto& worker = *m_WorkerList[workerIndex % (int)m_WorkerList.size()];
+		auto pTask = AllocTask(std::move(func), &group);
+		{
+			std::lock_guard<std::mutex> guard(worker.PinnedLock);
+			worker.PinnedQueue.Push(pTask);
+			worker.PinnedCount.fetch_add(1, std::memory_order_seq_cst);
+		}
+
+		// 어느 스레드가 깨어날지 고를 수 없으므로 모두 깨운다.
+		WakeWorker(true);
+	}
+
+	void TaskScheduler::ParallelFor(TaskGroup& group, const int begin, const int end, const int grainSize, RangeFunc func)
+	{
+		if (end <= begin) {
+			return;
+		}
+
+		auto pFunc = std::make_shared<RangeFunc>(std::move(func));
+		auto grain = grainSize > 0 ? grainSize : 1;
+		Submit(group, [this, &group, begin, end, grain, pFunc]() { SplitRange(group, begin, end, grain, pFunc); });
+	}
+
+	void TaskScheduler::SplitRange(TaskGroup& group, int begin, int end, const int grainSize, std::shared_ptr<RangeFunc> pFunc)
+	{
+		// 뒤쪽 반을 덱에 넣고 앞쪽 반을 계속 나눈다. 놀고 있는 스레드는 덱 위쪽의 큰 덩어리부터 훔쳐 간다.
+		while (end - begin > grainSize)
+		{
+			auto mid = begin + (end - begin) / 2;
+			Submit(group, [this, &group, mid, end, grainSize, pFunc]() { SplitRange(group, mid, end, grainSize, pFunc); });
+			end = mid;
+		}
+
+		(*pFunc)(begin, end);
+	}
+
+	void TaskScheduler::Wait(TaskGroup& group)
+	{
+		auto workerIndex = CurrentWorkerIndex();
+
+		while (group.IsDone() == false)
+		{
+			auto pTask = workerIndex >= 0 ? FindTask(workerIndex) : StealTask(-1);
+			if (pTask != nullptr)
+			{
+				Execute(pTask);
+				continue;
+			}
+
+			// 작업 스레드는 자기에게 맡긴 작업을 기다리고 있을 수 있으므로 잠들지 않는다.
+			if (workerIndex >= 0)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_Lock);
+			m_DoneCond.wait(lock, [&group]() { return group.IsDone(); });
+		}
+	}
+
+	void TaskScheduler::WorkerThread(const int workerIndex)
+	{
+		t_pCurrentScheduler = this;
+		t_CurrentWorkerIndex = workerIndex;
+		t_StealSeed = (unsigned int)workerIndex;
+
+		auto& worker = *m_WorkerList[workerIndex];
+
+		while (true)
+		{
+			auto pTask = FindTask(workerIndex);
+			if (pTask != nullptr)
+			{
+				Execute(pTask);
+				continue;
+			}
+
+			// 멈출 때는 남은 작업을 모두 처리하고 나간다.
+			std::unique_lock<std::mutex> lock(m_Lock);
+			if (m_IsStop) {
+				return;
+			}
+
+			++m_SleepCount;
+			m_WorkCond.wait(lock, [this, &worker]() {
+				return m_IsStop || m_StealableCount.load(std::memory_order_seq_cst) > 0 || worker.PinnedCount.load(std::memory_order_seq_cst) > 0;
+			});
+			--m_SleepCount;
+		}
+	}
+
+	/*
+	맡은 작업, 자기 덱, 다른 곳에서 훔치기 순서로 찾는다. 자기 덱은 최근에 넣은 것부터 꺼내서 캐시에 남아 있는 데이터를 쓴다.
+	*/
+	TaskScheduler::Task* TaskScheduler::FindTask(const int workerIndex)
+	{
+		auto& worker = *m_WorkerList[workerIndex];
+
+		if (worker.PinnedCount.load(std::memory_order_relaxed) > 0)
+		{
+			std::lock_guard<std::mutex> guard(worker.PinnedLock);
+			if (worker.PinnedQueue.IsEmpty() == false)
+			{
+				auto pTask = worker.PinnedQueue.Pop();
+				worker.PinnedCount.fetch_sub(1, std::memory_order_relaxed);
+				return pTask;
+			}
+		}
+
+		if (auto pTask = worker.Deque.Pop())
+		{
+			m_StealableCount.fetch_sub(1, std::memory_order_relaxed);
+			return pTask;
+		}
+
+		return StealTask(workerIndex);
+	}
+
+	TaskScheduler::Task* TaskScheduler::StealTask(const int workerIndex)
+	{
+		if (m_StealableCount.load(std::memory_order_relaxed) == 0) {
+			return nullptr;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(m_InjectLock);
+			if (m_InjectQueue.IsEmpty() == false)
+			{
+				auto pTask = m_InjectQueue.Pop();
+				m_StealableCount.fetch_sub(1, std::memory_order_relaxed);
+				return pTask;
+			}
+		}
+
+		// 매번 같은 스레드부터 훔치면 그 덱에만 몰리므로 시작 위치를 돌린다.
+		auto workerCount = (int)m_WorkerList.size();
+		auto start = (int)(t_StealSeed++ % (unsigned int)workerCount);
+		for (int i = 0; i < workerCount; ++i)
+		{
+			auto victimIndex = (start + i) % workerCount;
+			if (victimIndex == workerIndex) {
+				continue;
+			}
+
+			if (auto pTask = m_WorkerList[victimIndex]->Deque.Steal())
+			{
+				m_StealableCount.fetch_sub(1, std::memory_order_relaxed);
+				m_Stats.StealCount.fetch_add(1, std::memory_order_relaxed);
+				return pTask;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void TaskScheduler::Execute(Task* pTask)
+	{
+		pTask->Func();
+
+		auto pGroup = pTask->pGroup;
+		FreeTask(pTask);
+
+		m_Stats.ExecuteCount.fetch_add(1, std::memory_order_relaxed);
+		FinishTask(pGroup);
+	}
+
+	/*
+	작업 노드는 만든 스레드의 풀에서 꺼내고 그 풀로 돌려준다. 로직 스레드가 SubmitTo 로 넣은 노드는 작업 스레드가 처리하고 돌려주므로
+	남이 돌려준 노드는 pRemoteFreeHead 에 쌓이고, 주인은 자기 목록이 비었을 때 exchange 로 통째로 가져간다(하나씩 꺼내지 않으므로 ABA 가 없다).
+	*/
+	TaskScheduler::Task* TaskScheduler::AllocTask(TaskFunc&& func, TaskGroup* pGroup)
+	{
+		auto workerIndex = CurrentWorkerIndex();
+		auto pPool = workerIndex >= 0 ? &m_WorkerList[workerIndex]->Pool : &m_ExternalPool;
+
+		Task* pTask = nullptr;
+		if (workerIndex >= 0)
+		{
+			pTask = PopFreeTask(*pPool);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> guard(m_ExternalPoolLock);
+			pTask = PopFreeTask(*pPool);
+		}
+
+		if (pTask == nullptr)
+		{
+			pTask = new Task;
+			pTask->pOwnerPool = pPool;
+		}
+
+		pTask->Func = std::move(func);
+		pTask->pGroup = pGroup;
+		return pTask;
+	}
+
+	void TaskScheduler::FreeTask(Task* pTask)
+	{
+		// 캡처한 값(ParallelFor 의 shared_ptr 등)은 바로 놓는다.
+		pTask->Func = nullptr;
+		pTask->pGroup = nullptr;
+
+		auto pPool = pTask->pOwnerPool;
+		auto workerIndex = CurrentWorkerIndex();
+		if (workerIndex >= 0 && pPool == &m_WorkerList[workerIndex]->Pool)
+		{
+			pTask->pNext = pPool->pFreeHead;
+			pPool->pFreeHead = pTask;
+			return;
+		}
+
+		auto pHead = pPool->pRemoteFreeHead.load(std::memory_order_relaxed);
+		do {
+			pTask->pNext = pHead;
+		} while (pPool->pRemoteFreeHead.compare_exchange_weak(pHead, pTask, std::memory_order_release, std::memory_order_relaxed) == false);
+	}
+
+	TaskScheduler::Task* TaskScheduler::PopFreeTask(TaskPool& pool)
+	{
+		if (pool.pFreeHead == nullptr)
+		{
+			pool.pFreeHead = pool.pRemoteFreeHead.exchange(nullptr, std::memory_order_acquire);
+			if (pool.pFreeHead == nullptr) {
+				return nullptr;
+			}
+		}
+
+		auto pTask = pool.pFreeHead;
+		pool.pFreeHead = pTask->pNext;
+		pTask->pNext = nullptr;
+		return pTask;
+	}
+
+	void TaskScheduler::DeletePool(TaskPool& pool)
+	{
+		// 작업 스레드가 모두 나간 뒤에 부르므로 자기 목록과 남이 돌려준 목록을 차례로 비운다.
+		while (auto pTask = PopFreeTask(pool)) {
+			delete pTask;
+		}
+	}
+
+	void TaskScheduler::FinishTask(TaskGroup* pGroup)
+	{
+		// 0 이 된 뒤로는 기다리던 쪽이 group 을 없앨 수 있으므로 더 건드리지 않는다.
+		if (pGroup->m_RemainCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			std::lock_guard<std::mutex> guard(m_Lock);
+			m_DoneCond.notify_all();
+		}
+	}
+
+	void TaskScheduler::WakeWorker(const bool isAll)
+	{
+		// 잠들기 전에 m_Lock 을 잡고 다시 확인하므로, 잠그고 깨우면 놓치지 않는다.
+		std::lock_guard<std::mutex> guard(m_Lock);
+		if (m_SleepCount == 0) {
+			return;
+		}
+
+		if (isAll) {
+			m_WorkCond.notify_all();
+		}
+		else {
+			m_WorkCond.notify_one();
+		}
+	}
+}
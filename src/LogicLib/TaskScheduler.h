@@ -0,0 +1,179 @@
+﻿#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingDeque.h"
+
+namespace NServerNetLib
+{
+	class ILog;
+}
+
+namespace NLogicLib
+{
+	// 같이 기다릴 작업 묶음. 넣은 작업이 모두 끝나면 IsDone 이 true 가 된다.
+	class TaskGroup
+	{
+	public:
+		bool IsDone() { return m_RemainCount.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class TaskScheduler;
+		std::atomic<int> m_RemainCount{ 0 };
+	};
+
+	struct TaskSchedulerStats
+	{
+		std::atomic<long long> ExecuteCount{ 0 };	// 처리한 작업 수
+		std::atomic<long long> StealCount{ 0 };		// 그중 다른 작업 스레드의 덱에서 훔쳐 온 수
+		std::atomic<long long> InlineCount{ 0 };	// 작업 스레드가 없거나 덱이 꽉 차서 넣은 쪽이 바로 처리한 수
+	};
+
+	// 작업 훔치기 스레드 풀. 작업 스레드마다 Chase-Lev 덱을 두고, 일이 없는 스레드는 다른 스레드의 덱에서 훔쳐 간다.
+	// 작업 스레드가 0 개면 모든 작업을 넣은 쪽에서 바로 처리하므로 예전처럼 로직 스레드 하나로 돈다.
+	class TaskScheduler
+	{
+		using ILog = NServerNetLib::ILog;
+
+	public:
+		using TaskFunc = std::function<void()>;
+		using RangeFunc = std::function<void(const int begin, const int end)>;
+
+		TaskScheduler();
+		~TaskScheduler();
+
+		void Init(const int workerCount, ILog* pLogger);
+
+		// 이미 넣은 작업을 모두 처리한 뒤 작업 스레드를 멈춘다.
+		void Release();
+
+		int WorkerCount() { return (int)m_WorkerList.size(); }
+
+		// 아무 작업 스레드나 처리한다. 작업 스레드 안에서 부르면 자기 덱에 넣어서 놀고 있는 스레드가 훔쳐 갈 수 있다.
+		void Submit(TaskGroup& group, TaskFunc func);
+
+		// workerIndex % WorkerCount 번 작업 스레드만 처리한다. 그 스레드가 맡은 데이터만 건드리는 작업용이며 훔쳐 가지 않는다.
+		void SubmitTo(const int workerIndex, TaskGroup& group, TaskFunc func);
+
+		// [begin, end) 를 grainSize 이하가 될 때까지 반씩 나눠 처리한다. 나눈 반쪽은 다른 스레드가 훔쳐 갈 수 있다.
+		void ParallelFor(TaskGroup& group, const int begin, const int end, const int grainSize, RangeFunc func);
+
+		// group 이 끝날 때까지 기다린다. 기다리는 동안 훔칠 수 있는 작업은 같이 처리한다.
+		void Wait(TaskGroup& group);
+
+		// 지금 스레드가 이 풀의 작업 스레드면 그 번호, 아니면 -1.
+		int CurrentWorkerIndex();
+
+		TaskSchedulerStats& GetStats() { return m_Stats; }
+
+	private:
+		struct TaskPool;
+
+		struct Task
+		{
+			TaskFunc Func;
+			TaskGroup* pGroup = nullptr;
+			TaskPool* pOwnerPool = nullptr;
+			Task* pNext = nullptr;	// 큐나 빈 노드 목록에서 다음 작업
+		};
+
+		// 다 쓴 작업 노드를 모아 두고 다시 쓴다. 한 번 잡은 노드는 Release 까지 돌려주지 않으므로 일정하게 돌면 메모리를 잡지 않는다.
+		// pFreeHead 는 주인만 쓰고, 다른 스레드가 처리한 노드는 pRemoteFreeHead 에 넣어 두었다가 주인이 한꺼번에 가져간다.
+		struct TaskPool
+		{
+			Task* pFreeHead = nullptr;
+			std::atomic<Task*> pRemoteFreeHead{ nullptr };
+		};
+
+		// 넣은 순서대로 꺼내는 작업 큐. 노드의 pNext 로 이어서 메모리를 잡지 않는다. 쓰는 쪽이 잠근다.
+		struct TaskQueue
+		{
+			bool IsEmpty() { return pHead == nullptr; }
+
+			void Push(Task* pTask)
+			{
+				pTask->pNext = nullptr;
+				if (pTail != nullptr) {
+					pTail->pNext = pTask;
+				}
+				else {
+					pHead = pTask;
+				}
+				pTail = pTask;
+			}
+
+			Task* Pop()
+			{
+				auto pTask = pHead;
+				if (pTask != nullptr)
+				{
+					pHead = pTask->pNext;
+					if (pHead == nullptr) {
+						pTail = nullptr;
+					}
+					pTask->pNext = nullptr;
+				}
+				return pTask;
+			}
+
+			Task* pHead = nullptr;
+			Task* pTail = nullptr;
+		};
+
+		struct Worker
+		{
+			WorkStealingDeque<Task> Deque;
+
+			// SubmitTo 로 이 스레드에 맡긴 작업. 다른 스레드가 넣으므로 잠근다.
+			std::mutex PinnedLock;
+			TaskQueue PinnedQueue;
+			std::atomic<int> PinnedCount{ 0 };
+
+			TaskPool Pool;
+
+			std::thread Thread;
+		};
+
+		void WorkerThread(const int workerIndex);
+		Task* FindTask(const int workerIndex);
+		Task* StealTask(const int workerIndex);
+		void Execute(Task* pTask);
+		Task* AllocTask(TaskFunc&& func, TaskGroup* pGroup);
+		void FreeTask(Task* pTask);
+		Task* PopFreeTask(TaskPool& pool);
+		void DeletePool(TaskPool& pool);
+		void FinishTask(TaskGroup* pGroup);
+		void WakeWorker(const bool isAll);
+		void SplitRange(TaskGroup& group, int begin, int end, const int grainSize, std::shared_ptr<RangeFunc> pFunc);
+
+	private:
+		ILog* m_pRefLogger = nullptr;
+
+		std::vector<std::unique_ptr<Worker>> m_WorkerList;
+
+		// 작업 스레드가 아닌 스레드(로직 스레드)가 Submit 한 작업
+		std::mutex m_InjectLock;
+		TaskQueue m_InjectQueue;
+
+		// 작업 스레드가 아닌 스레드가 만든 작업 노드. 그런 스레드가 여럿일 수 있으므로 pFreeHead 는 잠그고 쓴다.
+		std::mutex m_ExternalPoolLock;
+		TaskPool m_ExternalPool;
+
+		// 훔칠 수 있는 곳(덱, m_InjectQueue)에 남아 있는 작업 수. 잠든 작업 스레드를 깨울지 정한다.
+		std::atomic<int> m_StealableCount{ 0 };
+
+		std::mutex m_Lock;
+		std::condition_variable m_WorkCond;
+		std::condition_variable m_DoneCond;
+		int m_SleepCount = 0;
+		bool m_IsStop = false;
+
+		TaskSchedulerStats m_Stats;
+	};
+}
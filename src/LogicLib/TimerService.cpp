@@ -0,0 +1,177 @@
+﻿#include "TimerService.h"
+
+namespace NLogicLib
+{
+	void TimerService::Init(const int reserveTimerCount, const int64_t curMilliSec)
+	{
+		m_NodeList.reserve(reserveTimerCount);
+		m_FireList.reserve(reserveTimerCount);
+		m_SlotHeadList.assign(TIMER_WHEEL_SIZE, -1);
+		m_CurTick = curMilliSec / TIMER_TICK_MILLISEC;
+	}
+
+	TimerId TimerService::AddTimer(const int delayMilliSec, TimerCallback pCallback, void* pContext)
+	{
+		auto index = AllocNode();
+		auto& node = m_NodeList[index];
+
+		// 이번 틱은 이미 지나간 것으로 보고 적어도 다음 틱에 부른다.
+		auto delayTick = (delayMilliSec + TIMER_TICK_MILLISEC - 1) / TIMER_TICK_MILLISEC;
+		node.ExpireTick = m_CurTick + (delayTick > 0 ? delayTick : 1);
+		node.pCallback = pCallback;
+		node.pContext = pContext;
+		node.State = TIMER_NODE_STATE::WAIT;
+
+		LinkNode(index);
+		++m_TimerCount;
+
+		return TimerId{ index, node.Generation };
+	}
+
+	void TimerService::CancelTimer(TimerId& timerId)
+	{
+		if (timerId.IsValid() == false || timerId.Index >= (int)m_NodeList.size()) {
+			return;
+		}
+
+		auto& node = m_NodeList[timerId.Index];
+		if (node.Generation != timerId.Generation) {
+			timerId = TimerId();
+			return;
+		}
+
+		if (node.State == TIMER_NODE_STATE::WAIT)
+		{
+			UnlinkNode(timerId.Index);
+			FreeNode(timerId.Index);
+		}
+		else if (node.State == TIMER_NODE_STATE::FIRING)
+		{
+			// 지금 돌고 있는 Update 가 부르지 않고 돌려놓는다.
+			node.State = TIMER_NODE_STATE::CANCELED;
+		}
+
+		timerId = TimerId();
+	}
+
+	void TimerService::Update(const int64_t curMilliSec)
+	{
+		// 다른 스레드가 넘긴 코루틴. 잠근 동안에는 목록만 바꿔 치운다.
+		{
+			std::lock_guard<std::mutex> guard(m_PostLock);
+			m_ResumeList.swap(m_PostList);
+		}
+		for (auto handle : m_ResumeList) {
+			handle.resume();
+		}
+		m_ResumeList.clear();
+
+		// 오래 멈춰 있었어도 슬롯은 한 바퀴만 본다. 휠보다 늦은 타이머도 그 한 바퀴 안에서 모두 불린다.
+		auto targetTick = curMilliSec / TIMER_TICK_MILLISEC;
+		if (targetTick - m_CurTick > TIMER_WHEEL_SIZE) {
+			m_CurTick = targetTick - TIMER_WHEEL_SIZE;
+		}
+
+		while (m_CurTick < targetTick)
+		{
+			++m_CurTick;
+			ProcessSlot(m_CurTick);
+		}
+	}
+
+	void TimerService::Post(std::coroutine_handle<> handle)
+	{
+		std::lock_guard<std::mutex> guard(m_PostLock);
+		m_PostList.push_back(handle);
+	}
+
+	/*
+	콜백이 타이머를 더하거나 지울 수 있으므로 먼저 시간이 된 노드를 슬롯에서 떼어 m_FireList 에 모은 뒤 부른다.
+	*/
+	void TimerService::ProcessSlot(const int64_t tick)
+	{
+		auto index = m_SlotHeadList[tick & (TIMER_WHEEL_SIZE - 1)];
+		while (index >= 0)
+		{
+			auto& node = m_NodeList[index];
+			auto next = node.Next;
+
+			if (node.ExpireTick <= tick)
+			{
+				UnlinkNode(index);
+				node.State = TIMER_NODE_STATE::FIRING;
+				m_FireList.push_back(index);
+			}
+			index = next;
+		}
+
+		for (auto fireIndex : m_FireList)
+		{
+			auto& node = m_NodeList[fireIndex];
+			if (node.State == TIMER_NODE_STATE::FIRING) {
+				node.pCallback(node.pContext);
+			}
+
+			// 콜백 안에서 AddTimer 가 m_NodeList 를 늘렸을 수 있으므로 다시 찾는다.
+			FreeNode(fireIndex);
+		}
+		m_FireList.clear();
+	}
+
+	int TimerService::AllocNode()
+	{
+		if (m_FreeNodeHead < 0)
+		{
+			m_NodeList.emplace_back();
+			return (int)m_NodeList.size() - 1;
+		}
+
+		auto index = m_FreeNodeHead;
+		m_FreeNodeHead = m_NodeList[index].Next;
+		return index;
+	}
+
+	void TimerService::FreeNode(const int index)
+	{
+		auto& node = m_NodeList[index];
+		++node.Generation;
+		node.State = TIMER_NODE_STATE::FREE;
+		node.pCallback = nullptr;
+		node.pContext = nullptr;
+		node.Prev = -1;
+		node.Next = m_FreeNodeHead;
+		m_FreeNodeHead = index;
+
+		--m_TimerCount;
+	}
+
+	void TimerService::LinkNode(const int index)
+	{
+		auto& head = m_SlotHeadList[m_NodeList[index].ExpireTick & (TIMER_WHEEL_SIZE - 1)];
+		auto& node = m_NodeList[index];
+		node.Prev = -1;
+		node.Next = head;
+		if (head >= 0) {
+			m_NodeList[head].Prev = index;
+		}
+		head = index;
+	}
+
+	void TimerService::UnlinkNode(const int index)
+	{
+		auto& node = m_NodeList[index];
+		if (node.Prev >= 0) {
+			m_NodeList[node.Prev].Next = node.Next;
+		}
+		else {
+			m_SlotHeadList[node.ExpireTick & (TIMER_WHEEL_SIZE - 1)] = node.Next;
+		}
+
+		if (node.Next >= 0) {
+			m_NodeList[node.Next].Prev = node.Prev;
+		}
+
+		node.Prev = -1;
+		node.Next = -1;
+	}
+}
@@ -0,0 +1,100 @@
+﻿#pragma once
+
+#include <stdint.h>
+#include <coroutine>
+#include <mutex>
+#include <vector>
+
+namespace NLogicLib
+{
+	using TimerCallback = void(*)(void* pContext);
+
+	// 타이머를 취소할 때 쓴다. 끝난 타이머의 자리가 다시 쓰여도 Generation 이 달라서 엉뚱한 타이머를 지우지 않는다.
+	struct TimerId
+	{
+		bool IsValid() { return Index >= 0; }
+
+		int Index = -1;
+		unsigned int Generation = 0;
+	};
+
+	/*
+	로비 하나가 쓰는 타이머. 틱 단위 해시 타이머 휠이며, 로비를 맡은 스레드(로직 샤드)의 StateCheck 에서 Update 로 돌린다.
+	타이머 노드는 풀에서 꺼내 쓰므로 최대 개수까지 쌓인 뒤로는 메모리를 잡지 않는다. Post 외에는 스레드 안전하지 않다.
+	*/
+	class TimerService
+	{
+	public:
+		void Init(const int reserveTimerCount, const int64_t curMilliSec);
+
+		// delayMilliSec 뒤의 Update 에서 pCallback(pContext) 를 부른다. 틱 단위로 올림한다.
+		TimerId AddTimer(const int delayMilliSec, TimerCallback pCallback, void* pContext);
+		void CancelTimer(TimerId& timerId);
+
+		// 시간이 된 타이머와 Post 로 넘어온 코루틴을 처리한다.
+		void Update(const int64_t curMilliSec);
+
+		// 다른 스레드에서 끝난 작업이 코루틴을 이 타이머를 돌리는 스레드에서 이어서 실행하도록 넘긴다.
+		void Post(std::coroutine_handle<> handle);
+
+		int TimerCount() { return m_TimerCount; }
+
+		// co_await timerService.Sleep(ms);
+		struct SleepAwaiter
+		{
+			bool await_ready() { return false; }
+			void await_suspend(std::coroutine_handle<> handle) { pService->AddTimer(DelayMilliSec, &ResumeCoroutine, handle.address()); }
+			void await_resume() {}
+
+			TimerService* pService;
+			int DelayMilliSec;
+		};
+
+		SleepAwaiter Sleep(const int delayMilliSec) { return SleepAwaiter{ this, delayMilliSec }; }
+
+		static void ResumeCoroutine(void* pContext) { std::coroutine_handle<>::from_address(pContext).resume(); }
+
+	private:
+		enum class TIMER_NODE_STATE : char
+		{
+			FREE,
+			WAIT,		// 휠의 슬롯에 걸려 있다
+			FIRING,		// 이번 Update 에서 부를 목록에 들어갔다
+			CANCELED,	// 부를 목록에 들어간 뒤 취소됐다
+		};
+
+		struct TimerNode
+		{
+			int64_t ExpireTick = 0;
+			TimerCallback pCallback = nullptr;
+			void* pContext = nullptr;
+			unsigned int Generation = 0;
+			TIMER_NODE_STATE State = TIMER_NODE_STATE::FREE;
+			int Prev = -1;
+			int Next = -1;		// 슬롯 안의 다음 노드, 비어 있으면 다음 빈 노드
+		};
+
+		int AllocNode();
+		void FreeNode(const int index);
+		void LinkNode(const int index);
+		void UnlinkNode(const int index);
+		void ProcessSlot(const int64_t tick);
+
+	private:
+		const int TIMER_TICK_MILLISEC = 10;
+		const int TIMER_WHEEL_SIZE = 256;	// 2의 거듭제곱. 한 바퀴(2.56초)보다 긴 타이머는 자기 틱이 올 때까지 슬롯에 남는다.
+
+		std::vector<TimerNode> m_NodeList;
+		int m_FreeNodeHead = -1;
+		int m_TimerCount = 0;
+
+		std::vector<int> m_SlotHeadList;
+		int64_t m_CurTick = 0;
+
+		std::vector<int> m_FireList;
+
+		std::mutex m_PostLock;
+		std::vector<std::coroutine_handle<>> m_PostList;
+		std::vector<std::coroutine_handle<>> m_ResumeList;
+	};
+}
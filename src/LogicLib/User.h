@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <stdint.h>
+
+#include "UserID.h"
 
 namespace NLogicLib
 {
@@ -26,26 +29,63 @@ namespace NLogicLib
 		void Clear()
 		{			
 			m_SessionIndex = 0;
-			m_ID = "";
+			m_ID.Clear();
 			m_IsAuthConfirm = false;
 			m_CurDomainState = DOMAIN_STATE::NONE;
 			m_LobbyIndex = -1;
+			m_LobbySlotIndex = -1;
 			m_RoomIndex = -1;
+			m_QuickMatchTicket = 0;
+			m_ChatTokenTime = 0;
+			m_ChatToken = 0;
 		}
 
-		void Set(const int sessionIndex, const char* pszID)
+		void Set(const int sessionIndex, const UserID& id)
 		{
 			m_SessionIndex = sessionIndex;
-			m_ID = pszID;
+			m_ID = id;
 			m_IsAuthConfirm = true;
 			m_CurDomainState = DOMAIN_STATE::LOGIN;
 		}
 
 		short GetIndex() { return m_Index; }
 		int GetSessionIndex() { return m_SessionIndex;  }
-		std::string& GetID() { return m_ID;  }
+		const UserID& GetID() { return m_ID;  }
 		bool IsConfirmed() { return m_IsAuthConfirm;  }
 		short GetLobbyIndex() { return m_LobbyIndex; }
+		short GetLobbySlotIndex() { return m_LobbySlotIndex; }
+		void SetLobbySlotIndex(const short slotIndex) { m_LobbySlotIndex = slotIndex; }
+		int GetQuickMatchTicket() { return m_QuickMatchTicket; }
+		void SetQuickMatchTicket(const int ticket) { m_QuickMatchTicket = ticket; }
+
+		// ä Ƚ (ū Ŷ). ʴ perSec  ä burstCount   д. perSec  0 ̸  ʴ´.
+		bool ConsumeChatToken(const int64_t curMilliSec, const int perSec, const int burstCount)
+		{
+			if (perSec <= 0) {
+				return true;
+			}
+
+			const int64_t TOKEN_UNIT = 1000; //ū 1. и  ä  1000   ִ´
+			auto maxToken = (burstCount > 0 ? burstCount : 1) * TOKEN_UNIT;
+
+			if (m_ChatTokenTime == 0) {
+				m_ChatToken = maxToken;
+			}
+			else {
+				m_ChatToken += (curMilliSec - m_ChatTokenTime) * perSec;
+				if (m_ChatToken > maxToken) {
+					m_ChatToken = maxToken;
+				}
+			}
+			m_ChatTokenTime = curMilliSec;
+
+			if (m_ChatToken < TOKEN_UNIT) {
+				return false;
+			}
+
+			m_ChatToken -= TOKEN_UNIT;
+			return true;
+		}
 
 		void EnterLobby(const short lobbyIndex)
 		{
@@ -85,13 +125,19 @@ namespace NLogicLib
 		short m_Index = -1; //UserPool  °
 		int m_SessionIndex = -1; //    °
 
-		std::string m_ID = "";
+		UserID m_ID;
 		
 		bool m_IsAuthConfirm = false;
 		
 		DOMAIN_STATE m_CurDomainState = DOMAIN_STATE::NONE;
 
 		short m_LobbyIndex = -1;
+		short m_LobbySlotIndex = -1; //κ     ° 
 		short m_RoomIndex = -1;
+
+		int m_QuickMatchTicket = 0; //   ̸ 0  ƴϴ. ⿭ ǥ ƾ ȿϴ
+
+		int64_t m_ChatTokenTime = 0; // ä ū ä ð(и). 0 ̸  ä ʾҴ
+		int64_t m_ChatToken = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <string.h>
+#include <stdint.h>
+
+#include "../Common/Packet.h"
+
+namespace NLogicLib
+{
+	// 유저 ID 를 고정 크기로 들고 다니는 키. 남는 뒤쪽은 0 으로 채워 두므로 비교는 memcmp 한 번이면 된다.
+	// 해시는 Set 할 때 한 번만 계산해 둔다.
+	struct UserID
+	{
+		char Value[NCommon::MAX_USER_ID_SIZE + 1] = { 0, };
+		uint32_t Hash = 0;
+
+		UserID() {}
+		explicit UserID(const char* pszID) { Set(pszID); }
+
+		void Set(const char* pszID)
+		{
+			// 패킷에서 온 ID 는 널 문자로 끝난다는 보장이 없으므로 MAX_USER_ID_SIZE 까지만 본다.
+			memset(Value, 0, sizeof(Value));
+
+			uint32_t hash = 2166136261u; // FNV-1a
+			for (int i = 0; i < NCommon::MAX_USER_ID_SIZE && pszID[i] != '\0'; ++i)
+			{
+				Value[i] = pszID[i];
+				hash = (hash ^ (uint8_t)pszID[i]) * 16777619u;
+			}
+			Hash = hash;
+		}
+
+		void Clear()
+		{
+			memset(Value, 0, sizeof(Value));
+			Hash = 0;
+		}
+
+		const char* c_str() const { return Value; }
+
+		bool operator==(const UserID& other) const
+		{
+			return Hash == other.Hash && memcmp(Value, other.Value, sizeof(Value)) == 0;
+		}
+	};
+}
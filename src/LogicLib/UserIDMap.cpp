@@ -0,0 +1,88 @@
+﻿#include "UserIDMap.h"
+
+namespace NLogicLib
+{
+	void UserIDMap::Init(const int maxCount)
+	{
+		// 채움률을 50% 이하로 유지해서 탐사 길이를 짧게 한다.
+		uint32_t capacity = 8;
+		while (capacity < (uint32_t)maxCount * 2) {
+			capacity <<= 1;
+		}
+
+		m_Entries.assign(capacity, Entry());
+		m_Mask = capacity - 1;
+		m_Count = 0;
+		m_MaxCount = maxCount;
+	}
+
+	int UserIDMap::FindSlot(const UserID& key) const
+	{
+		auto slot = HomeSlot(key.Hash);
+		while (m_Entries[slot].pUser != nullptr)
+		{
+			if (m_Entries[slot].Key == key) {
+				return slot;
+			}
+			slot = (slot + 1) & m_Mask;
+		}
+		return -1;
+	}
+
+	User* UserIDMap::Find(const UserID& key) const
+	{
+		auto slot = FindSlot(key);
+		return slot >= 0 ? m_Entries[slot].pUser : nullptr;
+	}
+
+	bool UserIDMap::Insert(const UserID& key, User* pUser)
+	{
+		if (m_Count >= m_MaxCount || pUser == nullptr) {
+			return false;
+		}
+
+		auto slot = HomeSlot(key.Hash);
+		while (m_Entries[slot].pUser != nullptr)
+		{
+			if (m_Entries[slot].Key == key) {
+				return false;
+			}
+			slot = (slot + 1) & m_Mask;
+		}
+
+		m_Entries[slot].Key = key;
+		m_Entries[slot].pUser = pUser;
+		++m_Count;
+		return true;
+	}
+
+	bool UserIDMap::Erase(const UserID& key)
+	{
+		auto slot = FindSlot(key);
+		if (slot < 0) {
+			return false;
+		}
+
+		// 지운 자리 뒤에 이어진 항목들 중 제자리로 당겨 올 수 있는 것을 당겨서 빈칸(툼스톤) 없이 유지한다.
+		auto hole = slot;
+		int next = (int)((hole + 1) & m_Mask);
+		while (m_Entries[next].pUser != nullptr)
+		{
+			auto home = HomeSlot(m_Entries[next].Key.Hash);
+
+			// home 이 (hole, next] 구간 밖에 있으면 hole 로 옮겨도 탐사 경로가 끊기지 않는다.
+			auto isBetween = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+			if (isBetween == false)
+			{
+				m_Entries[hole] = m_Entries[next];
+				hole = next;
+			}
+
+			next = (next + 1) & m_Mask;
+		}
+
+		m_Entries[hole] = Entry();
+		--m_Count;
+		return true;
+	}
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include <vector>
+
+#include "UserID.h"
+
+namespace NLogicLib
+{
+	class User;
+
+	// UserID -> User* 오픈 어드레싱(선형 탐사) 해시맵.
+	// 최대 개수를 Init 에서 정하고 그 두 배 이상의 슬롯을 미리 잡아 두므로 넣고 뺄 때 메모리 할당이 없다.
+	class UserIDMap
+	{
+	public:
+		void Init(const int maxCount);
+
+		User* Find(const UserID& key) const;
+		bool Insert(const UserID& key, User* pUser);
+		bool Erase(const UserID& key);
+
+		int Size() const { return m_Count; }
+
+	private:
+		struct Entry
+		{
+			UserID Key;
+			User* pUser = nullptr; // nullptr 이면 빈 슬롯
+		};
+
+		int FindSlot(const UserID& key) const;
+		int HomeSlot(const uint32_t hash) const { return (int)(hash & m_Mask); }
+
+	private:
+		std::vector<Entry> m_Entries;
+		uint32_t m_Mask = 0;
+		int m_Count = 0;
+		int m_MaxCount = 0;
+	};
+}
@@ -1,4 +1,4 @@
-#include <algorithm>
+﻿#include <algorithm>
 #include "../Common/ErrorCode.h"
 #include "User.h"
 #include "UserManager.h"
@@ -23,6 +23,10 @@ namespace NLogicLib
 			m_UserObjPool.push_back(std::move(user));
 			m_UserObjPoolIndex.push_back(i);
 		}
+
+		// 세션 인덱스는 보통 최대 유저 수 안쪽이다. 여분 세션에서 로그인하면 그때 늘린다.
+		m_UserSessionList.assign(maxUserCount, nullptr);
+		m_UserIDDic.Init(maxUserCount);
 	}
 	
 	User* UserManager::AllocUserObjPoolIndex()
@@ -44,7 +48,14 @@ namespace NLogicLib
 
 	ERROR_CODE UserManager::AddUser(const int sessionIndex, const char* pszID)
 	{
-		if (FindUser(pszID) != nullptr) {
+		// 이미 로그인한 세션이 다시 로그인 요청을 보낸 경우도 막는다.
+		if (sessionIndex < 0 || FindUser(sessionIndex) != nullptr) {
+			return ERROR_CODE::USER_MGR_INVALID_SESSION_INDEX;
+		}
+
+		UserID id(pszID);
+
+		if (FindUser(id) != nullptr) {
 			return ERROR_CODE::USER_MGR_ID_DUPLICATION;
 		}
 
@@ -53,10 +64,15 @@ namespace NLogicLib
 			return ERROR_CODE::USER_MGR_MAX_USER_COUNT;
 		}
 
-		pUser->Set(sessionIndex, pszID);
+		pUser->Set(sessionIndex, id);
 		
-		m_UserSessionDic.insert({ sessionIndex, pUser });
-		m_UserIDDic.insert({ pszID, pUser });
+		if (sessionIndex >= (int)m_UserSessionList.size()) {
+			m_UserSessionList.resize(sessionIndex + 1, nullptr);
+		}
+
+		m_UserSessionList[sessionIndex] = pUser;
+		m_UserIDDic.Insert(pUser->GetID(), pUser);
+		++m_UserCount;
 
 		return ERROR_CODE::NONE;
 	}
@@ -70,10 +86,10 @@ namespace NLogicLib
 		}
 
 		auto index = pUser->GetIndex();
-		auto pszID = pUser->GetID();
 
-		m_UserSessionDic.erase(sessionIndex);
-		m_UserIDDic.erase(pszID.c_str());
+		m_UserSessionList[sessionIndex] = nullptr;
+		m_UserIDDic.Erase(pUser->GetID());
+		--m_UserCount;
 		ReleaseUserObjPoolIndex(index);
 
 		return ERROR_CODE::NONE;
@@ -97,21 +113,15 @@ namespace NLogicLib
 
 	User* UserManager::FindUser(const int sessionIndex)
 	{
-		auto findIter = m_UserSessionDic.find(sessionIndex);
-		if (findIter == m_UserSessionDic.end()) {
+		if (sessionIndex < 0 || sessionIndex >= (int)m_UserSessionList.size()) {
 			return nullptr;
 		}
 		
-		return findIter->second;
+		return m_UserSessionList[sessionIndex];
 	}
 
-	User* UserManager::FindUser(const char* pszID)
+	User* UserManager::FindUser(const UserID& id)
 	{
-		auto findIter = m_UserIDDic.find(pszID);
-		if (findIter == m_UserIDDic.end()) {
-			return nullptr;
-		}
-
-		return findIter->second;
+		return m_UserIDDic.Find(id);
 	}
 }
\ No newline at end of file
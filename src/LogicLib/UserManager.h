@@ -5,6 +5,8 @@
 #include <vector>
 #include <memory>
 
+#include "UserIDMap.h"
+
 namespace NCommon
 {
 	enum class ERROR_CODE :short;
@@ -27,20 +29,24 @@ namespace NLogicLib
 		ERROR_CODE RemoveUser(const int sessionIndex);
 
 		std::tuple<ERROR_CODE,User*> GetUser(const int sessionIndex);
+
+		int GetUserCount() { return m_UserCount; }
+		int MaxUserCount() { return (int)m_UserObjPool.size(); }
 				
 	private:
 		User* AllocUserObjPoolIndex();
 		void ReleaseUserObjPoolIndex(const int index);
 
 		User* FindUser(const int sessionIndex);
-		User* FindUser(const char* pszID);
+		User* FindUser(const UserID& id);
 				
 	private:
 		std::vector<std::unique_ptr<User>> m_UserObjPool;
 		std::deque<int> m_UserObjPoolIndex;
 
-		std::unordered_map<int, User*> m_UserSessionDic;
-		std::unordered_map<const char*, User*> m_UserIDDic; //char* key 
+		std::vector<User*> m_UserSessionList; // ε ٷ ã´
+		int m_UserCount = 0;
+		UserIDMap m_UserIDDic;
 
 	};
 }
\ No newline at end of file
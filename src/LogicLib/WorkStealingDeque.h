@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+namespace NLogicLib
+{
+	// Chase-Lev 작업 훔치기 덱. 주인 스레드만 아래쪽(Bottom)에 넣고 빼며, 다른 스레드는 위쪽(Top)에서 훔친다.
+	// 크기는 고정이다. 꽉 차면 Push 가 false 를 돌려주므로 넣으려던 쪽이 직접 처리한다.
+	template <class T>
+	class WorkStealingDeque
+	{
+	public:
+		void Init(const int capacityLog)
+		{
+			m_Mask = (1LL << capacityLog) - 1;
+			m_Buffer = std::vector<std::atomic<T*>>(m_Mask + 1);
+			m_Top.store(0, std::memory_order_relaxed);
+			m_Bottom.store(0, std::memory_order_relaxed);
+		}
+
+		// 주인 스레드만 부른다.
+		bool Push(T* pItem)
+		{
+			auto bottom = m_Bottom.load(std::memory_order_relaxed);
+			auto top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top > m_Mask) {
+				return false;
+			}
+
+			m_Buffer[bottom & m_Mask].store(pItem, std::memory_order_relaxed);
+			m_Bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		// 주인 스레드만 부른다. 마지막 하나는 훔치는 쪽과 Top 을 두고 다툰다.
+		T* Pop()
+		{
+			auto bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_seq_cst);
+			auto top = m_Top.load(std::memory_order_seq_cst);
+
+			if (top > bottom)
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			auto pItem = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false) {
+					pItem = nullptr;
+				}
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return pItem;
+		}
+
+		// 아무 스레드나 부른다. 다른 스레드와 다투다 지면 비어 있지 않아도 nullptr.
+		T* Steal()
+		{
+			auto top = m_Top.load(std::memory_order_seq_cst);
+			auto bottom = m_Bottom.load(std::memory_order_seq_cst);
+			if (top >= bottom) {
+				return nullptr;
+			}
+
+			auto pItem = m_Buffer[top & m_Mask].load(std::memory_order_relaxed);
+			if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false) {
+				return nullptr;
+			}
+			return pItem;
+		}
+
+		bool IsEmpty()
+		{
+			return m_Top.load(std::memory_order_relaxed) >= m_Bottom.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<int64_t> m_Top{ 0 };
+		std::atomic<int64_t> m_Bottom{ 0 };
+		int64_t m_Mask = 0;
+		std::vector<std::atomic<T*>> m_Buffer;
+	};
+}
@@ -1,4 +1,10 @@
-#pragma once
+﻿#pragma once
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
 
 namespace NLogicLib
 {
@@ -6,4 +12,15 @@ namespace NLogicLib
 	bool IsInBounds(const T& value, const T& low, const T& high) {
 		return (value >= low) && (value < high);
 	}
+
+	// value 는 0 이 아니어야 한다.
+	inline int CountTrailingZero(const uint64_t value) {
+#ifdef _WIN32
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return (int)index;
+#else
+		return __builtin_ctzll(value);
+#endif
+	}
 }
@@ -18,6 +18,8 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 #include <error.h>
 #include <string.h>
@@ -41,6 +43,13 @@ typedef int SOCKET;
 
 namespace NServerNetLib
 {
+	//  ۽ ۿ  Ŷ  send 
+	enum class SEND_FLUSH_MODE : short
+	{
+		SELECT = 0,	//   select   ̶ ˷   
+		TICK = 1,	//  (FlushSend) ̹  Ŷ  Ǹ send   . TCP_NODELAY  Ҵ
+	};
+
 	struct ServerConfig
 	{
 		unsigned short Port;
@@ -60,6 +69,22 @@ namespace NServerNetLib
 		int MaxLobbyUserCount;
 		int MaxRoomCountByLobby;
 		int MaxRoomUserCount;
+
+		int LobbyChatPerSec;		//    κ񿡼 1ʿ   ִ ä . 0 ̸  
+		int LobbyChatBurstCount;	// Ѳ Ƽ   ִ κ ä 
+
+		SEND_FLUSH_MODE SendFlushMode;
+
+		int LogicShardCount;	// κ     . 0 ̸   ϳ  ó
+		int TaskWorkerCount;	//  ۾(, ֱ ˻)  ó ۾  . LogicShardCount   ׸ŭ 
+
+		int RoomTickPerSec;			//    1ʿ   Update 
+		int MaxRoomUpdatePerTick;	// κ񸶴  ƽ Update   . ġ  ƽ ̷. 0 ̸  
+
+		int CompressMinBodySize; //   ǿ  ũ ̻ Body  ؼ . 0 ̸  ʴ´.
+
+		char AdminSocketPath[MAX_PATH]; //  Unix   .    ʴ´.
+		char CaptureFilePath[MAX_PATH]; //  Ŷ  ĸó  .    ʴ´.
 	};
 
 	const int MAX_IP_LEN = 32; // IP ڿ ִ 
@@ -77,6 +102,9 @@ namespace NServerNetLib
 			RemainingDataSize = 0;
 			PrevReadPosInRecvBuffer = 0;
 			SendSize = 0;
+			ReservedBodySize = -1;
+			IsCompress = false;
+			IsSequence = false;
 		}
 
 		int Index = 0;
@@ -90,6 +118,10 @@ namespace NServerNetLib
 
 		char*   pSendBuffer = nullptr;
 		int     SendSize = 0;
+		short   ReservedBodySize = -1; // ReserveSend    Body ũ. -1 ̸  
+		bool    IsSendDirty = false; // ̹  FlushSend   Ͽ  ִ
+		bool    IsCompress = false; // α   ߴ
+		bool    IsSequence = false; // α  û  ߴ
 	};
 
 	struct RecvPacketInfo
@@ -98,6 +130,7 @@ namespace NServerNetLib
 		short PacketId = 0;
 		short PacketBodySize = 0;
 		char* pRefData = 0;
+		int RequestSeq = -1; // Ŭ̾Ʈ  û .  -1
 	};
 
 	enum class SOCKET_CLOSE_CASE : short
@@ -132,6 +165,12 @@ namespace NServerNetLib
 #pragma pack(pop)
 
 	const int PACKET_HEADER_SIZE = sizeof(PacketHeader);
+
+	// PacketHeader::Reserve   ÷
+	const unsigned char PACKET_FLAG_COMPRESSED = 0x01; // Body  LZ4    ִ(LZCodec.h)
+	const unsigned char PACKET_FLAG_SEQUENCE = 0x02; //  ٷ ڿ û  ִ. TotalSize    ʴ´
+
+	const int PACKET_SEQUENCE_SIZE = sizeof(unsigned short);
 }
 
 
@@ -1,9 +1,10 @@
-#ifndef __ITCPNETWORK__
+﻿#ifndef __ITCPNETWORK__
 #define __ITCPNETWORK__
 
 #include "Define.h"
 #include "ServerNetErrorCode.h"
 #include "ILog.h"
+#include "NetStats.h"
 
 namespace NServerNetLib
 {
@@ -17,8 +18,27 @@ namespace NServerNetLib
 
 		virtual NET_ERROR_CODE SendData(const int sessionIndex, const short packetId, 
 										const short size, const char* pMsg) { return NET_ERROR_CODE::NONE; }
+
+		// 세션 송신 버퍼에 헤더와 maxBodySize 만큼 자리를 잡고 Body 를 쓸 위치를 돌려준다. 자리가 없으면 nullptr.
+		// Body 를 다 쓰면 CommitSend 로 실제 크기를 알려 줘야 전송된다. 음수를 넘기면 예약을 취소한다.
+		virtual char* ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize) { return nullptr; }
+		
+		virtual NET_ERROR_CODE CommitSend(const int sessionIndex, const short bodySize) { return NET_ERROR_CODE::NONE; }
+
+		// 이 세션과 압축한 패킷을 주고받는다. 서버 설정에서 압축을 껐으면 false.
+		virtual bool EnableCompress(const int sessionIndex) { return false; }
+
+		// 이 세션이 요청 순번을 붙여 보낼 수 있게 한다. 순번이 붙은 요청을 처리하는 동안 그 요청의 응답 패킷에 같은 순번이 붙는다.
+		// 같은 세션으로 보내는 알림 패킷에는 붙지 않는다.
+		virtual bool EnableSequence(const int sessionIndex) { return false; }
+
+		// 로직이 요청을 처리하기 전에 부른다. 다시 부를 때까지 sessionIndex 로 보내는 replyPacketId 패킷에만 requestSeq 를 붙인다(-1 이면 붙이지 않음).
+		virtual void SetReplySequence(const int sessionIndex, const int requestSeq, const short replyPacketId) {}
 		
 		virtual void Run() {}
+
+		// 로직 처리가 끝난 뒤 루프마다 호출한다. SEND_FLUSH_MODE::TICK 일 때 이번 루프에 쌓인 패킷을 보낸다.
+		virtual void FlushSend() {}
 		
 		virtual RecvPacketInfo GetPacketFromQueue() { return RecvPacketInfo(); }
 
@@ -27,6 +47,8 @@ namespace NServerNetLib
 		virtual int ClientSessionPoolSize() { return 0; }
 
 		virtual void ForcingClose(const int sessionIndex) {}
+
+		virtual NetStats* GetStats() { return nullptr; }
 	};
 }
 
@@ -0,0 +1,225 @@
+﻿#ifndef __LZ_CODEC__
+#define __LZ_CODEC__
+
+#include <stdint.h>
+#include <string.h>
+
+// 패킷 Body 용 LZ 압축. LZ4 블록 형식과 같아서 클라이언트는 LZ4 라이브러리의 블록 함수로 풀어도 된다.
+// 시퀀스 = 토큰(상위 4비트 리터럴 길이, 하위 4비트 매치 길이 - 4), [리터럴 길이 추가 바이트], 리터럴, 오프셋(2바이트), [매치 길이 추가 바이트]
+// 길이가 15 이상이면 255 가 아닌 바이트가 나올 때까지 더한다. 마지막 시퀀스는 리터럴만 있다.
+namespace NServerNetLib
+{
+	const int LZ_MIN_MATCH = 4;
+	const int LZ_LAST_LITERALS = 5;		// 마지막 5 바이트는 항상 리터럴
+	const int LZ_MATCH_FIND_LIMIT = 12;	// 끝에서 12 바이트 안에서는 매치를 시작하지 않는다
+	const int LZ_MAX_OFFSET = 65535;
+	const int LZ_HASH_LOG = 12;
+	const int LZ_MAX_INPUT_SIZE = 65535;	// 해시 테이블에 위치를 uint16_t 로 넣는다
+
+	// 압축 못 하는 데이터라도 이 크기면 충분하다.
+	inline int LZCompressBound(const int srcSize)
+	{
+		return srcSize + srcSize / 255 + 16;
+	}
+
+	inline uint32_t LZRead32(const uint8_t* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t LZHash(const uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - LZ_HASH_LOG);
+	}
+
+	inline bool LZWriteLength(uint8_t*& pOut, const uint8_t* pOutEnd, int length)
+	{
+		while (length >= 255)
+		{
+			if (pOut >= pOutEnd) {
+				return false;
+			}
+			*pOut++ = 255;
+			length -= 255;
+		}
+
+		if (pOut >= pOutEnd) {
+			return false;
+		}
+		*pOut++ = (uint8_t)length;
+		return true;
+	}
+
+	// matchLength 가 0 이면 리터럴만 쓴다(마지막 시퀀스).
+	inline bool LZWriteSequence(uint8_t*& pOut, const uint8_t* pOutEnd, const uint8_t* pLiteral, const int literalLength, const int offset, const int matchLength)
+	{
+		if (pOut >= pOutEnd) {
+			return false;
+		}
+
+		auto pToken = pOut++;
+		auto matchCode = matchLength > 0 ? matchLength - LZ_MIN_MATCH : 0;
+		*pToken = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+		if (literalLength >= 15 && LZWriteLength(pOut, pOutEnd, literalLength - 15) == false) {
+			return false;
+		}
+
+		if (pOutEnd - pOut < literalLength) {
+			return false;
+		}
+		if (literalLength > 0) {
+			memcpy(pOut, pLiteral, literalLength);
+		}
+		pOut += literalLength;
+
+		if (matchLength == 0) {
+			return true;
+		}
+
+		if (pOutEnd - pOut < 2) {
+			return false;
+		}
+		*pOut++ = (uint8_t)(offset & 0xFF);
+		*pOut++ = (uint8_t)(offset >> 8);
+
+		return matchCode < 15 || LZWriteLength(pOut, pOutEnd, matchCode - 15);
+	}
+
+	// 압축한 크기를 돌려준다. destCapacity 안에 다 못 쓰면 0.
+	// 원본보다 작을 때만 쓰려면 destCapacity 를 srcSize - 1 로 주면 된다.
+	inline int LZCompress(const char* pSrc, const int srcSize, char* pDest, const int destCapacity)
+	{
+		if (srcSize < 0 || srcSize > LZ_MAX_INPUT_SIZE) {
+			return 0;
+		}
+
+		uint16_t hashTable[1 << LZ_HASH_LOG];
+		memset(hashTable, 0, sizeof(hashTable));
+
+		auto pIn = (const uint8_t*)pSrc;
+		auto pOut = (uint8_t*)pDest;
+		auto pOutEnd = pOut + destCapacity;
+
+		const int matchLimit = srcSize - LZ_LAST_LITERALS;
+		const int findLimit = srcSize - LZ_MATCH_FIND_LIMIT;
+		int anchor = 0;
+		int pos = 0;
+
+		while (pos < findLimit)
+		{
+			auto sequence = LZRead32(pIn + pos);
+			auto hash = LZHash(sequence);
+			int ref = hashTable[hash];
+			hashTable[hash] = (uint16_t)pos;
+
+			if (ref >= pos || pos - ref > LZ_MAX_OFFSET || LZRead32(pIn + ref) != sequence) {
+				++pos;
+				continue;
+			}
+
+			while (pos > anchor && ref > 0 && pIn[pos - 1] == pIn[ref - 1])
+			{
+				--pos;
+				--ref;
+			}
+
+			auto matchLength = LZ_MIN_MATCH;
+			while (pos + matchLength < matchLimit && pIn[ref + matchLength] == pIn[pos + matchLength]) {
+				++matchLength;
+			}
+
+			if (LZWriteSequence(pOut, pOutEnd, pIn + anchor, pos - anchor, pos - ref, matchLength) == false) {
+				return 0;
+			}
+
+			pos += matchLength;
+			anchor = pos;
+		}
+
+		if (LZWriteSequence(pOut, pOutEnd, pIn + anchor, srcSize - anchor, 0, 0) == false) {
+			return 0;
+		}
+
+		return (int)(pOut - (uint8_t*)pDest);
+	}
+
+	inline bool LZReadLength(const uint8_t*& pIn, const uint8_t* pInEnd, int& length)
+	{
+		uint8_t value = 255;
+		while (value == 255)
+		{
+			if (pIn >= pInEnd) {
+				return false;
+			}
+			value = *pIn++;
+			length += value;
+		}
+		return true;
+	}
+
+	// 푼 크기를 돌려준다. 데이터가 잘못됐거나 destCapacity 를 넘으면 -1.
+	inline int LZDecompress(const char* pSrc, const int srcSize, char* pDest, const int destCapacity)
+	{
+		auto pIn = (const uint8_t*)pSrc;
+		auto pInEnd = pIn + srcSize;
+		auto pOut = (uint8_t*)pDest;
+		auto pOutEnd = pOut + destCapacity;
+
+		while (pIn < pInEnd)
+		{
+			auto token = *pIn++;
+
+			int literalLength = token >> 4;
+			if (literalLength == 15 && LZReadLength(pIn, pInEnd, literalLength) == false) {
+				return -1;
+			}
+
+			if (pInEnd - pIn < literalLength || pOutEnd - pOut < literalLength) {
+				return -1;
+			}
+			if (literalLength > 0) {
+				memcpy(pOut, pIn, literalLength);
+			}
+			pIn += literalLength;
+			pOut += literalLength;
+
+			if (pIn == pInEnd) {
+				break;
+			}
+
+			if (pInEnd - pIn < 2) {
+				return -1;
+			}
+			int offset = pIn[0] | (pIn[1] << 8);
+			pIn += 2;
+
+			if (offset == 0 || offset > pOut - (uint8_t*)pDest) {
+				return -1;
+			}
+
+			int matchLength = token & 0x0F;
+			if (matchLength == 15 && LZReadLength(pIn, pInEnd, matchLength) == false) {
+				return -1;
+			}
+			matchLength += LZ_MIN_MATCH;
+
+			if (pOutEnd - pOut < matchLength) {
+				return -1;
+			}
+
+			// 오프셋이 매치 길이보다 짧으면 방금 쓴 바이트를 다시 읽으므로 한 바이트씩 복사한다.
+			auto pMatch = pOut - offset;
+			for (int i = 0; i < matchLength; ++i) {
+				pOut[i] = pMatch[i];
+			}
+			pOut += matchLength;
+		}
+
+		return (int)(pOut - (uint8_t*)pDest);
+	}
+}
+
+#endif
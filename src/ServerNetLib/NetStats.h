@@ -0,0 +1,35 @@
+﻿#ifndef __NET_STATS__
+#define __NET_STATS__
+
+#include <atomic>
+#include <stdint.h>
+
+namespace NServerNetLib
+{
+	// 네트워크 스레드가 갱신하고 다른 스레드(관리용 소켓 등)는 읽기만 하는 통계 값.
+	// 락 없이 읽을 수 있도록 모두 atomic(relaxed)으로 다룬다.
+	struct NetStats
+	{
+		void AddCount(std::atomic<int64_t>& counter, const int64_t value = 1)
+		{
+			counter.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		std::atomic<int64_t> AcceptCount{ 0 };
+		std::atomic<int64_t> CloseCount{ 0 };
+		std::atomic<int64_t> RecvBytes{ 0 };
+		std::atomic<int64_t> SendBytes{ 0 };
+		std::atomic<int64_t> RecvPacketCount{ 0 };
+		std::atomic<int64_t> SendPacketCount{ 0 };
+		std::atomic<int64_t> SendCallCount{ 0 };	// 실제로 데이터를 보낸 send 호출 수
+		std::atomic<int64_t> SendBufferFullCount{ 0 };
+		std::atomic<int64_t> CompressedSendCount{ 0 };
+		std::atomic<int64_t> CompressSavedBytes{ 0 };	// 압축으로 줄인 송신 바이트 수
+
+		std::atomic<int> SessionPoolSize{ 0 };
+		std::atomic<int> ConnectedSessionCount{ 0 };
+		std::atomic<int> PacketQueueDepth{ 0 };
+	};
+}
+
+#endif
@@ -0,0 +1,165 @@
+﻿#include <string.h>
+#include <stddef.h>
+
+#include "PacketCapture.h"
+
+namespace NServerNetLib
+{
+	// 버퍼가 이 크기를 넘으면 파일에 쓴다.
+	const size_t CAPTURE_FLUSH_SIZE = 64 * 1024;
+
+	namespace
+	{
+		FILE* OpenFile(const char* pFilePath, const char* pMode)
+		{
+#ifdef _WIN32
+			FILE* pFile = nullptr;
+			fopen_s(&pFile, pFilePath, pMode);
+			return pFile;
+#else
+			return fopen(pFilePath, pMode);
+#endif
+		}
+	}
+
+	bool PacketCapture::Open(const char* pFilePath)
+	{
+		Close();
+
+		m_pFile = OpenFile(pFilePath, "wb");
+		if (m_pFile == nullptr) {
+			return false;
+		}
+
+		m_Buffer.reserve(CAPTURE_FLUSH_SIZE * 2);
+		m_LatestRecordTime = std::chrono::steady_clock::now();
+		m_RecordCount = 0;
+
+		CaptureFileHeader fileHeader;
+		fileHeader.Magic = CAPTURE_FILE_MAGIC;
+		fileHeader.Version = CAPTURE_FILE_VERSION;
+		fileHeader.HeaderSize = (uint16_t)sizeof(CaptureFileHeader);
+		fileHeader.StartTimeMicroSec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+		fwrite(&fileHeader, sizeof(fileHeader), 1, m_pFile);
+		return true;
+	}
+
+	void PacketCapture::Close()
+	{
+		if (m_pFile == nullptr) {
+			return;
+		}
+
+		Flush();
+		fclose(m_pFile);
+		m_pFile = nullptr;
+	}
+
+	void PacketCapture::Write(const int sessionIndex, const short packetId, const short bodySize, const char* pBody, const int requestSeq)
+	{
+		if (m_pFile == nullptr) {
+			return;
+		}
+
+		auto curTime = std::chrono::steady_clock::now();
+		auto delta = std::chrono::duration_cast<std::chrono::microseconds>(curTime - m_LatestRecordTime).count();
+		m_LatestRecordTime = curTime;
+
+		CaptureRecordHeader recordHeader;
+		recordHeader.TimeDeltaMicroSec = delta > UINT32_MAX ? UINT32_MAX : (uint32_t)delta;
+		recordHeader.SessionIndex = (uint16_t)sessionIndex;
+		recordHeader.PacketId = packetId;
+		recordHeader.BodySize = bodySize > 0 ? (uint16_t)bodySize : 0;
+		recordHeader.RequestSeq = requestSeq;
+
+		auto pos = m_Buffer.size();
+		m_Buffer.resize(pos + sizeof(recordHeader) + recordHeader.BodySize);
+		memcpy(&m_Buffer[pos], &recordHeader, sizeof(recordHeader));
+		if (recordHeader.BodySize > 0) {
+			memcpy(&m_Buffer[pos + sizeof(recordHeader)], pBody, recordHeader.BodySize);
+		}
+
+		++m_RecordCount;
+
+		if (m_Buffer.size() >= CAPTURE_FLUSH_SIZE) {
+			Flush();
+		}
+	}
+
+	void PacketCapture::Flush()
+	{
+		if (m_pFile == nullptr || m_Buffer.empty()) {
+			return;
+		}
+
+		fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_pFile);
+		fflush(m_pFile);
+		m_Buffer.clear();
+	}
+
+
+	bool PacketCaptureReader::Load(const char* pFilePath)
+	{
+		auto pFile = OpenFile(pFilePath, "rb");
+		if (pFile == nullptr) {
+			return false;
+		}
+
+		fseek(pFile, 0, SEEK_END);
+		auto fileSize = ftell(pFile);
+		fseek(pFile, 0, SEEK_SET);
+
+		m_Data.resize(fileSize > 0 ? (size_t)fileSize : 0);
+		auto readSize = m_Data.empty() ? 0 : fread(m_Data.data(), 1, m_Data.size(), pFile);
+		fclose(pFile);
+
+		if (readSize != m_Data.size() || m_Data.size() < sizeof(CaptureFileHeader)) {
+			return false;
+		}
+
+		memcpy(&m_FileHeader, m_Data.data(), sizeof(CaptureFileHeader));
+		if (m_FileHeader.Magic != CAPTURE_FILE_MAGIC || m_FileHeader.Version < 1 || m_FileHeader.Version > CAPTURE_FILE_VERSION || m_FileHeader.HeaderSize > m_Data.size()) {
+			return false;
+		}
+
+		// 버전 1 레코드에는 RequestSeq 가 없다.
+		m_RecordHeaderSize = m_FileHeader.Version == 1 ? offsetof(CaptureRecordHeader, RequestSeq) : sizeof(CaptureRecordHeader);
+
+		Rewind();
+		return true;
+	}
+
+	void PacketCaptureReader::Rewind()
+	{
+		m_ReadPos = m_FileHeader.HeaderSize;
+		m_CurTimeMicroSec = 0;
+	}
+
+	bool PacketCaptureReader::Next(Record& record)
+	{
+		// 서버가 기록 중에 죽었으면 마지막 레코드가 잘려 있을 수 있다. 잘린 레코드는 버린다.
+		if (m_ReadPos + m_RecordHeaderSize > m_Data.size()) {
+			return false;
+		}
+
+		CaptureRecordHeader recordHeader;
+		recordHeader.RequestSeq = -1;
+		memcpy(&recordHeader, &m_Data[m_ReadPos], m_RecordHeaderSize);
+		if (m_ReadPos + m_RecordHeaderSize + recordHeader.BodySize > m_Data.size()) {
+			return false;
+		}
+
+		m_CurTimeMicroSec += recordHeader.TimeDeltaMicroSec;
+
+		record.TimeMicroSec = m_CurTimeMicroSec;
+		record.SessionIndex = recordHeader.SessionIndex;
+		record.PacketId = recordHeader.PacketId;
+		record.BodySize = (short)recordHeader.BodySize;
+		record.RequestSeq = recordHeader.RequestSeq;
+		record.pBody = recordHeader.BodySize > 0 ? &m_Data[m_ReadPos + m_RecordHeaderSize] : nullptr;
+
+		m_ReadPos += m_RecordHeaderSize + recordHeader.BodySize;
+		return true;
+	}
+}
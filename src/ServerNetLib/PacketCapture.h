@@ -0,0 +1,90 @@
+﻿#ifndef __PACKET_CAPTURE__
+#define __PACKET_CAPTURE__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <chrono>
+
+namespace NServerNetLib
+{
+	/*
+	받은 패킷과 접속/종료 이벤트를 그대로 파일에 이어 붙여 기록한다. 리플레이 도구가 읽어서 로직에 다시 넣는다.
+	파일 = CaptureFileHeader + (CaptureRecordHeader + 보디) 반복
+	접속/종료는 NTF_SYS_CONNECT_SESSION / NTF_SYS_CLOSE_SESSION 패킷으로 기록된다.
+	버전 2 부터 레코드에 요청 순번이 붙는다. 버전 1 파일도 읽을 수 있고 그때 순번은 -1 이다.
+	*/
+	const uint32_t CAPTURE_FILE_MAGIC = 0x50435353; // "SSCP"
+	const uint16_t CAPTURE_FILE_VERSION = 2;
+
+#pragma pack(push, 1)
+	struct CaptureFileHeader
+	{
+		uint32_t Magic;
+		uint16_t Version;
+		uint16_t HeaderSize;
+		int64_t StartTimeMicroSec; // 기록을 시작한 시각 (UTC, epoch 기준)
+	};
+
+	struct CaptureRecordHeader
+	{
+		uint32_t TimeDeltaMicroSec; // 바로 앞 레코드와의 시간 차
+		uint16_t SessionIndex;
+		int16_t PacketId;
+		uint16_t BodySize;
+		int32_t RequestSeq; // 요청 순번. 없으면 -1. 버전 1 에는 없다
+	};
+#pragma pack(pop)
+
+	class PacketCapture
+	{
+	public:
+		PacketCapture() {}
+		~PacketCapture() { Close(); }
+
+		bool Open(const char* pFilePath);
+		void Close();
+		bool IsOpen() { return m_pFile != nullptr; }
+
+		void Write(const int sessionIndex, const short packetId, const short bodySize, const char* pBody, const int requestSeq);
+		void Flush();
+
+		int64_t RecordCount() { return m_RecordCount; }
+
+	private:
+		FILE* m_pFile = nullptr;
+		std::vector<char> m_Buffer;
+		std::chrono::steady_clock::time_point m_LatestRecordTime;
+		int64_t m_RecordCount = 0;
+	};
+
+	// 캡처 파일 전체를 메모리에 올려서 앞에서부터 레코드를 하나씩 꺼낸다.
+	class PacketCaptureReader
+	{
+	public:
+		struct Record
+		{
+			int64_t TimeMicroSec = 0; // 기록 시작부터의 시간
+			int SessionIndex = 0;
+			short PacketId = 0;
+			short BodySize = 0;
+			int RequestSeq = -1;
+			char* pBody = nullptr;
+		};
+
+		bool Load(const char* pFilePath);
+		void Rewind();
+		bool Next(Record& record);
+
+		const CaptureFileHeader& GetFileHeader() { return m_FileHeader; }
+
+	private:
+		CaptureFileHeader m_FileHeader;
+		size_t m_RecordHeaderSize = sizeof(CaptureRecordHeader);
+		std::vector<char> m_Data;
+		size_t m_ReadPos = 0;
+		int64_t m_CurTimeMicroSec = 0;
+	};
+}
+
+#endif
@@ -18,6 +18,8 @@ namespace NServerNetLib
 		SEND_SIZE_ZERO = 22,
 		CLIENT_SEND_BUFFER_FULL = 23,
 		CLIENT_FLUSH_SEND_BUFF_REMOTE_CLOSE = 24,
+		CLIENT_SEND_NOT_RESERVED = 25,
+		CLIENT_SEND_RESERVE_SIZE_OVER = 29,
 		
 		ACCEPT_API_ERROR = 26,
 		ACCEPT_MAX_SESSION_COUNT = 27,
@@ -28,6 +30,8 @@ namespace NServerNetLib
 		RECV_REMOTE_CLOSE = 33,
 		RECV_PROCESS_NOT_CONNECTED = 34,
 		RECV_CLIENT_MAX_PACKET = 35,
+		RECV_DECOMPRESS_FAIL = 36,
+		RECV_INVALID_SEQUENCE = 37,
 	};
 
 
@@ -3,11 +3,14 @@
 #include <deque>
 
 #include "ILog.h"
+#include "LZCodec.h"
 #include "TcpNetwork.h"
 
 
 namespace NServerNetLib
 {
+	const int DECOMPRESS_CHUNK_SIZE = 64 * 1024;
+
 	TcpNetwork::TcpNetwork() {}
 	
 	TcpNetwork::~TcpNetwork() 
@@ -36,14 +39,33 @@ namespace NServerNetLib
 		FD_SET(m_ServerSockfd, &m_Readfds);
 		
 		auto sessionPoolSize = CreateSessionPool(pConfig->MaxClientCount + pConfig->ExtraClientCount);
+		m_Stats.SessionPoolSize.store(sessionPoolSize, std::memory_order_relaxed);
 			
 		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | Session Pool Size: %d", __FUNCTION__, sessionPoolSize);
 
+		if (m_Config.CompressMinBodySize > 0)
+		{
+			m_CompressBuffer.resize(m_Config.MaxClientSendBufferSize);
+			m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | Compress Min Body Size: %d", __FUNCTION__, m_Config.CompressMinBodySize);
+		}
+
+		if (m_Config.CaptureFilePath[0] != '\0')
+		{
+			if (m_Capture.Open(m_Config.CaptureFilePath)) {
+				m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | Packet Capture: %s", __FUNCTION__, m_Config.CaptureFilePath);
+			}
+			else {
+				m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | Packet Capture Open Fail: %s", __FUNCTION__, m_Config.CaptureFilePath);
+			}
+		}
+
 		return NET_ERROR_CODE::NONE;
 	}
 
 	void TcpNetwork::Release()
 	{
+		m_Capture.Close();
+
 		CloseSocket(m_ServerSockfd);
 		for (auto& client : m_ClientSessionPool)
 		{
@@ -73,9 +95,19 @@ namespace NServerNetLib
 			packetInfo = m_PacketQueue.front();
 			m_PacketQueue.pop_front();
 		}
+
+		// 응답 순번은 로직이 요청을 처리하기 전에 SetReplySequence 로 정한다. 그 전까지는 붙이지 않는다.
+		SetReplySequence(-1, -1, 0);
 				
 		return packetInfo;
 	}
+
+	void TcpNetwork::SetReplySequence(const int sessionIndex, const int requestSeq, const short replyPacketId)
+	{
+		m_ReplySessionIndex = requestSeq >= 0 ? sessionIndex : -1;
+		m_ReplySeq = requestSeq;
+		m_ReplyPacketId = replyPacketId;
+	}
 		
 	void TcpNetwork::ForcingClose(const int sessionIndex)
 	{
@@ -101,6 +133,13 @@ namespace NServerNetLib
 		//연결된 모든 세션을 write 이벤트를 조사하고 있는데 사실 다 할 필요는 없다. 이전에 send 버퍼가 다 찼던 세션만 조사해도 된다.
 		auto read_set = m_Readfds;
 		auto write_set = m_Readfds;
+
+		// 이전 루프에서 받은 패킷은 다 처리했으므로 압축을 푼 Body 를 담던 곳을 처음부터 다시 쓴다.
+		if (m_PacketQueue.empty())
+		{
+			m_DecompressChunkIndex = 0;
+			m_DecompressChunkPos = 0;
+		}
 		
 		timeval timeout{ 0, 1000 }; //tv_sec, tv_usec
 #ifdef _WIN32
@@ -122,6 +161,8 @@ namespace NServerNetLib
 		}
 		
 		RunCheckSelectClients(read_set, write_set);
+
+		m_Stats.PacketQueueDepth.store((int)m_PacketQueue.size(), std::memory_order_relaxed);
 	}
 
 	bool TcpNetwork::CheckSelectResultError(const int result)
@@ -203,29 +244,194 @@ namespace NServerNetLib
 	패킷을 복제하여 대상 세션의 쓰기버퍼에 담는다.
 	*/
 	NET_ERROR_CODE TcpNetwork::SendData(const int sessionIndex, const short packetId, const short bodySize, const char* pMsg)
+	{
+		auto pBody = ReserveSend(sessionIndex, packetId, bodySize);
+		if (pBody == nullptr) {
+			return NET_ERROR_CODE::CLIENT_SEND_BUFFER_FULL;
+		}
+
+		if (bodySize > 0)
+		{
+			memcpy(pBody, pMsg, bodySize);
+		}
+
+		return CommitSend(sessionIndex, bodySize);
+	}
+
+	/*
+	쓰기버퍼 끝에 헤더를 먼저 써 두고 Body 위치를 돌려준다. SendSize 는 CommitSend 에서 늘린다.
+	처리 중인 요청에 순번이 있고 그 요청의 응답 패킷이면 헤더 뒤에 순번을 붙인다.
+	*/
+	char* TcpNetwork::ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize)
 	{
 		auto& session = m_ClientSessionPool[sessionIndex];
 
-		auto pos = session.SendSize;
-		auto totalSize = (int16_t)(bodySize + PACKET_HEADER_SIZE);
+		auto isReply = sessionIndex == m_ReplySessionIndex && packetId == m_ReplyPacketId;
+		auto headerSize = PACKET_HEADER_SIZE + (isReply ? PACKET_SEQUENCE_SIZE : 0);
+		auto totalSize = maxBodySize + headerSize;
 
-		if ((pos + totalSize) > m_Config.MaxClientSendBufferSize ) {
-			return NET_ERROR_CODE::CLIENT_SEND_BUFFER_FULL;
+		// 요청을 몰아서 받으면 한 루프에 응답이 쌓여 버퍼가 찰 수 있다. 그때는 지금까지 쌓인 것을 먼저 보내 본다.
+		if (maxBodySize >= 0 && (session.SendSize + totalSize) > m_Config.MaxClientSendBufferSize && session.SendSize > 0)
+		{
+			auto resultSend = FlushSendBuff(sessionIndex);
+			if (resultSend.Error != NET_ERROR_CODE::NONE)
+			{
+				m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | send error %d", __FUNCTION__, resultSend.Value);
+				CloseSession(SOCKET_CLOSE_CASE::SOCKET_SEND_ERROR, session.SocketFD, sessionIndex);
+				return nullptr;
+			}
 		}
-				
-		PacketHeader pktHeader{ totalSize, packetId, (uint8_t)0 };
+
+		auto pos = session.SendSize;
+		if (maxBodySize < 0 || (pos + totalSize) > m_Config.MaxClientSendBufferSize) {
+			m_Stats.AddCount(m_Stats.SendBufferFullCount);
+			return nullptr;
+		}
+
+		PacketHeader pktHeader{ (int16_t)totalSize, packetId, (uint8_t)(isReply ? PACKET_FLAG_SEQUENCE : 0) };
 		memcpy(&session.pSendBuffer[pos], (char*)&pktHeader, PACKET_HEADER_SIZE);
 
-		if (bodySize > 0)
+		if (isReply)
 		{
-			memcpy(&session.pSendBuffer[pos + PACKET_HEADER_SIZE], pMsg, bodySize);
+			auto seq = (uint16_t)m_ReplySeq;
+			memcpy(&session.pSendBuffer[pos + PACKET_HEADER_SIZE], &seq, PACKET_SEQUENCE_SIZE);
+		}
+
+		session.ReservedBodySize = maxBodySize;
+		return &session.pSendBuffer[pos + headerSize];
+	}
+
+	/*
+	예약한 패킷의 헤더 크기를 실제 Body 크기로 고치고 쓰기버퍼에 확정한다.
+	*/
+	NET_ERROR_CODE TcpNetwork::CommitSend(const int sessionIndex, const short bodySize)
+	{
+		auto& session = m_ClientSessionPool[sessionIndex];
+
+		auto reservedBodySize = session.ReservedBodySize;
+		session.ReservedBodySize = -1;
+
+		if (reservedBodySize < 0) {
+			return NET_ERROR_CODE::CLIENT_SEND_NOT_RESERVED;
+		}
+
+		if (bodySize < 0) {
+			return NET_ERROR_CODE::NONE;
 		}
 
+		if (bodySize > reservedBodySize) {
+			return NET_ERROR_CODE::CLIENT_SEND_RESERVE_SIZE_OVER;
+		}
+
+		auto pos = session.SendSize;
+		auto pHeader = (PacketHeader*)&session.pSendBuffer[pos];
+		auto headerSize = PACKET_HEADER_SIZE + ((pHeader->Reserve & PACKET_FLAG_SEQUENCE) ? PACKET_SEQUENCE_SIZE : 0);
+		auto sendBodySize = bodySize;
+		if (session.IsCompress && bodySize >= m_Config.CompressMinBodySize) {
+			sendBodySize = CompressSendBody(pHeader, &session.pSendBuffer[pos + headerSize], bodySize);
+		}
+
+		auto totalSize = (int16_t)(sendBodySize + headerSize);
+		memcpy(&session.pSendBuffer[pos], (char*)&totalSize, sizeof(totalSize));
+
 		session.SendSize += totalSize;
+		m_Stats.AddCount(m_Stats.SendPacketCount);
+
+		if (m_Config.SendFlushMode == SEND_FLUSH_MODE::TICK && session.IsSendDirty == false)
+		{
+			session.IsSendDirty = true;
+			m_SendDirtySessionIndexList.push_back(sessionIndex);
+		}
 
 		return NET_ERROR_CODE::NONE;
 	}
 
+	bool TcpNetwork::EnableCompress(const int sessionIndex)
+	{
+		if (m_Config.CompressMinBodySize <= 0) {
+			return false;
+		}
+
+		m_ClientSessionPool[sessionIndex].IsCompress = true;
+		return true;
+	}
+
+	bool TcpNetwork::EnableSequence(const int sessionIndex)
+	{
+		m_ClientSessionPool[sessionIndex].IsSequence = true;
+		return true;
+	}
+
+	/*
+	Body 를 압축해서 줄어들 때만 그 자리에 덮어쓰고 헤더에 압축 플래그를 켠다. 보낼 Body 크기를 돌려준다.
+	*/
+	short TcpNetwork::CompressSendBody(PacketHeader* pHeader, char* pBody, const short bodySize)
+	{
+		auto compressSize = LZCompress(pBody, bodySize, &m_CompressBuffer[0], bodySize - 1);
+		if (compressSize <= 0) {
+			return bodySize;
+		}
+
+		memcpy(pBody, &m_CompressBuffer[0], compressSize);
+		pHeader->Reserve |= PACKET_FLAG_COMPRESSED;
+
+		m_Stats.AddCount(m_Stats.CompressedSendCount);
+		m_Stats.AddCount(m_Stats.CompressSavedBytes, bodySize - compressSize);
+		return (short)compressSize;
+	}
+
+	/*
+	받은 Body 의 압축을 풀어서 패킷 큐가 빌 때까지 남아 있는 곳에 담는다. 잘못된 데이터면 nullptr.
+	*/
+	char* TcpNetwork::DecompressRecvBody(const char* pBody, short& bodySize)
+	{
+		if (m_DecompressChunkPos + MAX_PACKET_BODY_SIZE > DECOMPRESS_CHUNK_SIZE)
+		{
+			++m_DecompressChunkIndex;
+			m_DecompressChunkPos = 0;
+		}
+
+		if (m_DecompressChunkIndex == (int)m_DecompressChunkList.size()) {
+			m_DecompressChunkList.emplace_back(DECOMPRESS_CHUNK_SIZE);
+		}
+
+		auto pDest = &m_DecompressChunkList[m_DecompressChunkIndex][m_DecompressChunkPos];
+		auto size = LZDecompress(pBody, bodySize, pDest, MAX_PACKET_BODY_SIZE);
+		if (size < 0) {
+			return nullptr;
+		}
+
+		m_DecompressChunkPos += size;
+		bodySize = (short)size;
+		return pDest;
+	}
+
+	/*
+	이번 루프에 패킷이 쌓인 세션만 send 한 번으로 모아서 보낸다.
+	다 못 보낸 나머지는 다음 Run 에서 select 가 쓰기 가능이라고 알려 줄 때 보낸다.
+	*/
+	void TcpNetwork::FlushSend()
+	{
+		for (auto sessionIndex : m_SendDirtySessionIndexList)
+		{
+			auto& session = m_ClientSessionPool[sessionIndex];
+			session.IsSendDirty = false;
+
+			if (session.IsConnected() == false || session.SendSize == 0) {
+				continue;
+			}
+
+			auto resultSend = FlushSendBuff(sessionIndex);
+			if (resultSend.Error != NET_ERROR_CODE::NONE)
+			{
+				m_pRefLogger->Write(LOG_TYPE::L_ERROR, "%s | send error %d", __FUNCTION__, resultSend.Value);
+				CloseSession(SOCKET_CLOSE_CASE::SOCKET_SEND_ERROR, session.SocketFD, sessionIndex);
+			}
+		}
+
+		m_SendDirtySessionIndexList.clear();
+	}
+
 	int TcpNetwork::CreateSessionPool(const int maxClientCount)
 	{
 		for (int i = 0; i < maxClientCount; ++i)
@@ -233,6 +439,7 @@ namespace NServerNetLib
 			ClientSession session;
 			ZeroMemory(&session, sizeof(session));
 			session.Index = i;
+			session.ReservedBodySize = -1;
 			session.pRecvBuffer = new char[m_Config.MaxClientRecvBufferSize]();
 			session.pSendBuffer = new char[m_Config.MaxClientSendBufferSize]();
 			
@@ -240,6 +447,8 @@ namespace NServerNetLib
 			m_ClientSessionPoolIndex.push_back(session.Index);			
 		}
 
+		m_SendDirtySessionIndexList.reserve(maxClientCount);
+
 		return maxClientCount;
 	}
 
@@ -384,6 +593,8 @@ namespace NServerNetLib
 		memcpy(session.IP, pIP, MAX_IP_LEN - 1);
 
 		++m_ConnectedSessionCount;
+		m_Stats.AddCount(m_Stats.AcceptCount);
+		m_Stats.ConnectedSessionCount.store((int)m_ConnectedSessionCount, std::memory_order_relaxed);
 
 		AddPacketQueue(sessionIndex, (short)PACKET_ID::NTF_SYS_CONNECT_SESSION, 0, nullptr);
 		m_pRefLogger->Write(LOG_TYPE::L_INFO, "%s | New Session. FD(%I64u), m_ConnectSeq(%d), IP(%s)", __FUNCTION__, fd, m_ConnectSeq, pIP);
@@ -400,6 +611,13 @@ namespace NServerNetLib
 		int size2 = m_Config.MaxClientSockOptSendBufferSize;
 		setsockopt(fd, SOL_SOCKET, SO_RCVBUF, (char*)&size1, sizeof(size1));
 		setsockopt(fd, SOL_SOCKET, SO_SNDBUF, (char*)&size2, sizeof(size2));
+
+		// 루프 끝에 세션마다 모아서 보내므로 Nagle 로 더 기다릴 필요가 없다.
+		if (m_Config.SendFlushMode == SEND_FLUSH_MODE::TICK)
+		{
+			int noDelay = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char*)&noDelay, sizeof(noDelay));
+		}
 	}
 
 	/*
@@ -424,6 +642,8 @@ namespace NServerNetLib
 		m_ClientSessionPool[sessionIndex].Clear();
 		--m_ConnectedSessionCount;
 		ReleaseSessionIndex(sessionIndex);
+		m_Stats.AddCount(m_Stats.CloseCount);
+		m_Stats.ConnectedSessionCount.store((int)m_ConnectedSessionCount, std::memory_order_relaxed);
 
 		AddPacketQueue(sessionIndex, (short)PACKET_ID::NTF_SYS_CLOSE_SESSION, 0, nullptr);
 	}
@@ -447,9 +667,9 @@ namespace NServerNetLib
 			recvPos += session.RemainingDataSize;
 		}
 
-		//질문:왜 (MAX_PACKET_BODY_SIZE * 2) 하는걸까?
+		// 버퍼에 남은 만큼 한 번에 받는다. 클라이언트가 요청을 몰아서 보내도 한 루프에 다 꺼내서 이어서 처리한다.
 		auto fd = static_cast<SOCKET>(session.SocketFD);
-		auto recvSize = recv(fd, &session.pRecvBuffer[recvPos], (MAX_PACKET_BODY_SIZE * 2), 0);
+		auto recvSize = recv(fd, &session.pRecvBuffer[recvPos], m_Config.MaxClientRecvBufferSize - recvPos, 0);
 		if (recvSize == 0)
 		{
 			return NET_ERROR_CODE::RECV_REMOTE_CLOSE;
@@ -469,6 +689,7 @@ namespace NServerNetLib
 		}
 
 		session.RemainingDataSize += (int)recvSize;
+		m_Stats.AddCount(m_Stats.RecvBytes, recvSize);
 		return NET_ERROR_CODE::NONE;
 	}
 
@@ -493,23 +714,55 @@ namespace NServerNetLib
 			auto bodySize = (int16_t)(pPktHeader->TotalSize - PACKET_HEADER_SIZE);
 			if (bodySize > 0)
 			{
-				//헤더는 읽었지만 body를 읽기에 모자란 경우
-				if (bodySize > curRemainDataSize)
+				//최대 패킷 사이즈보다 큰 경우, 뭔가 설계에 문제가 있거나 오류. 요청 순번은 Body 크기에 넣지 않는다.
+				//다 받을 때까지 기다리면 받기 버퍼를 넘으므로 먼저 검사한다.
+				auto maxBodySize = MAX_PACKET_BODY_SIZE + ((pPktHeader->Reserve & PACKET_FLAG_SEQUENCE) ? PACKET_SEQUENCE_SIZE : 0);
+				if (bodySize > maxBodySize)
 				{
-					readPos -= PACKET_HEADER_SIZE;
-					break;
+					// 더 이상 이 세션과는 작업을 하지 않을 예정. 클라이언트 보고 나가라고 하던가 직접 짤라야 한다.
+					return NET_ERROR_CODE::RECV_CLIENT_MAX_PACKET;
 				}
 
-				//최대 패킷 사이즈보다 큰 경우, 뭔가 설계에 문제가 있거나 오류
-				if (bodySize > MAX_PACKET_BODY_SIZE)
+				//헤더는 읽었지만 body를 읽기에 모자란 경우. curRemainDataSize 에는 방금 읽은 헤더 크기도 들어 있다.
+				if (bodySize > curRemainDataSize - PACKET_HEADER_SIZE)
 				{
-					// 더 이상 이 세션과는 작업을 하지 않을 예정. 클라이언트 보고 나가라고 하던가 직접 짤라야 한다.
-					return NET_ERROR_CODE::RECV_CLIENT_MAX_PACKET;
+					readPos -= PACKET_HEADER_SIZE;
+					break;
 				}
 			}
 
-			AddPacketQueue(sessionIndex, pPktHeader->Id, bodySize, &session.pRecvBuffer[readPos]);
+			auto pBody = &session.pRecvBuffer[readPos];
 			readPos += bodySize;
+
+			auto requestSeq = -1;
+			if (pPktHeader->Reserve & PACKET_FLAG_SEQUENCE)
+			{
+				if (session.IsSequence == false || bodySize < PACKET_SEQUENCE_SIZE) {
+					return NET_ERROR_CODE::RECV_INVALID_SEQUENCE;
+				}
+
+				uint16_t seq;
+				memcpy(&seq, pBody, PACKET_SEQUENCE_SIZE);
+				requestSeq = seq;
+				pBody += PACKET_SEQUENCE_SIZE;
+				bodySize -= PACKET_SEQUENCE_SIZE;
+			}
+
+			if (pPktHeader->Reserve & PACKET_FLAG_COMPRESSED)
+			{
+				// 압축을 약속하지 않은 세션이 보냈거나 풀 수 없으면 더 이상 이 세션의 데이터를 믿을 수 없다.
+				if (session.IsCompress == false) {
+					return NET_ERROR_CODE::RECV_DECOMPRESS_FAIL;
+				}
+
+				pBody = DecompressRecvBody(pBody, bodySize);
+				if (pBody == nullptr) {
+					return NET_ERROR_CODE::RECV_DECOMPRESS_FAIL;
+				}
+			}
+
+			AddPacketQueue(sessionIndex, pPktHeader->Id, bodySize, pBody, requestSeq);
+			m_Stats.AddCount(m_Stats.RecvPacketCount);
 			curRemainDataSize = (dataSize - readPos);
 		}
 		
@@ -519,15 +772,20 @@ namespace NServerNetLib
 		return NET_ERROR_CODE::NONE;
 	}
 
-	void TcpNetwork::AddPacketQueue(const int sessionIndex, const short pktId, const short bodySize, char* pDataPos)
+	void TcpNetwork::AddPacketQueue(const int sessionIndex, const short pktId, const short bodySize, char* pDataPos, const int requestSeq)
 	{
 		RecvPacketInfo packetInfo;
 		packetInfo.SessionIndex = sessionIndex;
 		packetInfo.PacketId = pktId;
 		packetInfo.PacketBodySize = bodySize;
 		packetInfo.pRefData = pDataPos;
+		packetInfo.RequestSeq = requestSeq;
 
 		m_PacketQueue.push_back(packetInfo);
+
+		if (m_Capture.IsOpen()) {
+			m_Capture.Write(sessionIndex, pktId, bodySize, pDataPos, requestSeq);
+		}
 	}
 
 	void TcpNetwork::RunProcessWrite(const int sessionIndex, const SOCKET fd, fd_set& write_set)
@@ -566,6 +824,12 @@ namespace NServerNetLib
 		//보낼 데이타가 남았는지 검사 후 처리.
 		//session.SendSize에는 최초에 Total Send Size가 담긴다.
 		auto sendSize = result.Value;
+		if (sendSize == 0) {
+			return result;
+		}
+
+		m_Stats.AddCount(m_Stats.SendBytes, sendSize);
+		m_Stats.AddCount(m_Stats.SendCallCount);
 		if (sendSize < session.SendSize)
 		{
 			memmove(&session.pSendBuffer[0],
@@ -594,9 +858,20 @@ namespace NServerNetLib
 			return result;
 		}
 
+		// 소켓 송신 버퍼가 차 있으면 기다리지 않고 0 을 돌려준다. 끊긴 소켓에 보내도 SIGPIPE 로 죽지 않게 한다.
+#ifdef _WIN32
+		const int flags = 0;
+#else
+		const int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#endif
+
 		//send가 size를 리턴하지만 동시에 실패할때는 에러코드 리턴
-		result.Value = (int)send(fd, pMsg, size, 0);
-		if (result.Value <= 0)
+		result.Value = (int)send(fd, pMsg, size, flags);
+		if (result.Value < 0 && IsWouldBlocked())
+		{
+			result.Value = 0;
+		}
+		else if (result.Value <= 0)
 		{
 			result.Error = NET_ERROR_CODE::SEND_SIZE_ZERO;
 		}
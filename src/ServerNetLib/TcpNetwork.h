@@ -1,4 +1,4 @@
-#ifndef __TCPNETWORK__
+﻿#ifndef __TCPNETWORK__
 #define __TCPNETWORK__
 
 #include <vector>
@@ -7,6 +7,7 @@
 //#include "ServerNetErrorCode.h"
 //#include "Define.h"
 #include "ITcpNetwork.h"
+#include "PacketCapture.h"
 
 
 namespace NServerNetLib
@@ -22,8 +23,20 @@ namespace NServerNetLib
 		NET_ERROR_CODE Init(const ServerConfig* pConfig, ILog* pLogger) override;
 		
 		NET_ERROR_CODE SendData(const int sessionIndex, const short packetId, const short size, const char* pMsg) override;
+
+		char* ReserveSend(const int sessionIndex, const short packetId, const short maxBodySize) override;
+
+		NET_ERROR_CODE CommitSend(const int sessionIndex, const short bodySize) override;
+
+		bool EnableCompress(const int sessionIndex) override;
+
+		bool EnableSequence(const int sessionIndex) override;
+
+		void SetReplySequence(const int sessionIndex, const int requestSeq, const short replyPacketId) override;
 		
 		void Run() override;
+
+		void FlushSend() override;
 		
 		RecvPacketInfo GetPacketFromQueue() override;
 
@@ -33,6 +46,8 @@ namespace NServerNetLib
 
 		void ForcingClose(const int sessionIndex);
 
+		NetStats* GetStats() override { return &m_Stats; }
+
 		void CloseSocket(SOCKET socket);
 	protected:
 		NET_ERROR_CODE InitServerSocket();
@@ -50,7 +65,9 @@ namespace NServerNetLib
 		
 		NET_ERROR_CODE RecvSocket(const int sessionIndex);
 		NET_ERROR_CODE RecvBufferProcess(const int sessionIndex);
-		void AddPacketQueue(const int sessionIndex, const short pktId, const short bodySize, char* pDataPos);
+		void AddPacketQueue(const int sessionIndex, const short pktId, const short bodySize, char* pDataPos, const int requestSeq = -1);
+		short CompressSendBody(PacketHeader* pHeader, char* pBody, const short bodySize);
+		char* DecompressRecvBody(const char* pBody, short& bodySize);
 		
 		void RunProcessWrite(const int sessionIndex, const SOCKET fd, fd_set& write_set);
 		NetError FlushSendBuff(const int sessionIndex);
@@ -72,9 +89,27 @@ namespace NServerNetLib
 		
 		std::vector<ClientSession> m_ClientSessionPool;
 		std::deque<int> m_ClientSessionPoolIndex;
+
+		std::vector<int> m_SendDirtySessionIndexList;
 		
 		std::deque<RecvPacketInfo> m_PacketQueue;
 
+		// 지금 로직이 처리 중인 요청. 이 세션으로 보내는 응답 패킷에 요청 순번을 붙인다.
+		int m_ReplySessionIndex = -1;
+		int m_ReplySeq = -1;
+		short m_ReplyPacketId = 0;
+
+		// 압축한 Body 를 잠깐 담는 곳
+		std::vector<char> m_CompressBuffer;
+
+		// 받은 패킷의 압축을 푼 Body. 큐의 패킷이 처리될 때까지 있어야 하므로 큐가 빈 뒤에 처음부터 다시 쓴다.
+		std::vector<std::vector<char>> m_DecompressChunkList;
+		int m_DecompressChunkIndex = 0;
+		int m_DecompressChunkPos = 0;
+
+		NetStats m_Stats;
+		PacketCapture m_Capture;
+
 		ILog* m_pRefLogger;
 	};
 }
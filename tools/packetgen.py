@@ -0,0 +1,561 @@
+﻿#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+src/Common/Packet.idl 을 읽어서 src/Common/PacketSchema.h 를 만든다.
+
+패킷마다 다음을 만든다.
+  - XxxLayout : 필드 위치/크기와 최소/최대 Body 크기(컴파일 시간 상수). Packet.h 구조체 크기와 static_assert 로 맞춰 본다.
+                PacketLayoutOf<Xxx>::Type 으로 Packet.h 구조체에서 찾을 수 있다.
+  - XxxView   : 받은 Body 를 복사하지 않고 읽는다. Parse 에서 Body 크기와 개수 필드를 검사한다.
+  - XxxWriter : 주어진 버퍼에 바로 쓴다. 쓴 바이트 수를 돌려준다.
+그리고 패킷 ID 로 Body 를 검사하는 IsValidPacketBody, 요청에 대한 응답 ID 를 주는 GetPacketResponseId 를 만든다.
+
+사용법: python3 tools/packetgen.py [--check]
+  --check 는 파일을 쓰지 않고 지금 PacketSchema.h 가 최신인지만 본다(다르면 1 을 돌려준다).
+"""
+
+import os
+import re
+import sys
+
+ROOT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+IDL_PATH = os.path.join(ROOT_DIR, "src", "Common", "Packet.idl")
+OUT_PATH = os.path.join(ROOT_DIR, "src", "Common", "PacketSchema.h")
+
+# IDL 타입 -> (C++ 타입, 크기)
+PRIMITIVE_TYPES = {
+    "bool": ("bool", 1),
+    "i8": ("int8_t", 1),
+    "u8": ("uint8_t", 1),
+    "char": ("char", 1),
+    "i16": ("short", 2),
+    "u16": ("unsigned short", 2),
+    "i32": ("int", 4),
+    "u32": ("unsigned int", 4),
+    "i64": ("int64_t", 8),
+}
+INTEGER_TYPES = {"i8", "u8", "i16", "u16", "i32", "u32", "i64"}
+BYTE_TYPES = {"char", "u8"}
+
+
+class IdlError(Exception):
+    pass
+
+
+class Field:
+    def __init__(self, type_name, dims, var_dim, name, is_optional=False):
+        self.type_name = type_name  # 기본 타입 이름
+        self.dims = dims            # 고정 크기 목록(C++ 식)
+        self.var_dim = var_dim      # None 또는 (개수 필드 이름 또는 '*', 최대 개수 식)
+        self.name = name
+        self.is_optional = is_optional  # 예전 클라이언트는 보내지 않는 뒤쪽 필드
+        self.count_for = None       # 이 필드가 개수를 담는 가변 배열 필드
+
+
+class Record:
+    def __init__(self, kind, name, packet_id, has_base, is_optional, fields):
+        self.kind = kind
+        self.name = name
+        self.packet_id = packet_id
+        self.has_base = has_base
+        self.is_optional = is_optional
+        self.fields = fields
+
+
+def strip_comments(text):
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def split_bracket_groups(text):
+    """'char[A + 1][Count : B]' -> ('char', ['A + 1', 'Count : B'])"""
+    pos = text.find("[")
+    if pos < 0:
+        return text.strip(), []
+
+    base = text[:pos].strip()
+    groups = []
+    depth = 0
+    current = ""
+    for ch in text[pos:]:
+        if ch == "[":
+            depth += 1
+            if depth == 1:
+                current = ""
+                continue
+        elif ch == "]":
+            depth -= 1
+            if depth == 0:
+                groups.append(current.strip())
+                continue
+        if depth >= 1:
+            current += ch
+        elif ch.strip():
+            raise IdlError("잘못된 타입: " + text)
+    return base, groups
+
+
+def parse_field(text, struct_names):
+    match = re.match(r"^(optional\s+)?(.*\S)\s+([A-Za-z_]\w*)$", text.strip())
+    if match is None:
+        raise IdlError("잘못된 필드: " + text)
+
+    is_optional = match.group(1) is not None
+    type_text, name = match.group(2), match.group(3)
+    base, groups = split_bracket_groups(type_text)
+    if base not in PRIMITIVE_TYPES and base not in struct_names:
+        raise IdlError("알 수 없는 타입 %s (%s)" % (base, name))
+
+    dims = []
+    var_dim = None
+    for i, group in enumerate(groups):
+        if ":" in group:
+            if i != len(groups) - 1:
+                raise IdlError("가변 크기는 마지막 [] 에만 쓸 수 있다: " + name)
+            count_name, max_count = [x.strip() for x in group.split(":", 1)]
+            var_dim = (count_name, max_count)
+        else:
+            dims.append(group)
+
+    return Field(base, dims, var_dim, name, is_optional)
+
+
+def parse_idl(text):
+    text = strip_comments(text)
+    records = []
+    struct_names = set()
+
+    pattern = re.compile(
+        r"(struct|packet)\s+([A-Za-z_]\w*)\s*(?:=\s*([A-Z_0-9]+))?\s*(?::\s*(PktBase))?\s*(optional)?\s*\{([^}]*)\}",
+        re.S)
+
+    pos = 0
+    for match in pattern.finditer(text):
+        if text[pos:match.start()].strip():
+            raise IdlError("해석할 수 없는 내용: " + text[pos:match.start()].strip()[:40])
+        pos = match.end()
+
+        kind, name, packet_id, base, optional, body = match.groups()
+        if kind == "packet" and packet_id is None:
+            raise IdlError("패킷 ID 가 없다: " + name)
+        if kind == "struct" and (packet_id or base or optional):
+            raise IdlError("struct 에는 ID/PktBase/optional 을 쓸 수 없다: " + name)
+
+        fields = [parse_field(x, struct_names) for x in body.split(";") if x.strip()]
+        check_fields(kind, name, fields)
+
+        records.append(Record(kind, name, packet_id, base is not None, optional is not None, fields))
+        if kind == "struct":
+            struct_names.add(name)
+
+    if text[pos:].strip():
+        raise IdlError("해석할 수 없는 내용: " + text[pos:].strip()[:40])
+    return records
+
+
+def check_fields(kind, name, fields):
+    seen = {}
+    for i, field in enumerate(fields):
+        if field.name in seen:
+            raise IdlError("%s.%s 필드가 두 번 나온다" % (name, field.name))
+
+        if field.is_optional:
+            if kind == "struct" or field.dims or field.var_dim is not None or field.type_name not in PRIMITIVE_TYPES:
+                raise IdlError("optional 은 패킷의 기본 타입 필드에만 쓸 수 있다: %s.%s" % (name, field.name))
+            if any(not f.is_optional for f in fields[i + 1:]):
+                raise IdlError("optional 필드 뒤에는 optional 필드만 올 수 있다: %s.%s" % (name, field.name))
+
+        if field.var_dim is not None:
+            if kind == "struct":
+                raise IdlError("struct 에는 가변 배열을 쓸 수 없다: %s.%s" % (name, field.name))
+            if i != len(fields) - 1:
+                raise IdlError("가변 배열은 마지막 필드여야 한다: %s.%s" % (name, field.name))
+
+            count_name = field.var_dim[0]
+            if count_name != "*":
+                count_field = seen.get(count_name)
+                if count_field is None or count_field.dims or count_field.type_name not in INTEGER_TYPES:
+                    raise IdlError("%s.%s 의 개수 필드 %s 는 앞에 나온 정수 필드여야 한다" % (name, field.name, count_name))
+                count_field.count_for = field
+            elif field.type_name not in BYTE_TYPES or field.dims:
+                raise IdlError("[*] 는 char/u8 에만 쓸 수 있다: %s.%s" % (name, field.name))
+
+        seen[field.name] = field
+
+
+def cpp_type(type_name):
+    if type_name in PRIMITIVE_TYPES:
+        return PRIMITIVE_TYPES[type_name][0]
+    return type_name
+
+
+def base_size_expr(type_name):
+    if type_name in PRIMITIVE_TYPES:
+        return str(PRIMITIVE_TYPES[type_name][1])
+    return "%sLayout::Size" % type_name
+
+
+def elem_size_expr(field):
+    """가변 배열이면 원소 하나, 아니면 필드 전체 크기"""
+    expr = base_size_expr(field.type_name)
+    for dim in field.dims:
+        expr = "(%s)" % dim if expr == "1" else "%s * (%s)" % (expr, dim)
+    return expr
+
+
+def lower_first(name):
+    if name.startswith("sz") or name.startswith("p"):
+        return name
+    return name[0].lower() + name[1:]
+
+
+def is_byte_blob(field):
+    return field.type_name in BYTE_TYPES and len(field.dims) <= 1
+
+
+class Writer:
+    def __init__(self):
+        self.lines = []
+
+    def __call__(self, line="", indent=0):
+        self.lines.append(("\t" * indent + line) if line else "")
+
+
+def gen_struct_layout(out, record):
+    out("struct %sLayout" % record.name, 1)
+    out("{", 1)
+    prev = None
+    for field in record.fields:
+        offset = "0" if prev is None else "%s_Offset + %s_Size" % (prev.name, prev.name)
+        out("static constexpr int %s_Offset = %s;" % (field.name, offset), 2)
+        out("static constexpr int %s_Size = %s;" % (field.name, elem_size_expr(field)), 2)
+        prev = field
+    out("static constexpr int Size = %s;" % ("0" if prev is None else "%s_Offset + %s_Size" % (prev.name, prev.name)), 2)
+    out("};", 1)
+    out("static_assert(sizeof(%s) == %sLayout::Size, \"Packet.idl 과 Packet.h 의 %s 가 다르다\");" % (record.name, record.name, record.name), 1)
+    out()
+
+
+def gen_packet_layout(out, record):
+    out("struct %sLayout" % record.name, 1)
+    out("{", 1)
+    out("static constexpr PACKET_ID Id = PACKET_ID::%s;" % record.packet_id, 2)
+    out("static constexpr bool IsOptional = %s;" % ("true" if record.is_optional else "false"), 2)
+
+    prev = "0"
+    if record.has_base:
+        out("static constexpr int ErrorCode_Offset = 0;", 2)
+        prev = "ErrorCode_Offset + 2"
+
+    var_field = None
+    for field in record.fields:
+        out("static constexpr int %s_Offset = %s;" % (field.name, prev), 2)
+        if field.var_dim is None:
+            out("static constexpr int %s_Size = %s;" % (field.name, elem_size_expr(field)), 2)
+            prev = "%s_Offset + %s_Size" % (field.name, field.name)
+        else:
+            out("static constexpr int %s_ElemSize = %s;" % (field.name, elem_size_expr(field)), 2)
+            out("static constexpr int %s_MaxCount = %s;" % (field.name, field.var_dim[1]), 2)
+            var_field = field
+
+    optional_fields = [f for f in record.fields if f.is_optional]
+    if var_field is None and optional_fields:
+        out("static constexpr int MinSize = %s_Offset;" % optional_fields[0].name, 2)
+        out("static constexpr int MaxSize = %s;" % prev, 2)
+    elif var_field is None:
+        out("static constexpr int MinSize = %s;" % prev, 2)
+        out("static constexpr int MaxSize = MinSize;", 2)
+    else:
+        out("static constexpr int MinSize = %s_Offset;" % var_field.name, 2)
+        out("static constexpr int MaxSize = %s_Offset + %s_ElemSize * %s_MaxCount;" % ((var_field.name,) * 3), 2)
+    out("};", 1)
+
+    # 빈 구조체는 C++ 에서 1 바이트이므로 비교하지 않는다.
+    if record.has_base or record.fields:
+        out("static_assert(sizeof(%s) == %sLayout::MaxSize, \"Packet.idl 과 Packet.h 의 %s 가 다르다\");" % (record.name, record.name, record.name), 1)
+    out("template <> struct PacketLayoutOf<%s> { using Type = %sLayout; };" % (record.name, record.name), 1)
+    out()
+
+
+def gen_view(out, record):
+    name = record.name
+    out("class %sView" % name, 1)
+    out("{", 1)
+    out("public:", 1)
+    out("using Layout = %sLayout;" % name, 2)
+    out()
+
+    var_field = record.fields[-1] if record.fields and record.fields[-1].var_dim is not None else None
+
+    out("bool Parse(const char* pData, const int size)", 2)
+    out("{", 2)
+    out("m_pData = pData;", 3)
+    out("m_Size = size;", 3)
+    if record.is_optional:
+        out("m_IsEmpty = size < Layout::MinSize;", 3)
+        if var_field is not None:
+            out("if (m_IsEmpty) {", 3)
+            out("return true;", 4)
+            out("}", 3)
+    else:
+        out("if (size < Layout::MinSize) {", 3)
+        out("return false;", 4)
+        out("}", 3)
+
+    if var_field is not None:
+        count = var_field.var_dim[0]
+        if count == "*":
+            out("return size <= Layout::MaxSize;", 3)
+        else:
+            out()
+            out("auto count = (int)%s();" % count, 3)
+            out("if (count < 0 || count > Layout::%s_MaxCount) {" % var_field.name, 3)
+            out("return false;", 4)
+            out("}", 3)
+            out("return size >= Layout::%s_Offset + count * Layout::%s_ElemSize;" % (var_field.name, var_field.name), 3)
+    else:
+        out("return true;", 3)
+    out("}", 2)
+    out()
+
+    if record.is_optional:
+        out("bool IsEmpty() const { return m_IsEmpty; }", 2)
+    out("const char* GetBody() const { return m_pData; }", 2)
+    out("int GetBodySize() const { return m_Size; }", 2)
+    out()
+
+    if record.has_base:
+        out("short ErrorCode() const { return ReadPacketField<short>(m_pData + Layout::ErrorCode_Offset); }", 2)
+
+    for field in record.fields:
+        fname = field.name
+        ctype = cpp_type(field.type_name)
+        if field.var_dim is not None:
+            count = field.var_dim[0]
+            if count == "*":
+                out("int %sSize() const { return m_Size - Layout::%s_Offset; }" % (fname, fname), 2)
+                out("const char* %s() const { return m_pData + Layout::%s_Offset; }" % (fname, fname), 2)
+            elif field.type_name in BYTE_TYPES and not field.dims:
+                out("const char* %s() const { return m_pData + Layout::%s_Offset; }" % (fname, fname), 2)
+            elif field.dims:
+                out("const char* %s(const int index) const { return m_pData + Layout::%s_Offset + index * Layout::%s_ElemSize; }" % (fname, fname, fname), 2)
+            else:
+                out("%s %s(const int index) const { return ReadPacketField<%s>(m_pData + Layout::%s_Offset + index * Layout::%s_ElemSize); }" % (ctype, fname, ctype, fname, fname), 2)
+        elif field.dims:
+            out("const char* %s() const { return m_pData + Layout::%s_Offset; }" % (fname, fname), 2)
+        else:
+            if field.is_optional:
+                out("%s %s() const { return m_Size < Layout::%s_Offset + Layout::%s_Size ? %s() : ReadPacketField<%s>(m_pData + Layout::%s_Offset); }" % (ctype, fname, fname, fname, ctype, ctype, fname), 2)
+            elif record.is_optional:
+                out("%s %s() const { return m_IsEmpty ? %s() : ReadPacketField<%s>(m_pData + Layout::%s_Offset); }" % (ctype, fname, ctype, ctype, fname), 2)
+            else:
+                out("%s %s() const { return ReadPacketField<%s>(m_pData + Layout::%s_Offset); }" % (ctype, fname, ctype, fname), 2)
+
+    out()
+    out("private:", 1)
+    out("const char* m_pData = nullptr;", 2)
+    out("int m_Size = 0;", 2)
+    if record.is_optional:
+        out("bool m_IsEmpty = true;", 2)
+    out("};", 1)
+    out()
+
+
+def gen_writer(out, record):
+    name = record.name
+    params = []
+    body = []
+
+    if record.has_base:
+        params.append("const short errorCode")
+        body.append("WritePacketField(pBuffer + Layout::ErrorCode_Offset, errorCode);")
+
+    var_field = record.fields[-1] if record.fields and record.fields[-1].var_dim is not None else None
+    size_expr = "Layout::MaxSize"
+
+    for field in record.fields:
+        fname = field.name
+        pname = lower_first(fname)
+        ctype = cpp_type(field.type_name)
+
+        if field.var_dim is not None:
+            count = field.var_dim[0]
+            ptr_name = "p" + fname
+            if count == "*":
+                params.append("const int %sSize" % pname)
+                params.append("const char* %s" % ptr_name)
+                count_expr = "%sSize" % pname
+            else:
+                params.append("const %s* %s" % ("char" if (field.type_name in BYTE_TYPES or field.dims) else ctype, ptr_name))
+                count_expr = "(int)%s" % lower_first(count)
+            body.append("")
+            if count != "*":
+                body.append("auto %sSize = %s * Layout::%s_ElemSize;" % (pname, count_expr, fname))
+            size_expr = "Layout::%s_Offset + %sSize" % (fname, pname)
+            body.append("if (%s < 0 || %s > Layout::%s_MaxCount || %s > capacity) {" % (count_expr, count_expr, fname, size_expr))
+            body.append("\treturn -1;")
+            body.append("}")
+            body.append("if (%sSize > 0) {" % pname)
+            body.append("\tmemcpy(pBuffer + Layout::%s_Offset, %s, %sSize);" % (fname, ptr_name, pname))
+            body.append("}")
+        elif field.dims:
+            if is_byte_blob(field):
+                params.append("const char* %s" % (pname if pname.startswith("sz") else "psz" + fname))
+                src = pname if pname.startswith("sz") else "psz" + fname
+                body.append("CopyPacketString(pBuffer + Layout::%s_Offset, Layout::%s_Size, %s);" % (fname, fname, src))
+            else:
+                params.append("const %s* p%s" % (ctype, fname))
+                body.append("memcpy(pBuffer + Layout::%s_Offset, p%s, Layout::%s_Size);" % (fname, fname, fname))
+        else:
+            if field.type_name in PRIMITIVE_TYPES:
+                params.append("const %s %s" % (ctype, pname))
+            else:
+                params.append("const %s& %s" % (ctype, pname))
+            body.append("WritePacketField(pBuffer + Layout::%s_Offset, %s);" % (fname, pname))
+
+    while body and body[0] == "":
+        body.pop(0)
+
+    out("struct %sWriter" % name, 1)
+    out("{", 1)
+    out("using Layout = %sLayout;" % name, 2)
+    out()
+    buffer_param = "char* pBuffer" if params else "char*"
+    out("static int Encode(%s)" % ", ".join([buffer_param, "const int capacity"] + params), 2)
+    out("{", 2)
+    if var_field is None:
+        out("if (capacity < Layout::MaxSize) {", 3)
+        out("return -1;", 4)
+        out("}", 3)
+        if body:
+            out()
+    else:
+        out("if (capacity < Layout::MinSize) {", 3)
+        out("return -1;", 4)
+        out("}", 3)
+        out()
+    for line in body:
+        indent = 3 + line.count("\t")
+        out(line.replace("\t", ""), indent if line else 0)
+    if body or var_field is not None:
+        out()
+    out("return %s;" % size_expr, 3)
+    out("}", 2)
+    out("};", 1)
+    out()
+
+
+def generate(records):
+    out = Writer()
+    out("// 이 파일은 tools/packetgen.py 가 src/Common/Packet.idl 로 만든다. 직접 고치지 말고 Packet.idl 을 고친 뒤 다시 만든다.")
+    out("#pragma once")
+    out()
+    out("#include <stdint.h>")
+    out("#include <string.h>")
+    out()
+    out("#include \"Packet.h\"")
+    out()
+    out("namespace NCommon")
+    out("{")
+    out("template <class T>", 1)
+    out("inline T ReadPacketField(const char* pData)", 1)
+    out("{", 1)
+    out("T value;", 2)
+    out("memcpy(&value, pData, sizeof(T));", 2)
+    out("return value;", 2)
+    out("}", 1)
+    out()
+    out("template <class T>", 1)
+    out("inline void WritePacketField(char* pData, const T& value)", 1)
+    out("{", 1)
+    out("memcpy(pData, &value, sizeof(T));", 2)
+    out("}", 1)
+    out()
+    out("// 고정 크기 문자열 필드. 남는 곳은 0 으로 채운다.", 1)
+    out("inline void CopyPacketString(char* pDest, const int size, const char* pszSrc)", 1)
+    out("{", 1)
+    out("int i = 0;", 2)
+    out("for (; pszSrc != nullptr && i < size && pszSrc[i] != '\\0'; ++i) {", 2)
+    out("pDest[i] = pszSrc[i];", 3)
+    out("}", 2)
+    out("memset(pDest + i, 0, size - i);", 2)
+    out("}", 1)
+    out()
+    out("// Packet.h 의 패킷 구조체 -> XxxLayout", 1)
+    out("template <class T>", 1)
+    out("struct PacketLayoutOf;", 1)
+    out()
+    out()
+
+    for record in records:
+        out("//- %s%s" % (record.name, "" if record.kind == "struct" else " (%s)" % record.packet_id), 1)
+        if record.kind == "struct":
+            gen_struct_layout(out, record)
+        else:
+            gen_packet_layout(out, record)
+            gen_view(out, record)
+            gen_writer(out, record)
+
+    packets = [r for r in records if r.kind == "packet"]
+
+    out("// 받은 Body 가 패킷 정의에 맞는지 검사한다. 스키마에 없는 패킷은 통과시킨다.", 1)
+    out("inline bool IsValidPacketBody(const short packetId, const char* pData, const int size)", 1)
+    out("{", 1)
+    out("switch ((PACKET_ID)packetId)", 2)
+    out("{", 2)
+    for record in packets:
+        out("case PACKET_ID::%s: return %sView().Parse(pData, size);" % (record.packet_id, record.name), 2)
+    out("default: return true;", 2)
+    out("}", 2)
+    out("}", 1)
+    out()
+
+    ids = {r.packet_id for r in packets}
+    out("// 요청 패킷에 대한 응답 패킷 ID. 응답이 없으면 0.", 1)
+    out("inline short GetPacketResponseId(const short packetId)", 1)
+    out("{", 1)
+    out("switch ((PACKET_ID)packetId)", 2)
+    out("{", 2)
+    for record in packets:
+        if record.packet_id.endswith("_REQ"):
+            res_id = record.packet_id[:-4] + "_RES"
+            if res_id in ids:
+                out("case PACKET_ID::%s: return (short)PACKET_ID::%s;" % (record.packet_id, res_id), 2)
+    out("default: return 0;", 2)
+    out("}", 2)
+    out("}", 1)
+    out("}")
+
+    return "\n".join(out.lines) + "\n"
+
+
+def main():
+    is_check = "--check" in sys.argv[1:]
+
+    with open(IDL_PATH, encoding="utf-8-sig") as f:
+        records = parse_idl(f.read())
+    text = generate(records)
+
+    old_text = None
+    if os.path.exists(OUT_PATH):
+        with open(OUT_PATH, encoding="utf-8-sig") as f:
+            old_text = f.read().replace("\r\n", "\n")
+
+    if is_check:
+        if old_text != text:
+            print("%s 가 Packet.idl 과 다르다. tools/packetgen.py 를 다시 실행해야 한다." % OUT_PATH)
+            return 1
+        return 0
+
+    if old_text != text:
+        with open(OUT_PATH, "w", encoding="utf-8-sig", newline="\n") as f:
+            f.write(text)
+        print("wrote " + OUT_PATH)
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except IdlError as e:
+        print("Packet.idl: " + str(e))
+        sys.exit(1)